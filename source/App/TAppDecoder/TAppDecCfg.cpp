@@ -75,6 +75,8 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 	("MCTSEidIdTarget,-te",				m_mctsEisIdTarget,										 0,					 "target MCTS extraction information")
 	("MCTSSetIdxTarget,-ts",			m_mctsSetIdxTarget,										 0,					 "target MCTS set index")
 	("MCTSTidTarget,-tt",					m_mctsTidTarget,											 0,					 "target hightest Temporal id")
+  ("MergeBitstreamFiles,m",     m_mergeBitstreamFileNames,             string(""), "sub-picture bitstreams to be merged into one bitstream, in tile raster order")
+  ("MergeTileColumns",          m_mergeTileColumns,                    0,          "number of tile columns of the merged picture (0: one tile row)")
   ;
 
   po::setDefaults(opts);
@@ -102,7 +104,7 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     }
   }
 
-  if (m_bitstreamFileName.empty())
+  if (m_bitstreamFileName.empty() && m_mergeBitstreamFileNames.empty())
   {
     fprintf(stderr, "No input file specified, aborting\n");
     return false;
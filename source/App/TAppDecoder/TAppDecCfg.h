@@ -61,6 +61,8 @@ protected:
 	Int           m_mctsEisIdTarget;
 	Int           m_mctsSetIdxTarget;
 	Int           m_mctsTidTarget;
+  std::string   m_mergeBitstreamFileNames;              ///< whitespace separated sub-picture bitstreams to be merged (empty: extraction)
+  Int           m_mergeTileColumns;                     ///< number of tile columns of the merged picture (0: one tile row)
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
 
 public:
@@ -68,6 +70,8 @@ public:
   : m_bitstreamFileName()
 	, m_mctsEisIdTarget(0)
 	, m_mctsSetIdxTarget(0)
+  , m_mergeBitstreamFileNames()
+  , m_mergeTileColumns(0)
   , m_outputDecodedSEIMessagesFilename()
   {
   }
@@ -75,6 +79,7 @@ public:
   virtual ~TAppDecCfg() {}
 
   Bool  parseCfg        ( Int argc, TChar* argv[] );   ///< initialize option class from configuration
+  Bool  isMergeMode     () const { return !m_mergeBitstreamFileNames.empty(); }
 };
 
 //! \}
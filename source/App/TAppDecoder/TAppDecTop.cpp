@@ -37,19 +37,21 @@
 
 #include <list>
 #include <vector>
+#include <sstream>
 #include <stdio.h>
 #include <fcntl.h>
 #include <assert.h>
+#include <math.h>
 
 #include "TAppDecTop.h"
 #include "TLibDecoder/AnnexBread.h"
 #include "TLibDecoder/NALread.h"
+#include "TLibCommon/TComByteScan.h"
 
 //! \ingroup TAppDecoder
 //! \{
 
 
-static const UChar emulation_prevention_three_byte[] = { 3 };
 static const UChar start_code_prefix[] = { 0, 0, 0, 1 };
 
 // ====================================================================================================================
@@ -252,6 +254,203 @@ Void TAppDecTop::decode()
 
 }
 
+/**
+ - open the sub-picture bitstreams written by spatially distributed encoding
+ - collect one slice per sub-picture bitstream for each access unit
+ - write parameter sets of the merged picture whenever a sub-picture bitstream carries new ones
+ - rewrite the slice_segment_address of each slice to the first CTU of its tile
+ .
+ */
+Void TAppDecTop::merge()
+{
+  std::vector<std::string> fileNames;
+  std::istringstream fileNameList(m_mergeBitstreamFileNames);
+  std::string fileName;
+  while (fileNameList >> fileName)
+  {
+    fileNames.push_back(fileName);
+  }
+
+  const Int numInputs      = Int(fileNames.size());
+  const Int numTileColumns = m_mergeTileColumns > 0 ? m_mergeTileColumns : numInputs;
+  if (numInputs % numTileColumns != 0)
+  {
+    fprintf(stderr, "\nthe number of merged bitstreams (%d) is not a multiple of MergeTileColumns (%d)\n", numInputs, numTileColumns);
+    exit(EXIT_FAILURE);
+  }
+
+  std::vector<ifstream*>            bitstreamFiles(numInputs);
+  std::vector<InputByteStream*>     bytestreams(numInputs);
+  std::vector<ParameterSetManager*> parameterSetManagers(numInputs);
+  std::vector<TComSlice*>           slices(numInputs);
+  std::vector<InputNALUnit>         sliceNalus(numInputs);
+  std::vector<Int>                  sliceAddresses(numInputs);
+  for (Int i = 0; i < numInputs; i++)
+  {
+    bitstreamFiles[i] = new ifstream(fileNames[i].c_str(), ifstream::in | ifstream::binary);
+    if (!*bitstreamFiles[i])
+    {
+      fprintf(stderr, "\nfailed to open bitstream file `%s' for reading\n", fileNames[i].c_str());
+      exit(EXIT_FAILURE);
+    }
+    bytestreams[i]          = new InputByteStream(*bitstreamFiles[i]);
+    parameterSetManagers[i] = new ParameterSetManager;
+    slices[i]               = new TComSlice;
+  }
+
+  fstream mergeFile(m_outBitstreamFileName.c_str(), fstream::binary | fstream::out);
+  if (!mergeFile)
+  {
+    fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", m_outBitstreamFileName.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  m_cEntropyDecoder.setEntropyDecoder(&m_cCavlcDecoder);
+
+  TComVPS vps;
+  Bool parameterSetsChanged = false;
+  Int  numAccessUnits       = 0;
+  for (;;)
+  {
+    // read up to and including the next slice of every sub-picture bitstream
+    Int numSlices = 0;
+    for (Int i = 0; i < numInputs; i++)
+    {
+      Bool sliceFound = false;
+      while (!sliceFound && !!*bitstreamFiles[i])
+      {
+        AnnexBStats stats = AnnexBStats();
+        InputNALUnit nalu;
+        byteStreamNALUnit(*bytestreams[i], nalu.getBitstream().getFifo(), stats);
+        if (nalu.getBitstream().getFifo().empty())
+        {
+          continue;
+        }
+        read(nalu);
+        m_cEntropyDecoder.setBitstream(&(nalu.getBitstream()));
+
+        switch (nalu.m_nalUnitType)
+        {
+        case NAL_UNIT_VPS:
+          if (i == 0)
+          {
+            m_cEntropyDecoder.decodeVPS(&vps);
+            parameterSetsChanged = true;
+          }
+          break;
+        case NAL_UNIT_SPS:
+          {
+            TComSPS* sps = new TComSPS();
+            m_cEntropyDecoder.decodeSPS(sps);
+            parameterSetManagers[i]->storeSPS(sps, nalu.getBitstream().getFifo());
+            parameterSetsChanged = true;
+          }
+          break;
+        case NAL_UNIT_PPS:
+          {
+            TComPPS* pps = new TComPPS();
+            m_cEntropyDecoder.decodePPS(pps);
+            parameterSetManagers[i]->storePPS(pps, nalu.getBitstream().getFifo());
+            parameterSetsChanged = true;
+          }
+          break;
+        case NAL_UNIT_CODED_SLICE_TRAIL_R:
+        case NAL_UNIT_CODED_SLICE_TRAIL_N:
+        case NAL_UNIT_CODED_SLICE_TSA_R:
+        case NAL_UNIT_CODED_SLICE_TSA_N:
+        case NAL_UNIT_CODED_SLICE_STSA_R:
+        case NAL_UNIT_CODED_SLICE_STSA_N:
+        case NAL_UNIT_CODED_SLICE_BLA_W_LP:
+        case NAL_UNIT_CODED_SLICE_BLA_W_RADL:
+        case NAL_UNIT_CODED_SLICE_BLA_N_LP:
+        case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+        case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+        case NAL_UNIT_CODED_SLICE_CRA:
+        case NAL_UNIT_CODED_SLICE_RADL_N:
+        case NAL_UNIT_CODED_SLICE_RADL_R:
+        case NAL_UNIT_CODED_SLICE_RASL_N:
+        case NAL_UNIT_CODED_SLICE_RASL_R:
+          {
+            TComSlice* pcSlice = slices[i];
+            pcSlice->initSlice();
+            pcSlice->setNalUnitType(nalu.m_nalUnitType);
+            Bool nonReferenceFlag = (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TRAIL_N ||
+              pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_TSA_N ||
+              pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_STSA_N ||
+              pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RADL_N ||
+              pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_RASL_N);
+            pcSlice->setTemporalLayerNonReferenceFlag(nonReferenceFlag);
+            pcSlice->setReferenced(true);
+            pcSlice->setTLayerInfo(nalu.m_temporalId);
+            // the syntax of the sub-picture slice header follows the parameter sets of its own bitstream
+            m_cEntropyDecoder.decodeSliceHeader(pcSlice, parameterSetManagers[i], parameterSetManagers[i], 0);
+            if (pcSlice->getSliceSegmentCurStartCtuTsAddr() != 0)
+            {
+              fprintf(stderr, "\nbitstream `%s' has more than one slice segment per picture, which cannot be merged\n", fileNames[i].c_str());
+              exit(EXIT_FAILURE);
+            }
+            sliceNalus[i] = nalu;
+            sliceFound    = true;
+            numSlices++;
+          }
+          break;
+        default:
+          // SEI messages describe the sub-picture and are not carried over into the merged bitstream
+          break;
+        }
+      }
+    }
+
+    if (numSlices == 0)
+    {
+      break;
+    }
+    if (numSlices != numInputs)
+    {
+      fprintf(stderr, "\nWarning: the merged bitstreams have different numbers of pictures, stopping after %d pictures\n", numAccessUnits);
+      break;
+    }
+    for (Int i = 1; i < numInputs; i++)
+    {
+      // IDR slices do not carry slice_pic_order_cnt_lsb, their POC is always 0
+      if (sliceNalus[i].m_nalUnitType != sliceNalus[0].m_nalUnitType ||
+          (!slices[0]->getIdrPicFlag() && slices[i]->getPicOrderCnt() != slices[0]->getPicOrderCnt()))
+      {
+        fprintf(stderr, "\npicture %d of bitstream `%s' does not match the picture type or POC of `%s'\n", numAccessUnits, fileNames[i].c_str(), fileNames[0].c_str());
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    if (parameterSetsChanged)
+    {
+      xWriteMergedParameterSets(mergeFile, vps, slices, numTileColumns, sliceAddresses);
+      parameterSetsChanged = false;
+    }
+
+    for (Int i = 0; i < numInputs; i++)
+    {
+      TComSlice* pcSlice = slices[i];
+      pcSlice->setSPS(m_parameterSetManager.getSPS(pcSlice->getSPS()->getSPSId()));
+      pcSlice->setPPS(m_parameterSetManager.getPPS(pcSlice->getPPS()->getPPSId()));
+      pcSlice->setNumMCTSTile(numInputs);
+      pcSlice->setCountTile(i);
+      pcSlice->setSliceSegmentRsAddress(sliceAddresses[i]);
+      writeSlice(mergeFile, sliceNalus[i], pcSlice);
+    }
+    numAccessUnits++;
+  }
+  mergeFile.close();
+
+  for (Int i = 0; i < numInputs; i++)
+  {
+    delete slices[i];
+    delete parameterSetManagers[i];
+    delete bytestreams[i];
+    delete bitstreamFiles[i];
+  }
+  printf("merged %d pictures of %d sub-picture bitstreams into `%s'\n", numAccessUnits, numInputs, m_outBitstreamFileName.c_str());
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -280,39 +479,7 @@ Void TAppDecTop::replaceParameter(fstream& out, SEIMCTSExtractionInfoSets& sei,
 std::size_t TAppDecTop::addEmulationPreventionByte(vector<uint8_t>& outputBuffer, vector<uint8_t>& rbsp)
 {
 	outputBuffer.resize(rbsp.size() * 2 + 1); //there can never be enough emulation_prevention_three_bytes to require this much space
-	std::size_t outputAmount = 0;
-	Int         zeroCount = 0;
-	for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
-	{
-		const uint8_t v = (*it);
-		if (zeroCount == 2 && v <= 3)
-		{
-			outputBuffer[outputAmount++] = emulation_prevention_three_byte[0];
-			zeroCount = 0;
-		}
-
-		if (v == 0)
-		{
-			zeroCount++;
-		}
-		else
-		{
-			zeroCount = 0;
-		}
-		outputBuffer[outputAmount++] = v;
-	}
-
-	/* 7.4.1.1
-	* ... when the last byte of the RBSP data is equal to 0x00 (which can
-	* only occur when the RBSP ends in a cabac_zero_word), a final byte equal
-	* to 0x03 is appended to the end of the data.
-	*/
-	if (zeroCount>0)
-	{
-		outputBuffer[outputAmount++] = emulation_prevention_three_byte[0];
-	}
-
-	return outputAmount;
+	return insertEmulationPreventionBytes(rbsp.empty() ? NULL : &rbsp[0], rbsp.size(), &outputBuffer[0]);
 }
 Void TAppDecTop::writeParameter(fstream& out, NalUnitType nalUnitType, UInt nuhLayerId, UInt temporalId, vector<uint8_t>& rbsp, ParameterSetManager& parameterSetmanager)
 {
@@ -432,6 +599,266 @@ Void TAppDecTop::writeSlice(fstream& out, InputNALUnit& nalu, TComSlice* pcSlice
 	out.write(reinterpret_cast<const TChar*>(&(*outputSliceRbspBuffer.begin())), outputRbspHeaderAmount);
 
 }
+/** The slice header parser expands inter-predicted reference picture sets into explicit ones without
+ *  keeping deltaRPS, so the SPS is rewritten with every reference picture set coded explicitly.
+ */
+Void TAppDecTop::xClearInterRPSPrediction(TComSPS& sps)
+{
+  TComRPSList* rpsList = sps.getRPSList();
+  for (Int i = 0; i < rpsList->getNumberOfReferencePictureSets(); i++)
+  {
+    rpsList->getReferencePictureSet(i)->setInterRPSPrediction(false);
+  }
+}
+
+/// limits of Tables A.6 and A.8 that depend on the size, tiling and sample rate of the merged picture
+struct MergedLevelLimits
+{
+  Level::Name level;
+  UInt        maxLumaPs;
+  UInt        maxTileRows;
+  UInt        maxTileCols;
+  UInt64      maxLumaSr;
+};
+
+static const MergedLevelLimits mergedLevelLimits[] =
+{
+  { Level::LEVEL1  ,    36864,  1,  1,     552960ULL },
+  { Level::LEVEL2  ,   122880,  1,  1,    3686400ULL },
+  { Level::LEVEL2_1,   245760,  1,  1,    7372800ULL },
+  { Level::LEVEL3  ,   552960,  2,  2,   16588800ULL },
+  { Level::LEVEL3_1,   983040,  3,  3,   33177600ULL },
+  { Level::LEVEL4  ,  2228224,  5,  5,   66846720ULL },
+  { Level::LEVEL4_1,  2228224,  5,  5,  133693440ULL },
+  { Level::LEVEL5  ,  8912896, 11, 10,  267386880ULL },
+  { Level::LEVEL5_1,  8912896, 11, 10,  534773760ULL },
+  { Level::LEVEL5_2,  8912896, 11, 10, 1069547520ULL },
+  { Level::LEVEL6  , 35651584, 22, 20, 1069547520ULL },
+  { Level::LEVEL6_1, 35651584, 22, 20, 2139095040ULL },
+  { Level::LEVEL6_2, 35651584, 22, 20, 4278190080ULL },
+};
+
+/** Find the lowest level, not below that of the sub-pictures, whose picture size, tile and CTB size
+ *  limits admit the merged picture. The luma sample rate is only checked when the frame rate is known.
+ *  The bit rate and CPB size of the merged bitstream are the sums of those of the sub-pictures and are
+ *  not checked.
+ * \param subPictureLevel level signalled for the sub-pictures
+ * \param mergedSps       SPS of the merged picture
+ * \param numTileColumns  number of tile columns of the merged picture
+ * \param numTileRows     number of tile rows of the merged picture
+ * \param frameRate       pictures per second, or 0 when not known
+ * \returns the level of the merged picture, or Level::NONE when no level can describe it
+ */
+Level::Name TAppDecTop::xDeriveMergedLevel(Level::Name subPictureLevel, const TComSPS& mergedSps, UInt numTileColumns, UInt numTileRows, Double frameRate)
+{
+  const UInt64 width       = mergedSps.getPicWidthInLumaSamples();
+  const UInt64 height      = mergedSps.getPicHeightInLumaSamples();
+  const UInt   log2CtbSize = mergedSps.getLog2MinCodingBlockSize() + mergedSps.getLog2DiffMaxMinCodingBlockSize();
+
+  for (UInt i = 0; i < sizeof(mergedLevelLimits) / sizeof(mergedLevelLimits[0]); i++)
+  {
+    const MergedLevelLimits& limits   = mergedLevelLimits[i];
+    const UInt64             maxWidth = UInt64(sqrt(limits.maxLumaPs * 8.0));
+    if (limits.level < subPictureLevel ||
+        width * height > limits.maxLumaPs || width > maxWidth || height > maxWidth ||
+        numTileColumns > limits.maxTileCols || numTileRows > limits.maxTileRows ||
+        (frameRate > 0 && width * height * frameRate > Double(limits.maxLumaSr)) ||
+        (limits.level >= Level::LEVEL5 && log2CtbSize < 5))
+    {
+      continue;
+    }
+    return limits.level;
+  }
+  return Level::NONE;
+}
+
+/** Derive the parameter sets of the merged picture from those of the sub-picture bitstreams.
+ *  The sub-pictures are placed in raster order into a grid of numTileColumns tile columns, each
+ *  sub-picture becoming one tile. Loop filtering across tiles is disabled, as every sub-picture
+ *  was encoded with its picture boundaries in place of the tile boundaries.
+ * \param out            merged bitstream
+ * \param vps            VPS of the first sub-picture bitstream, its level is rewritten for the merged picture
+ * \param slices         current slice of each sub-picture bitstream, referring to its own parameter sets
+ * \param numTileColumns number of tile columns of the merged picture
+ * \param sliceAddresses returns the raster-scan address of the first CTU of each tile
+ */
+Void TAppDecTop::xWriteMergedParameterSets(fstream& out, TComVPS& vps, std::vector<TComSlice*>& slices, Int numTileColumns, std::vector<Int>& sliceAddresses)
+{
+  const Int      numInputs   = Int(slices.size());
+  const Int      numTileRows = numInputs / numTileColumns;
+  const TComPPS* refPps      = slices[0]->getPPS();
+  TComSPS        refSps(*slices[0]->getSPS());
+  const Int      ctuWidth    = refSps.getMaxCUWidth();
+  const Int      ctuHeight   = refSps.getMaxCUHeight();
+  xClearInterRPSPrediction(refSps);
+
+  m_cEntropyCoder.setEntropyCoder(&m_cCavlcCoder);
+
+  TComOutputBitstream refSpsBitstream;
+  m_cEntropyCoder.setBitstream(&refSpsBitstream);
+  m_cEntropyCoder.encodeSPS(&refSps);
+  TComOutputBitstream refPpsBitstream;
+  m_cEntropyCoder.setBitstream(&refPpsBitstream);
+  m_cEntropyCoder.encodePPS(refPps);
+
+  std::vector<UInt> columnWidths(numTileColumns);
+  std::vector<UInt> rowHeights(numTileRows);
+  Int mergedWidth  = 0;
+  Int mergedHeight = 0;
+  for (Int i = 0; i < numInputs; i++)
+  {
+    const Int      column = i % numTileColumns;
+    const Int      row    = i / numTileColumns;
+    const TComSPS* sps    = slices[i]->getSPS();
+    const TComPPS* pps    = slices[i]->getPPS();
+    const Window&  conf   = sps->getConformanceWindow();
+
+    if (row == 0)
+    {
+      columnWidths[column] = sps->getPicWidthInLumaSamples();
+      mergedWidth         += sps->getPicWidthInLumaSamples();
+    }
+    if (column == 0)
+    {
+      rowHeights[row]      = sps->getPicHeightInLumaSamples();
+      mergedHeight        += sps->getPicHeightInLumaSamples();
+    }
+
+    // apart from its size, every sub-picture must use the parameter sets of the first one
+    TComSPS resizedSps(*sps);
+    resizedSps.setPicWidthInLumaSamples(refSps.getPicWidthInLumaSamples());
+    resizedSps.setPicHeightInLumaSamples(refSps.getPicHeightInLumaSamples());
+    resizedSps.setConformanceWindow(refSps.getConformanceWindow());
+    xClearInterRPSPrediction(resizedSps);
+    TComOutputBitstream spsBitstream;
+    m_cEntropyCoder.setBitstream(&spsBitstream);
+    m_cEntropyCoder.encodeSPS(&resizedSps);
+    TComOutputBitstream ppsBitstream;
+    m_cEntropyCoder.setBitstream(&ppsBitstream);
+    m_cEntropyCoder.encodePPS(pps);
+
+    const TChar* error = NULL;
+    if (spsBitstream.getFIFO() != refSpsBitstream.getFIFO() || ppsBitstream.getFIFO() != refPpsBitstream.getFIFO())
+    {
+      error = "uses parameter sets that differ from those of the first sub-picture";
+    }
+    else if (pps->getTilesEnabledFlag() || pps->getEntropyCodingSyncEnabledFlag())
+    {
+      error = "uses tiles or wavefronts";
+    }
+    else if (sps->getPicWidthInLumaSamples() != columnWidths[column] || sps->getPicHeightInLumaSamples() != rowHeights[row])
+    {
+      error = "does not match the size of the other sub-pictures in its tile column or row";
+    }
+    else if (conf.getWindowLeftOffset() != 0 || conf.getWindowTopOffset() != 0 ||
+             (column < numTileColumns - 1 && (sps->getPicWidthInLumaSamples() % ctuWidth != 0 || conf.getWindowRightOffset() != 0)) ||
+             (row < numTileRows - 1 && (sps->getPicHeightInLumaSamples() % ctuHeight != 0 || conf.getWindowBottomOffset() != 0)))
+    {
+      error = "is not CTU aligned or is cropped inside the merged picture";
+    }
+    if (error != NULL)
+    {
+      fprintf(stderr, "\nsub-picture %d %s\n", i, error);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  TComSPS mergedSps(refSps);
+  mergedSps.setPicWidthInLumaSamples(mergedWidth);
+  mergedSps.setPicHeightInLumaSamples(mergedHeight);
+  Window mergedConf;
+  const Int rightOffset  = slices[numTileColumns - 1]->getSPS()->getConformanceWindow().getWindowRightOffset();
+  const Int bottomOffset = slices[numInputs - 1]->getSPS()->getConformanceWindow().getWindowBottomOffset();
+  if (rightOffset != 0 || bottomOffset != 0)
+  {
+    mergedConf.setWindow(0, rightOffset, 0, bottomOffset);
+  }
+  mergedSps.setConformanceWindow(mergedConf);
+
+  // the level of a sub-picture is too low for the merged picture, which is numInputs times larger
+  Double frameRate = 0;
+  const TimingInfo* timingInfo = refSps.getVuiParametersPresentFlag() ? refSps.getVuiParameters()->getTimingInfo() : vps.getTimingInfo();
+  if (timingInfo->getTimingInfoPresentFlag() && timingInfo->getNumUnitsInTick() > 0)
+  {
+    frameRate = Double(timingInfo->getTimeScale()) / timingInfo->getNumUnitsInTick();
+  }
+  TComPTL* ptls[]         = { mergedSps.getPTL(), vps.getPTL() };
+  const Int maxTLayers[]  = { Int(mergedSps.getMaxTLayers()), Int(vps.getMaxTLayers()) };
+  for (Int p = 0; p < 2; p++)
+  {
+    ProfileTierLevel* generalPtl = ptls[p]->getGeneralPTL();
+    const Level::Name mergedLevel = xDeriveMergedLevel(generalPtl->getLevelIdc(), mergedSps, numTileColumns, numTileRows, frameRate);
+    if (mergedLevel == Level::NONE)
+    {
+      fprintf(stderr, "\nno level of the sub-picture profile can describe the %dx%d merged picture with %dx%d tiles\n", mergedWidth, mergedHeight, numTileColumns, numTileRows);
+      exit(EXIT_FAILURE);
+    }
+    generalPtl->setLevelIdc(mergedLevel);
+    // the frame rate of a sub-layer is not known, only its picture size and tiles are accounted for
+    for (Int i = 0; i < maxTLayers[p] - 1; i++)
+    {
+      if (ptls[p]->getSubLayerLevelPresentFlag(i))
+      {
+        ProfileTierLevel* subLayerPtl = ptls[p]->getSubLayerPTL(i);
+        subLayerPtl->setLevelIdc(std::min(mergedLevel, xDeriveMergedLevel(subLayerPtl->getLevelIdc(), mergedSps, numTileColumns, numTileRows, 0)));
+      }
+    }
+  }
+
+  TComPPS mergedPps(*refPps);
+  std::vector<Int> columnWidthsInCtus(numTileColumns);
+  std::vector<Int> rowHeightsInCtus(numTileRows);
+  for (Int column = 0; column < numTileColumns; column++)
+  {
+    columnWidthsInCtus[column] = (columnWidths[column] + ctuWidth - 1) / ctuWidth;
+  }
+  for (Int row = 0; row < numTileRows; row++)
+  {
+    rowHeightsInCtus[row] = (rowHeights[row] + ctuHeight - 1) / ctuHeight;
+  }
+  mergedPps.setTilesEnabledFlag(numInputs > 1);
+  mergedPps.setTileUniformSpacingFlag(false);
+  mergedPps.setNumTileColumnsMinus1(numTileColumns - 1);
+  mergedPps.setNumTileRowsMinus1(numTileRows - 1);
+  mergedPps.setTileColumnWidth(columnWidthsInCtus);
+  mergedPps.setTileRowHeight(rowHeightsInCtus);
+  mergedPps.setLoopFilterAcrossTilesEnabledFlag(false);
+
+  const Int mergedWidthInCtus = (mergedWidth + ctuWidth - 1) / ctuWidth;
+  for (Int i = 0, rowStart = 0; i < numInputs; i++)
+  {
+    const Int column = i % numTileColumns;
+    if (column == 0 && i > 0)
+    {
+      rowStart += rowHeightsInCtus[i / numTileColumns - 1];
+    }
+    Int columnStart = 0;
+    for (Int c = 0; c < column; c++)
+    {
+      columnStart += columnWidthsInCtus[c];
+    }
+    sliceAddresses[i] = rowStart * mergedWidthInCtus + columnStart;
+  }
+
+  TComOutputBitstream mergedVpsBitstream;
+  m_cEntropyCoder.setBitstream(&mergedVpsBitstream);
+  m_cEntropyCoder.encodeVPS(&vps);
+  out.write(reinterpret_cast<const TChar*>(start_code_prefix), 4);
+  writeParameter(out, NAL_UNIT_VPS, 0, 0, mergedVpsBitstream.getFIFO(), m_parameterSetManager);
+
+  TComOutputBitstream mergedSpsBitstream;
+  m_cEntropyCoder.setBitstream(&mergedSpsBitstream);
+  m_cEntropyCoder.encodeSPS(&mergedSps);
+  out.write(reinterpret_cast<const TChar*>(start_code_prefix), 4);
+  writeParameter(out, NAL_UNIT_SPS, 0, 0, mergedSpsBitstream.getFIFO(), m_parameterSetManager);
+
+  TComOutputBitstream mergedPpsBitstream;
+  m_cEntropyCoder.setBitstream(&mergedPpsBitstream);
+  m_cEntropyCoder.encodePPS(&mergedPps);
+  out.write(reinterpret_cast<const TChar*>(start_code_prefix), 4);
+  writeParameter(out, NAL_UNIT_PPS, 0, 0, mergedPpsBitstream.getFIFO(), m_parameterSetManager);
+}
+
 Void TAppDecTop::xInitDecLib()
 {
 
@@ -92,6 +92,7 @@ public:
   Void  create            (); ///< create internal members
   Void  destroy           (); ///< destroy internal members
   Void  decode            (); ///< main decoding function
+  Void  merge             (); ///< merge sub-picture bitstreams into one bitstream with a tile per sub-picture
 
 	//edit JW
 	Void  setSEIMessageOutputStream(std::ostream *pOpStream) { m_pSEIOutputStream = pOpStream; }
@@ -106,6 +107,9 @@ private:
 	Void writeParameter(fstream& out, NalUnitType nalUnitType, UInt temporalId, UInt nuhLayerId, vector<uint8_t>& rbsp, ParameterSetManager& parameterSetmanager);
   Void replaceParameter(fstream& out, SEIMCTSExtractionInfoSets& sei, Int mctsEisIdTarget, Int mctsSetIdxTarget, ParameterSetManager& parameterSetmanager);
 	Void writeSlice(fstream& out, InputNALUnit& nalu, TComSlice* pcSlice);
+  Void xClearInterRPSPrediction(TComSPS& sps);
+  Level::Name xDeriveMergedLevel(Level::Name subPictureLevel, const TComSPS& mergedSps, UInt numTileColumns, UInt numTileRows, Double frameRate);
+  Void xWriteMergedParameterSets(fstream& out, TComVPS& vps, std::vector<TComSlice*>& slices, Int numTileColumns, std::vector<Int>& sliceAddresses);
 };
 
 //! \}
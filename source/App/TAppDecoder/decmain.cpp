@@ -68,7 +68,14 @@ int main(int argc, char* argv[])
 
 
   // call decoding function
-  cTAppDecTop.decode();
+  if (cTAppDecTop.isMergeMode())
+  {
+    cTAppDecTop.merge();
+  }
+  else
+  {
+    cTAppDecTop.decode();
+  }
 
   // destroy application decoder class
   cTAppDecTop.destroy();
@@ -42,6 +42,7 @@
 #include <string>
 #include <limits>
 #include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComCPUFeatures.h"
 #include "TAppEncCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibEncoder/TEncRateCtrl.h"
@@ -649,6 +650,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   SMultiValueInput<Int>  cfg_codedPivotValue                 (std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max(), 0, 1<<16);
   SMultiValueInput<Int>  cfg_targetPivotValue                (std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max(), 0, 1<<16);
 
+  SMultiValueInput<Int>  cfg_ladderQPs                       (-MAX_QP, MAX_QP, 0, std::numeric_limits<Int>::max());
+
   SMultiValueInput<Double> cfg_adIntraLambdaModifier         (0, std::numeric_limits<Double>::max(), 0, MAX_TLAYER); ///< Lambda modifier for Intra pictures, one for each temporal layer. If size>temporalLayer, then use [temporalLayer], else if size>0, use [size()-1], else use m_adLambdaModifier.
 
   const Int defaultLumaLevelTodQp_QpChangePoints[]   =  {-3,  -2,  -1,   0,   1,   2,   3,   4,   5,   6};
@@ -693,6 +696,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV input file name")
   ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name")
   ("ReconFile,o",                                     m_reconFileName,                             string(""), "Reconstructed YUV output file name")
+  ("AnalysisSaveFile",                                m_analysisSaveFileName,                      string(""), "Output file name of the CU decisions and motion vectors of this encode")
+  ("AnalysisLoadFile",                                m_analysisLoadFileName,                      string(""), "CU decisions and motion vectors of an earlier encode of the same source, used to narrow the search")
   ("SourceWidth,-wdt",                                m_iSourceWidth,                                       0, "Source picture width")
   ("SourceHeight,-hgt",                               m_iSourceHeight,                                      0, "Source picture height")
   ("InputBitDepth",                                   m_inputBitDepth[CHANNEL_TYPE_LUMA],                   8, "Bit-depth of input file")
@@ -716,6 +721,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("PrintMSSSIM",                                     m_printMSSSIM,                                    false, "0 (default) do not print MS-SSIM scores, 1 = print MS-SSIM scores for each frame and for the whole sequence")
 #endif
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
+  ("LargePagePlanes",                                 m_largePagePlanes,                                false, "Allocate the picture buffers on 2 MB (huge) pages where large enough, with rows and picture areas aligned to 64 bytes")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceMode",                                 m_conformanceWindowMode,                              0, "Deprecated alias of ConformanceWindowMode")
   ("ConformanceWindowMode",                           m_conformanceWindowMode,                              0, "Window conformance mode (0: no window, 1:automatic padding, 2:padding, 3:conformance")
@@ -734,11 +740,18 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FrameSkip,-fs",                                   m_FrameSkip,                                         0u, "Number of frames to skip at start of input YUV")
   ("TemporalSubsampleRatio,-ts",                      m_temporalSubsampleRatio,                            1u, "Temporal sub-sample ratio when reading input YUV")
   ("FramesToBeEncoded,f",                             m_framesToBeEncoded,                                  0, "Number of frames to be encoded (default=all)")
+  ("NumSegments",                                     m_numSegments,                                        0, "Number of IDR-aligned segments FramesToBeEncoded is split into for segment-parallel encoding (0: disabled)")
+  ("SegmentIndex",                                    m_segmentIndex,                                       0, "Index of the segment to be encoded when NumSegments is greater than 0")
+  ("SubPictureOffsetX",                               m_subPictureOffsetX,                                  0, "Horizontal offset of the sub-picture encoded for spatially distributed encoding")
+  ("SubPictureOffsetY",                               m_subPictureOffsetY,                                  0, "Vertical offset of the sub-picture encoded for spatially distributed encoding")
+  ("SubPictureWidth",                                 m_subPictureWidth,                                    0, "Width of the sub-picture encoded for spatially distributed encoding (0: whole source picture)")
+  ("SubPictureHeight",                                m_subPictureHeight,                                   0, "Height of the sub-picture encoded for spatially distributed encoding (0: whole source picture)")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("SIMD",                                            m_simdLevel,                                          3, "Highest instruction set used by the vectorised kernels, limited to what the CPU supports (0: C only, 1: SSE2, 2: SSE4.1, 3: AVX2)")
 
   //Field coding parameters
   ("FieldCoding",                                     m_isField,                                        false, "Signals if it's a field based coding")
@@ -788,6 +801,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("FastSearch",                                      tmpMotionEstimationSearchMethod,  Int(MESEARCH_DIAMOND), "0:Full search 1:Diamond 2:Selective 3:Enhanced Diamond")
   ("SearchRange,-sr",                                 m_iSearchRange,                                      96, "Motion search range")
   ("BipredSearchRange",                               m_bipredSearchRange,                                  4, "Motion search range for bipred refinement")
+  ("HierarchicalME",                                  m_bHierarchicalME,                                false, "Coarse motion search per CTU and 16x16 block on the luma downsampled by 2 and 4, giving an extra start point to the TZ search (FastSearch=1 or 3)")
+  ("HierarchicalMERange",                             m_hierarchicalMERange,                               32, "Search range of the coarse motion search at quarter resolution")
+  ("HierarchicalMERefineRange",                       m_hierarchicalMERefineRange,                         16, "TZ search range around the best start point when HierarchicalME is enabled")
+  ("CompressedReferences",                            m_bCompressedReferences,                          false, "Keep the reconstructions of the reference pictures that the current picture does not predict from losslessly compressed")
+  ("Luma8BitME",                                      m_bLuma8BitME,                                    false, "Compute the SADs of the TZ search on 8-bit copies of the luma samples of the block and the reference pictures (InternalBitDepth=8, FastSearch=1 or 3). The copies are kept in addition to the 16-bit samples and cost half a padded luma plane per searched picture")
+  ("SubPelPlanes",                                    m_subPelPlanes,                                       0, "Precompute the luma sub-sample planes of reference pictures for fractional ME and uni-predicted MC. 0:off 1:half-sample planes only 2:all 15 planes")
   ("MinSearchWindow",                                 m_minSearchWindow,                                    8, "Minimum motion search window size for the adaptive window ME")
   ("RestrictMESampling",                              m_bRestrictMESampling,                            false, "Restrict ME Sampling for selective inter motion search")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        false, "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
@@ -819,6 +838,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("IntraQPOffset",                                   m_intraQPOffset,                                      0, "Qp offset value for intra slice, typically determined based on GOP size")
   ("LambdaFromQpEnable",                              m_lambdaFromQPEnable,                             false, "Enable flag for derivation of lambda from QP")
 #endif
+  ("LadderQPs",                                       cfg_ladderQPs,                            cfg_ladderQPs, "QPs of additional bitstreams encoded from the same input, reusing the CU decisions and motion of the main encode")
   ("DeltaQpRD,-dqr",                                  m_uiDeltaQpRD,                                       0u, "max dQp offset for slice")
   ("MaxDeltaQP,d",                                    m_iMaxDeltaQP,                                        0, "max dQp offset for block")
   ("MaxCuDQPDepth,-dqd",                              m_iMaxCuDQPDepth,                                     0, "max depth for a minimum CuDQP")
@@ -915,6 +935,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("NumTileRowsMinus1",                               m_numTileRowsMinus1,                                  0,          "Number of rows in a picture minus 1")
   ("TileColumnWidthArray",                            cfg_ColumnWidth,                        cfg_ColumnWidth, "Array containing tile column width values in units of CTU")
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
+  ("TileMajorSource",                                 m_tileMajorSource,                                false, "Read the source picture in the CTU coding from a copy where each tile, with its margin, is stored in its own contiguous block")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
@@ -938,6 +959,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ( "KeepHierarchicalBit",                            m_RCKeepHierarchicalBit,                              0, "Rate control: 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation" )
   ( "LCULevelRateControl",                            m_RCLCULevelRC,                                    true, "Rate control: true: CTU level RC; false: picture level RC" )
   ( "RCLCUSeparateModel",                             m_RCUseLCUSeparateModel,                           true, "Rate control: use CTU level separate R-lambda model" )
+  ( "RCTileLevelRateControl",                         m_RCTileLevelRC,                                  false, "Rate control: allocate bits and track the CPB per tile, in proportion to the tile area" )
   ( "InitialQP",                                      m_RCInitialQP,                                        0, "Rate control: initial QP" )
   ( "RCForceIntraQP",                                 m_RCForceIntraQP,                                 false, "Rate control: force intra QP to be equal to initial QP" )
   ( "RCCpbSaturation",                                m_RCCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
@@ -1140,9 +1162,36 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
    */
   m_inputFileWidth  = m_iSourceWidth;
   m_inputFileHeight = m_iSourceHeight;
+  if (m_subPictureWidth > 0)
+  {
+    m_iSourceWidth  = m_subPictureWidth;
+  }
+  if (m_subPictureHeight > 0)
+  {
+    m_iSourceHeight = m_subPictureHeight;
+  }
 
   m_framesToBeEncoded = ( m_framesToBeEncoded + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
+  if (m_numSegments > 0 && m_iIntraPeriod > 0 && m_segmentIndex >= 0 && m_segmentIndex < m_numSegments)
+  {
+    // each segment is a whole number of intra periods, so that every segment starts with an IDR picture
+    const Int numIntraPeriods   = ( m_framesToBeEncoded + m_iIntraPeriod - 1 ) / m_iIntraPeriod;
+    const Int periodsPerSegment = ( numIntraPeriods + m_numSegments - 1 ) / m_numSegments;
+    const Int segmentLength     = periodsPerSegment * m_iIntraPeriod;
+    const Int segmentStart      = m_segmentIndex * segmentLength;
+
+    if (segmentStart >= m_framesToBeEncoded)
+    {
+      // more segments than intra periods: this segment has no frames and no bitstream is written
+      printf( "Segment %d of %d is empty, nothing to encode.\n", m_segmentIndex, m_numSegments );
+      exit( EXIT_SUCCESS );
+    }
+
+    m_FrameSkip        += segmentStart * m_temporalSubsampleRatio;
+    m_framesToBeEncoded = std::min(segmentLength, m_framesToBeEncoded - segmentStart);
+  }
   m_adIntraLambdaModifier = cfg_adIntraLambdaModifier.values;
+  m_ladderQPs = cfg_ladderQPs.values;
   if(m_isField)
   {
     //Frame height
@@ -1808,6 +1857,31 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_iFrameRate <= 0,                                                          "Frame rate must be more than 1" );
   xConfirmPara( m_temporalSubsampleRatio < 1,                                               "Temporal subsample rate must be no less than 1" );
   xConfirmPara( m_framesToBeEncoded <= 0,                                                   "Total Number Of Frames encoded must be more than 0" );
+  xConfirmPara( m_simdLevel < SIMD_NONE || m_simdLevel > SIMD_AVX2,                        "SIMD must be in the range of 0 to 3, inclusive" );
+  if (m_numSegments > 0)
+  {
+    xConfirmPara( m_segmentIndex < 0 || m_segmentIndex >= m_numSegments,                    "SegmentIndex must be in the range of 0 to NumSegments-1, inclusive" );
+    xConfirmPara( m_iIntraPeriod <= 0,                                                      "Segment-parallel encoding requires a positive IntraPeriod" );
+    xConfirmPara( m_iDecodingRefreshType != 2,                                              "Segment-parallel encoding requires closed GOPs (DecodingRefreshType 2)" );
+    xConfirmPara( m_isField,                                                                "Segment-parallel encoding is not supported with field coding" );
+  }
+  if (m_subPictureWidth > 0 || m_subPictureHeight > 0)
+  {
+    const Int subPictureWidth  = m_subPictureWidth  > 0 ? m_subPictureWidth  : m_inputFileWidth;
+    const Int subPictureHeight = m_subPictureHeight > 0 ? m_subPictureHeight : m_inputFileHeight;
+    xConfirmPara( m_subPictureOffsetX < 0 || m_subPictureOffsetY < 0,                       "Sub-picture offsets must not be negative" );
+    xConfirmPara( m_subPictureOffsetX + subPictureWidth  > m_inputFileWidth,                 "Sub-picture exceeds the width of the source picture" );
+    xConfirmPara( m_subPictureOffsetY + subPictureHeight > m_inputFileHeight,                "Sub-picture exceeds the height of the source picture" );
+    xConfirmPara( m_subPictureOffsetX % m_uiMaxCUWidth  != 0,                                "Sub-picture horizontal offset must be a multiple of the CTU size" );
+    xConfirmPara( m_subPictureOffsetY % m_uiMaxCUHeight != 0,                                "Sub-picture vertical offset must be a multiple of the CTU size" );
+    xConfirmPara( m_subPictureOffsetX + subPictureWidth  < m_inputFileWidth  && subPictureWidth  % m_uiMaxCUWidth  != 0, "Sub-picture width must be a multiple of the CTU size unless it ends at the right picture boundary" );
+    xConfirmPara( m_subPictureOffsetY + subPictureHeight < m_inputFileHeight && subPictureHeight % m_uiMaxCUHeight != 0, "Sub-picture height must be a multiple of the CTU size unless it ends at the bottom picture boundary" );
+    xConfirmPara( m_numTileColumnsMinus1 > 0 || m_numTileRowsMinus1 > 0,                    "Sub-picture encoding produces a single tile per sub-picture; tiles are assigned by the merger" );
+    xConfirmPara( !m_tmctsSEITileConstraint,                                                "Sub-picture encoding requires SEITMCTSTileConstraint so that the sub-pictures can be merged" );
+    xConfirmPara( m_entropyCodingSyncEnabledFlag,                                           "Sub-picture encoding does not support wavefront parallel processing" );
+    xConfirmPara( m_sliceMode != NO_SLICES || m_sliceSegmentMode != NO_SLICES,              "Sub-picture encoding requires a single slice per picture" );
+    xConfirmPara( m_isField,                                                                "Sub-picture encoding is not supported with field coding" );
+  }
   xConfirmPara( m_iGOPSize < 1 ,                                                            "GOP Size must be greater or equal to 1" );
   xConfirmPara( m_iGOPSize > 1 &&  m_iGOPSize % 2,                                          "GOP Size must be a multiple of 2, if GOP Size is greater than 1" );
   xConfirmPara( (m_iIntraPeriod > 0 && m_iIntraPeriod < m_iGOPSize) || m_iIntraPeriod == 0, "Intra period must be more than GOP size, or -1 , not 0" );
@@ -1858,11 +1932,20 @@ Void TAppEncCfg::xCheckParameter()
   }
 
   xConfirmPara( m_iQP <  -6 * (m_internalBitDepth[CHANNEL_TYPE_LUMA] - 8) || m_iQP > 51,    "QP exceeds supported range (-QpBDOffsety to 51)" );
+  for (UInt i = 0; i < m_ladderQPs.size(); i++)
+  {
+    xConfirmPara( m_ladderQPs[i] < -6 * (m_internalBitDepth[CHANNEL_TYPE_LUMA] - 8) || m_ladderQPs[i] > 51, "LadderQPs exceed supported range (-QpBDOffsety to 51)" );
+  }
+  xConfirmPara( !m_ladderQPs.empty() && m_RCEnableRateControl,                              "LadderQPs cannot be used with rate control" );
+  xConfirmPara( !m_analysisSaveFileName.empty() && m_analysisSaveFileName == m_analysisLoadFileName, "AnalysisSaveFile and AnalysisLoadFile must be different files" );
   xConfirmPara( m_deblockingFilterMetric!=0 && (m_bLoopFilterDisable || m_loopFilterOffsetInPPS), "If DeblockingFilterMetric is non-zero then both LoopFilterDisable and LoopFilterOffsetInPPS must be 0");
   xConfirmPara( m_loopFilterBetaOffsetDiv2 < -6 || m_loopFilterBetaOffsetDiv2 > 6,        "Loop Filter Beta Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_loopFilterTcOffsetDiv2 < -6 || m_loopFilterTcOffsetDiv2 > 6,            "Loop Filter Tc Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
+  xConfirmPara( m_subPelPlanes < 0 || m_subPelPlanes > 2,                                   "SubPelPlanes must be 0, 1 or 2" );
+  xConfirmPara( m_hierarchicalMERange < 1 || m_hierarchicalMERange > 256,                   "HierarchicalMERange must be in the range of 1 to 256" );
+  xConfirmPara( m_hierarchicalMERefineRange < 1,                                            "HierarchicalMERefineRange must be more than 0" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
   xConfirmPara( m_iMaxDeltaQP > 7,                                                          "Absolute Delta QP exceeds supported range (0 to 7)" );
   xConfirmPara(m_lumaLevelToDeltaQPMapping.mode &&  m_uiDeltaQpRD > 0, "Luma-level-based Delta QP cannot be used together with slice level multiple-QP optimization\n" );
@@ -2420,6 +2503,7 @@ Void TAppEncCfg::xCheckParameter()
       }
     }
     xConfirmPara( m_uiDeltaQpRD > 0, "Rate control cannot be used together with slice level multiple-QP optimization!\n" );
+    xConfirmPara( m_RCTileLevelRC && !m_RCLCULevelRC, "Tile level rate control requires CTU level rate control" );
     if ((m_RCCpbSaturationEnabled) && (m_level!=Level::NONE) && (m_profile!=Profile::NONE))
     {
       UInt uiLevelIdx = (m_level / 10) + (UInt)((m_level % 10) / 3);    // (m_level / 30)*3 + ((m_level % 10) / 3);
@@ -2430,6 +2514,7 @@ Void TAppEncCfg::xCheckParameter()
   else
   {
     xConfirmPara( m_RCCpbSaturationEnabled != 0, "Target bits saturation cannot be processed without Rate control" );
+    xConfirmPara( m_RCTileLevelRC, "Tile level rate control cannot be used without Rate control" );
   }
   if (m_vuiParametersPresentFlag)
   {
@@ -2461,6 +2546,12 @@ Void TAppEncCfg::xCheckParameter()
     m_tmctsSEIEnabled = false;
   }
 
+  if ((m_subPictureWidth > 0 || m_subPictureHeight > 0) && m_mctsExtractionInfoSetSEIEnabled)
+  {
+    printf("Warning: SEIMCTSExtractionInfoSets is set to false to disable motion-constrained tile sets extraction information sets SEI message because sub-picture encoding does not use tiles.\n");
+    m_mctsExtractionInfoSetSEIEnabled = false;
+  }
+
 #if MCTS_ENC
   if ((m_tmctsSEIEnabled) && (m_tmctsSEITileConstraint) && (!m_bLFCrossTileBoundaryFlag) )
   {
@@ -2512,6 +2603,14 @@ Void TAppEncCfg::xPrintParameter()
   printf("Input          File                    : %s\n", m_inputFileName.c_str()          );
   printf("Bitstream      File                    : %s\n", m_bitstreamFileName.c_str()      );
   printf("Reconstruction File                    : %s\n", m_reconFileName.c_str()          );
+  if (!m_analysisSaveFileName.empty())
+  {
+    printf("Analysis Save File                     : %s\n", m_analysisSaveFileName.c_str()   );
+  }
+  if (!m_analysisLoadFileName.empty())
+  {
+    printf("Analysis Load File                     : %s\n", m_analysisLoadFileName.c_str()   );
+  }
   printf("Real     Format                        : %dx%d %gHz\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, (Double)m_iFrameRate/m_temporalSubsampleRatio );
   printf("Internal Format                        : %dx%d %gHz\n", m_iSourceWidth, m_iSourceHeight, (Double)m_iFrameRate/m_temporalSubsampleRatio );
   printf("Sequence PSNR output                   : %s\n", (m_printMSEBasedSequencePSNR ? "Linear average, MSE-based" : "Linear average only") );
@@ -2533,6 +2632,14 @@ Void TAppEncCfg::xPrintParameter()
     printf("Frame/Field                            : Frame based coding\n");
     printf("Frame index                            : %u - %d (%d frames)\n", m_FrameSkip, m_FrameSkip+m_framesToBeEncoded-1, m_framesToBeEncoded );
   }
+  if (m_numSegments > 0)
+  {
+    printf("Segment                                : %d of %d\n", m_segmentIndex, m_numSegments );
+  }
+  if (m_subPictureWidth > 0 || m_subPictureHeight > 0)
+  {
+    printf("Sub-picture                            : %dx%d at (%d,%d) of %dx%d\n", m_iSourceWidth - m_confWinLeft - m_confWinRight, m_iSourceHeight - m_confWinTop - m_confWinBottom, m_subPictureOffsetX, m_subPictureOffsetY, m_inputFileWidth, m_inputFileHeight );
+  }
   if (m_profile == Profile::MAINREXT)
   {
     ExtendedProfileName validProfileName;
@@ -2582,6 +2689,15 @@ Void TAppEncCfg::xPrintParameter()
 #else
   printf("QP                                     : %5.2f\n", m_fQP );
 #endif
+  if (!m_ladderQPs.empty())
+  {
+    printf("Ladder QPs                             :");
+    for (UInt i = 0; i < m_ladderQPs.size(); i++)
+    {
+      printf(" %d", m_ladderQPs[i]);
+    }
+    printf("\n");
+  }
   printf("Max dQP signaling depth                : %d\n", m_iMaxCuDQPDepth);
 
   printf("Cb QP Offset                           : %d\n", m_cbQpOffset   );
@@ -2628,6 +2744,7 @@ Void TAppEncCfg::xPrintParameter()
     printf("KeepHierarchicalBit                    : %d\n", m_RCKeepHierarchicalBit );
     printf("LCULevelRC                             : %d\n", m_RCLCULevelRC );
     printf("UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
+    printf("TileLevelRC                            : %d\n", m_RCTileLevelRC );
     printf("InitialQP                              : %d\n", m_RCInitialQP );
     printf("ForceIntraQP                           : %d\n", m_RCForceIntraQP );
     printf("CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
@@ -2697,6 +2814,7 @@ Void TAppEncCfg::xPrintParameter()
 
   printf(" SignBitHidingFlag:%d ", m_signDataHidingEnabledFlag);
   printf("RecalQP:%d", m_recalculateQPAccordingToLambda ? 1 : 0 );
+  printf(" SIMD:%d", std::min<Int>(m_simdLevel, getSIMDLevel()) );
 
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
@@ -72,6 +72,8 @@ protected:
   std::string m_inputFileName;                                ///< source file name
   std::string m_bitstreamFileName;                            ///< output bitstream file
   std::string m_reconFileName;                                ///< output reconstruction file
+  std::string m_analysisSaveFileName;                         ///< output file of the CU decisions and motion of this encode
+  std::string m_analysisLoadFileName;                         ///< CU decisions and motion of an earlier encode of the same source
 
   // Lambda modifiers
   Double    m_adLambdaModifier[ MAX_TLAYER ];                 ///< Lambda modifier array for each temporal layer
@@ -100,6 +102,12 @@ protected:
   Int       m_confWinTop;
   Int       m_confWinBottom;
   Int       m_framesToBeEncoded;                              ///< number of encoded frames
+  Int       m_numSegments;                                    ///< number of IDR-aligned segments the input is split into (0: disabled)
+  Int       m_segmentIndex;                                   ///< index of the segment encoded by this instance
+  Int       m_subPictureOffsetX;                              ///< horizontal offset of the encoded sub-picture in the input file
+  Int       m_subPictureOffsetY;                              ///< vertical offset of the encoded sub-picture in the input file
+  Int       m_subPictureWidth;                                ///< width of the encoded sub-picture (0: whole input picture)
+  Int       m_subPictureHeight;                               ///< height of the encoded sub-picture (0: whole input picture)
   Int       m_aiPad[2];                                       ///< number of padded pixels for width and height
   Bool      m_AccessUnitDelimiter;                            ///< add Access Unit Delimiter NAL units
   InputColourSpaceConversion m_inputColourSpaceConvert;       ///< colour space conversion to apply to input video
@@ -114,6 +122,7 @@ protected:
   Bool      m_printMSSSIM;
 #endif
   Bool      m_cabacZeroWordPaddingEnabled;
+  Bool      m_largePagePlanes;                                ///< allocate the picture buffers on large pages with aligned rows
   Bool      m_bClipInputVideoToRec709Range;
   Bool      m_bClipOutputVideoToRec709Range;
 
@@ -167,6 +176,7 @@ protected:
   Bool      m_lambdaFromQPEnable;                             ///< enable flag for QP:lambda fix
 #endif
   std::string m_dQPFileName;                                  ///< QP offset for each slice (initialized from external file)
+  std::vector<Int> m_ladderQPs;                               ///< QPs of additional encodes that reuse the decisions of the main encode
   Int*      m_aidQP;                                          ///< array of slice QP values
   Int       m_iMaxDeltaQP;                                    ///< max. |delta QP|
   UInt      m_uiDeltaQpRD;                                    ///< dQP range for multi-pass slice QP optimization
@@ -252,6 +262,12 @@ protected:
   Bool      m_bRestrictMESampling;                            ///< Restrict sampling for the Selective ME
   Int       m_iSearchRange;                                   ///< ME search range
   Int       m_bipredSearchRange;                              ///< ME search range for bipred refinement
+  Int       m_subPelPlanes;                                   ///< precomputed luma sub-sample planes of reference pictures (0: off, 1: half-sample only, 2: all)
+  Bool      m_bHierarchicalME;                                ///< coarse motion search on downsampled pictures before the TZ search
+  Int       m_hierarchicalMERange;                            ///< search range of the coarse search at quarter resolution
+  Int       m_hierarchicalMERefineRange;                      ///< TZ search range around the best start point when the coarse search is used
+  Bool      m_bLuma8BitME;                                    ///< integer motion search SADs on 8-bit copies of the luma samples
+  Bool      m_bCompressedReferences;                          ///< keep the reference pictures a picture does not predict from compressed
   Int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
   Bool      m_bClipForBiPredMeEnabled;                        ///< Enables clipping for Bi-Pred ME.
   Bool      m_bFastMEAssumingSmootherMVEnabled;               ///< Enables fast ME assuming a smoother MV.
@@ -272,6 +288,7 @@ protected:
   Int       m_numTileRowsMinus1;
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
+  Bool      m_tileMajorSource;                                ///< keep a copy of the source picture with each tile in its own contiguous block
   Bool      m_entropyCodingSyncEnabledFlag;
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
@@ -367,6 +384,7 @@ protected:
   Int       m_RCKeepHierarchicalBit;              ///< 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation
   Bool      m_RCLCULevelRC;                       ///< true: LCU level rate control; false: picture level rate control NOTE: code-tidy - rename to m_RCCtuLevelRC
   Bool      m_RCUseLCUSeparateModel;              ///< use separate R-lambda model at LCU level                        NOTE: code-tidy - rename to m_RCUseCtuSeparateModel
+  Bool      m_RCTileLevelRC;                      ///< per-tile bit budgets, R-lambda models and CPB tracking
   Int       m_RCInitialQP;                        ///< inital QP for rate control
   Bool      m_RCForceIntraQP;                     ///< force all intra picture to use initial QP or not
   Bool      m_RCCpbSaturationEnabled;             ///< enable target bits saturation to avoid CPB overflow and underflow
@@ -422,6 +440,7 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  Int         m_simdLevel;                                    ///< highest instruction set used by the vectorised kernels (0: C only, 1: SSE2, 2: SSE4.1, 3: AVX2)
 
 #if EXTENSION_360_VIDEO
   TExt360AppEncCfg m_ext360;
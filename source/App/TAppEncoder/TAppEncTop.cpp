@@ -42,9 +42,11 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <iomanip>
+#include <sstream>
 
 #include "TAppEncTop.h"
 #include "TLibEncoder/AnnexBwrite.h"
+#include "TLibCommon/TComCPUFeatures.h"
 
 #if EXTENSION_360_VIDEO
 #include "TAppEncHelper360/TExt360AppEncTop.h"
@@ -55,6 +57,20 @@ using namespace std;
 //! \ingroup TAppEncoder
 //! \{
 
+/// name of an output file of a ladder rung: the QP is inserted in front of the extension
+static string getLadderFileName(const string &fileName, Int iQP)
+{
+  ostringstream suffix;
+  suffix << "_QP" << iQP;
+  const size_t dot   = fileName.find_last_of('.');
+  const size_t slash = fileName.find_last_of("/\\");
+  if (dot == string::npos || (slash != string::npos && dot < slash))
+  {
+    return fileName + suffix.str();
+  }
+  return fileName.substr(0, dot) + suffix.str() + fileName.substr(dot);
+}
+
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -163,6 +179,12 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setMotionEstimationSearchMethod                      ( m_motionEstimationSearchMethod  );
   m_cTEncTop.setSearchRange                                       ( m_iSearchRange );
   m_cTEncTop.setBipredSearchRange                                 ( m_bipredSearchRange );
+  m_cTEncTop.setSubPelPlanes                                      ( m_subPelPlanes );
+  m_cTEncTop.setHierarchicalME                                    ( m_bHierarchicalME );
+  m_cTEncTop.setHierarchicalMERange                               ( m_hierarchicalMERange );
+  m_cTEncTop.setHierarchicalMERefineRange                         ( m_hierarchicalMERefineRange );
+  m_cTEncTop.setLuma8BitME                                        ( m_bLuma8BitME );
+  m_cTEncTop.setCompressedReferences                              ( m_bCompressedReferences );
   m_cTEncTop.setClipForBiPredMeEnabled                            ( m_bClipForBiPredMeEnabled );
   m_cTEncTop.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
   m_cTEncTop.setMinSearchWindow                                   ( m_minSearchWindow );
@@ -370,6 +392,7 @@ Void TAppEncTop::xInitLibCfg()
     m_cTEncTop.setColumnWidth                                     ( m_tileColumnWidth );
     m_cTEncTop.setRowHeight                                       ( m_tileRowHeight );
   }
+  m_cTEncTop.setTileMajorSource                                  ( m_tileMajorSource );
   m_cTEncTop.xCheckGSParameters();
   Int uiTilesCount = (m_numTileRowsMinus1+1) * (m_numTileColumnsMinus1+1);
   if(uiTilesCount == 1)
@@ -387,6 +410,7 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
   m_cTEncTop.setLCULevelRC                                        ( m_RCLCULevelRC );
   m_cTEncTop.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
+  m_cTEncTop.setTileLevelRC                                       ( m_RCTileLevelRC );
   m_cTEncTop.setInitialQP                                         ( m_RCInitialQP );
   m_cTEncTop.setForceIntraQP                                      ( m_RCForceIntraQP );
   m_cTEncTop.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
@@ -434,12 +458,39 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setSummaryOutFilename                                ( m_summaryOutFilename );
   m_cTEncTop.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
   m_cTEncTop.setSummaryVerboseness                                ( m_summaryVerboseness );
+
+  // ladder rungs use the configuration of the main encode apart from the QP, and narrow their search with its decisions
+  m_cTEncTop.setAnalysisSave                                      ( m_ladderQPs.empty() && m_analysisSaveFileName.empty() ? NULL : &m_cSavedAnalysis );
+  m_cTEncTop.setAnalysisLoad                                      ( m_analysisLoadFileName.empty() ? NULL : &m_cLoadedAnalysis );
+  for (UInt i = 0; i < m_ladderQPs.size(); i++)
+  {
+    TAppEncLadderRung* pcRung = new TAppEncLadderRung;
+    static_cast<TEncCfg&>(pcRung->m_cTEncTop) = m_cTEncTop;
+    pcRung->m_iQP = m_ladderQPs[i];
+    pcRung->m_cTEncTop.setQP                                      ( m_ladderQPs[i] );
+    pcRung->m_cTEncTop.setAnalysisSave                            ( NULL );
+    pcRung->m_cTEncTop.setAnalysisLoad                            ( &m_cSavedAnalysis );
+    pcRung->m_cTEncTop.setSummaryOutFilename                      ( string() );
+    pcRung->m_cTEncTop.setSummaryPicFilenameBase                  ( string() );
+    pcRung->m_bitstreamFileName = getLadderFileName(m_bitstreamFileName, m_ladderQPs[i]);
+    pcRung->m_reconFileName     = m_reconFileName.empty() ? string() : getLadderFileName(m_reconFileName, m_ladderQPs[i]);
+    pcRung->m_essentialBytes    = 0;
+    pcRung->m_totalBytes        = 0;
+    m_ladderRungs.push_back(pcRung);
+  }
 }
 
 Void TAppEncTop::xCreateLib()
 {
+  // allocation of all picture buffers created from here on
+  TComPicYuv::setLargePagePlanes( m_largePagePlanes );
+
   // Video I/O
   m_cTVideoIOYuvInputFile.open( m_inputFileName,     false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+  if (m_subPictureWidth > 0 || m_subPictureHeight > 0)
+  {
+    m_cTVideoIOYuvInputFile.setReadWindow(m_inputFileWidth, m_inputFileHeight, m_subPictureOffsetX, m_subPictureOffsetY);
+  }
   m_cTVideoIOYuvInputFile.skipFrames(m_FrameSkip, m_inputFileWidth, m_inputFileHeight, m_InputChromaFormatIDC);
 
   if (!m_reconFileName.empty())
@@ -447,8 +498,29 @@ Void TAppEncTop::xCreateLib()
     m_cTVideoIOYuvReconFile.open(m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth);  // write mode
   }
 
+  if (!m_analysisSaveFileName.empty() && !m_cSavedAnalysis.openFile(m_analysisSaveFileName, true, m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth))
+  {
+    fprintf(stderr, "\nfailed to open analysis file `%s' for writing\n", m_analysisSaveFileName.c_str());
+    exit(EXIT_FAILURE);
+  }
+  if (!m_analysisLoadFileName.empty() && !m_cLoadedAnalysis.openFile(m_analysisLoadFileName, false, m_iSourceWidth, m_iSourceHeight, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth))
+  {
+    fprintf(stderr, "\nfailed to read analysis file `%s', or it was written for another picture or CTU size\n", m_analysisLoadFileName.c_str());
+    exit(EXIT_FAILURE);
+  }
+
   // Neo Decoder
   m_cTEncTop.create();
+
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    TAppEncLadderRung* pcRung = m_ladderRungs[i];
+    if (!pcRung->m_reconFileName.empty())
+    {
+      pcRung->m_cTVideoIOYuvReconFile.open(pcRung->m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth);  // write mode
+    }
+    pcRung->m_cTEncTop.create();
+  }
 }
 
 Void TAppEncTop::xDestroyLib()
@@ -456,14 +528,27 @@ Void TAppEncTop::xDestroyLib()
   // Video I/O
   m_cTVideoIOYuvInputFile.close();
   m_cTVideoIOYuvReconFile.close();
+  m_cSavedAnalysis.closeFile();
+  m_cLoadedAnalysis.closeFile();
 
   // Neo Decoder
   m_cTEncTop.destroy();
+
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    m_ladderRungs[i]->m_cTVideoIOYuvReconFile.close();
+    m_ladderRungs[i]->m_cTEncTop.destroy();
+  }
 }
 
 Void TAppEncTop::xInitLib(Bool isFieldCoding)
 {
   m_cTEncTop.init(isFieldCoding);
+
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    m_ladderRungs[i]->m_cTEncTop.init(isFieldCoding);
+  }
 }
 
 // ====================================================================================================================
@@ -490,11 +575,25 @@ Void TAppEncTop::encode()
   TComPicYuv*       pcPicYuvOrg = new TComPicYuv;
   TComPicYuv*       pcPicYuvRec = NULL;
 
+  // limit the kernels before the distortion functions are selected in xInitLib
+  setSIMDLevelLimit( SIMDLevel(m_simdLevel) );
+
   // initialize internal class & member variables
   xInitLibCfg();
   xCreateLib();
   xInitLib(m_isField);
 
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    TAppEncLadderRung* pcRung = m_ladderRungs[i];
+    pcRung->m_bitstreamFile.open(pcRung->m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
+    if (!pcRung->m_bitstreamFile)
+    {
+      fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", pcRung->m_bitstreamFileName.c_str());
+      exit(EXIT_FAILURE);
+    }
+  }
+
   printChromaFormat();
 
   // main encoder loop
@@ -527,7 +626,7 @@ Void TAppEncTop::encode()
   while ( !bEos )
   {
     // get buffers
-    xGetBuffer(pcPicYuvRec);
+    xGetBuffer(pcPicYuvRec, m_cListPicYuvRec);
 
     // read input YUV file
 #if EXTENSION_360_VIDEO
@@ -556,6 +655,10 @@ Void TAppEncTop::encode()
       bEos = true;
       m_iFrameRcvd--;
       m_cTEncTop.setFramesToBeEncoded(m_iFrameRcvd);
+      for (UInt i = 0; i < m_ladderRungs.size(); i++)
+      {
+        m_ladderRungs[i]->m_cTEncTop.setFramesToBeEncoded(m_iFrameRcvd);
+      }
     }
 
     // call encoding function for one frame
@@ -574,6 +677,32 @@ Void TAppEncTop::encode()
       xWriteOutput(bitstreamFile, iNumEncoded, outputAccessUnits);
       outputAccessUnits.clear();
     }
+
+    // the ladder rungs encode the same picture once the main encode has stored its decisions for it
+    for (UInt i = 0; i < m_ladderRungs.size(); i++)
+    {
+      TAppEncLadderRung* pcRung = m_ladderRungs[i];
+      Int iNumRungEncoded = 0;
+
+      xGetBuffer(pcPicYuvRec, pcRung->m_cListPicYuvRec);
+      if ( m_isField )
+      {
+        pcRung->m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, pcRung->m_cListPicYuvRec, outputAccessUnits, iNumRungEncoded, m_isTopFieldFirst );
+      }
+      else
+      {
+        pcRung->m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, pcRung->m_cListPicYuvRec, outputAccessUnits, iNumRungEncoded );
+      }
+
+      if ( iNumRungEncoded > 0 )
+      {
+        xWriteOutput(pcRung->m_bitstreamFile, pcRung->m_cTVideoIOYuvReconFile, !pcRung->m_reconFileName.empty(), pcRung->m_cListPicYuvRec,
+                     iNumRungEncoded, outputAccessUnits, pcRung->m_essentialBytes, pcRung->m_totalBytes);
+        outputAccessUnits.clear();
+      }
+    }
+    m_cSavedAnalysis.clear();
+    m_cLoadedAnalysis.clear();
     // temporally skip frames
     if( m_temporalSubsampleRatio > 1 )
     {
@@ -583,6 +712,12 @@ Void TAppEncTop::encode()
 
   m_cTEncTop.printSummary(m_isField);
 
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    printf("\nLadder rung QP %d (%s)\n", m_ladderRungs[i]->m_iQP, m_ladderRungs[i]->m_bitstreamFileName.c_str());
+    m_ladderRungs[i]->m_cTEncTop.printSummary(m_isField);
+  }
+
   // delete original YUV buffer
   pcPicYuvOrg->destroy();
   delete pcPicYuvOrg;
@@ -590,13 +725,29 @@ Void TAppEncTop::encode()
 
   // delete used buffers in encoder class
   m_cTEncTop.deletePicBuffer();
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    m_ladderRungs[i]->m_cTEncTop.deletePicBuffer();
+  }
   cPicYuvTrueOrg.destroy();
 
   // delete buffers & classes
-  xDeleteBuffer();
+  xDeleteBuffer(m_cListPicYuvRec);
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    xDeleteBuffer(m_ladderRungs[i]->m_cListPicYuvRec);
+  }
   xDestroyLib();
 
-  printRateSummary();
+  printRateSummary(m_totalBytes, m_essentialBytes);
+
+  for (UInt i = 0; i < m_ladderRungs.size(); i++)
+  {
+    printf("Ladder rung QP %d: ", m_ladderRungs[i]->m_iQP);
+    printRateSummary(m_ladderRungs[i]->m_totalBytes, m_ladderRungs[i]->m_essentialBytes);
+    delete m_ladderRungs[i];
+  }
+  m_ladderRungs.clear();
 
   return;
 }
@@ -611,14 +762,14 @@ Void TAppEncTop::encode()
  - end of the list has the latest picture
  .
  */
-Void TAppEncTop::xGetBuffer( TComPicYuv*& rpcPicYuvRec)
+Void TAppEncTop::xGetBuffer( TComPicYuv*& rpcPicYuvRec, TComList<TComPicYuv*>& rcListPicYuvRec )
 {
   assert( m_iGOPSize > 0 );
 
   // org. buffer
-  if ( m_cListPicYuvRec.size() >= (UInt)m_iGOPSize ) // buffer will be 1 element longer when using field coding, to maintain first field whilst processing second.
+  if ( rcListPicYuvRec.size() >= (UInt)m_iGOPSize ) // buffer will be 1 element longer when using field coding, to maintain first field whilst processing second.
   {
-    rpcPicYuvRec = m_cListPicYuvRec.popFront();
+    rpcPicYuvRec = rcListPicYuvRec.popFront();
 
   }
   else
@@ -628,14 +779,14 @@ Void TAppEncTop::xGetBuffer( TComPicYuv*& rpcPicYuvRec)
     rpcPicYuvRec->create( m_iSourceWidth, m_iSourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
 
   }
-  m_cListPicYuvRec.pushBack( rpcPicYuvRec );
+  rcListPicYuvRec.pushBack( rpcPicYuvRec );
 }
 
-Void TAppEncTop::xDeleteBuffer( )
+Void TAppEncTop::xDeleteBuffer( TComList<TComPicYuv*>& rcListPicYuvRec )
 {
-  TComList<TComPicYuv*>::iterator iterPicYuvRec  = m_cListPicYuvRec.begin();
+  TComList<TComPicYuv*>::iterator iterPicYuvRec  = rcListPicYuvRec.begin();
 
-  Int iSize = Int( m_cListPicYuvRec.size() );
+  Int iSize = Int( rcListPicYuvRec.size() );
 
   for ( Int i = 0; i < iSize; i++ )
   {
@@ -643,7 +794,7 @@ Void TAppEncTop::xDeleteBuffer( )
     pcPicYuvRec->destroy();
     delete pcPicYuvRec; pcPicYuvRec = NULL;
   }
-
+  rcListPicYuvRec.clear();
 }
 
 /** 
@@ -653,6 +804,15 @@ Void TAppEncTop::xDeleteBuffer( )
   \param accessUnits    list of access units to be written
  */
 Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits)
+{
+  xWriteOutput(bitstreamFile, m_cTVideoIOYuvReconFile, !m_reconFileName.empty(), m_cListPicYuvRec, iNumEncoded, accessUnits, m_essentialBytes, m_totalBytes);
+}
+
+/**
+  Write access units and reconstructed pictures of one encode to its output files.
+ */
+Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, TVideoIOYuv& rcReconFile, Bool bWriteRecon, TComList<TComPicYuv*>& rcListPicYuvRec,
+                              Int iNumEncoded, const std::list<AccessUnit>& accessUnits, UInt& ruiEssentialBytes, UInt& ruiTotalBytes)
 {
   const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
@@ -660,7 +820,7 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
   {
     //Reinterlace fields
     Int i;
-    TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
+    TComList<TComPicYuv*>::iterator iterPicYuvRec = rcListPicYuvRec.end();
     list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
 
     for ( i = 0; i < iNumEncoded; i++ )
@@ -673,25 +833,25 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
       TComPicYuv*  pcPicYuvRecTop  = *(iterPicYuvRec++);
       TComPicYuv*  pcPicYuvRecBottom  = *(iterPicYuvRec++);
 
-      if (!m_reconFileName.empty())
+      if (bWriteRecon)
       {
-        m_cTVideoIOYuvReconFile.write( pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+        rcReconFile.write( pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
       }
 
       const AccessUnit& auTop = *(iterBitstream++);
       const vector<UInt>& statsTop = writeAnnexB(bitstreamFile, auTop);
-      rateStatsAccum(auTop, statsTop);
+      rateStatsAccum(auTop, statsTop, ruiEssentialBytes, ruiTotalBytes);
 
       const AccessUnit& auBottom = *(iterBitstream++);
       const vector<UInt>& statsBottom = writeAnnexB(bitstreamFile, auBottom);
-      rateStatsAccum(auBottom, statsBottom);
+      rateStatsAccum(auBottom, statsBottom, ruiEssentialBytes, ruiTotalBytes);
     }
   }
   else
   {
     Int i;
 
-    TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
+    TComList<TComPicYuv*>::iterator iterPicYuvRec = rcListPicYuvRec.end();
     list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
 
     for ( i = 0; i < iNumEncoded; i++ )
@@ -702,15 +862,15 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
     for ( i = 0; i < iNumEncoded; i++ )
     {
       TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
-      if (!m_reconFileName.empty())
+      if (bWriteRecon)
       {
-        m_cTVideoIOYuvReconFile.write( pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
+        rcReconFile.write( pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
             NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
       }
 
       const AccessUnit& au = *(iterBitstream++);
       const vector<UInt>& stats = writeAnnexB(bitstreamFile, au);
-      rateStatsAccum(au, stats);
+      rateStatsAccum(au, stats, ruiEssentialBytes, ruiTotalBytes);
     }
   }
 }
@@ -718,7 +878,7 @@ Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, cons
 /**
  *
  */
-Void TAppEncTop::rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& annexBsizes)
+Void TAppEncTop::rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& annexBsizes, UInt& ruiEssentialBytes, UInt& ruiTotalBytes)
 {
   AccessUnit::const_iterator it_au = au.begin();
   vector<UInt>::const_iterator it_stats = annexBsizes.begin();
@@ -746,23 +906,23 @@ Void TAppEncTop::rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& a
     case NAL_UNIT_VPS:
     case NAL_UNIT_SPS:
     case NAL_UNIT_PPS:
-      m_essentialBytes += *it_stats;
+      ruiEssentialBytes += *it_stats;
       break;
     default:
       break;
     }
 
-    m_totalBytes += *it_stats;
+    ruiTotalBytes += *it_stats;
   }
 }
 
-Void TAppEncTop::printRateSummary()
+Void TAppEncTop::printRateSummary(UInt uiTotalBytes, UInt uiEssentialBytes)
 {
   Double time = (Double) m_iFrameRcvd / m_iFrameRate * m_temporalSubsampleRatio;
-  printf("Bytes written to file: %u (%.3f kbps)\n", m_totalBytes, 0.008 * m_totalBytes / time);
+  printf("Bytes written to file: %u (%.3f kbps)\n", uiTotalBytes, 0.008 * uiTotalBytes / time);
   if (m_summaryVerboseness > 0)
   {
-    printf("Bytes for SPS/PPS/Slice (Incl. Annex B): %u (%.3f kbps)\n", m_essentialBytes, 0.008 * m_essentialBytes / time);
+    printf("Bytes for SPS/PPS/Slice (Incl. Annex B): %u (%.3f kbps)\n", uiEssentialBytes, 0.008 * uiEssentialBytes / time);
   }
 }
 
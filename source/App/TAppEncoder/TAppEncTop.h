@@ -40,6 +40,7 @@
 
 #include <list>
 #include <ostream>
+#include <fstream>
 
 #include "TLibEncoder/TEncTop.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
@@ -53,6 +54,20 @@
 // Class definition
 // ====================================================================================================================
 
+/// additional encode of the input at another QP, narrowing its search with the decisions of the main encode
+struct TAppEncLadderRung
+{
+  Int                        m_iQP;                         ///< QP of this encode
+  TEncTop                    m_cTEncTop;                    ///< encoder class
+  std::string                m_bitstreamFileName;           ///< output bitstream file
+  std::string                m_reconFileName;               ///< output reconstruction file name, empty for none
+  std::fstream               m_bitstreamFile;               ///< output bitstream
+  TVideoIOYuv                m_cTVideoIOYuvReconFile;       ///< output reconstruction file
+  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files
+  UInt                       m_essentialBytes;
+  UInt                       m_totalBytes;
+};
+
 /// encoder application class
 class TAppEncTop : public TAppEncCfg
 {
@@ -69,6 +84,10 @@ private:
   UInt m_essentialBytes;
   UInt m_totalBytes;
 
+  std::vector<TAppEncLadderRung*> m_ladderRungs;            ///< additional encodes at the ladder QPs
+  TEncAnalysisData           m_cSavedAnalysis;              ///< decisions of the main encode, for the ladder rungs and the analysis save file
+  TEncAnalysisData           m_cLoadedAnalysis;             ///< decisions read from the analysis load file
+
 protected:
   // initialization
   Void  xCreateLib        ();                               ///< create files & encoder class
@@ -77,15 +96,17 @@ protected:
   Void  xDestroyLib       ();                               ///< destroy encoder class
 
   /// obtain required buffers
-  Void xGetBuffer(TComPicYuv*& rpcPicYuvRec);
+  Void xGetBuffer(TComPicYuv*& rpcPicYuvRec, TComList<TComPicYuv*>& rcListPicYuvRec);
 
   /// delete allocated buffers
-  Void  xDeleteBuffer     ();
+  Void  xDeleteBuffer     (TComList<TComPicYuv*>& rcListPicYuvRec);
 
   // file I/O
   Void xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits); ///< write bitstream to file
-  Void rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& stats);
-  Void printRateSummary();
+  Void xWriteOutput(std::ostream& bitstreamFile, TVideoIOYuv& rcReconFile, Bool bWriteRecon, TComList<TComPicYuv*>& rcListPicYuvRec,
+                    Int iNumEncoded, const std::list<AccessUnit>& accessUnits, UInt& ruiEssentialBytes, UInt& ruiTotalBytes);
+  Void rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& stats, UInt& ruiEssentialBytes, UInt& ruiTotalBytes);
+  Void printRateSummary(UInt uiTotalBytes, UInt uiEssentialBytes);
   Void printChromaFormat();
 
 public:
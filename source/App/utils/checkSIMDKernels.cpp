@@ -0,0 +1,786 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     checkSIMDKernels.cpp
+    \brief    Compares the vectorised kernels with the C versions on random blocks
+
+    Every check draws its block sizes, parameters and samples from a seeded random number generator, runs once
+    with the kernels limited to C (setSIMDLevelLimit(SIMD_NONE)) and once for each instruction set up to the one
+    supported by the CPU, and reports the first output that differs. A failing test can be repeated on its own
+    with --Seed set to the reported seed and --Iterations=1.
+*/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "TLibCommon/TComCPUFeatures.h"
+#include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComPattern.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComYuv.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComWeightPrediction.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComByteScan.h"
+#include "TLibEncoder/TEncSampleAdaptiveOffset.h"
+#include "TLibVideoIO/TVideoIOYuv.h"
+#include "TAppCommon/program_options_lite.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+typedef vector<Int64> CheckResult;
+
+// ====================================================================================================================
+// Random numbers, identical on all platforms so that a reported seed reproduces the failing test
+// ====================================================================================================================
+
+static UInt s_randomState = 1;
+
+static Void seedRandom( UInt seed )
+{
+  s_randomState = seed * 2654435761u + 1;
+}
+
+static UInt getRandom()
+{
+  s_randomState ^= s_randomState << 13;
+  s_randomState ^= s_randomState >> 17;
+  s_randomState ^= s_randomState << 5;
+  return s_randomState;
+}
+
+/// random value in [minValue, maxValue]
+static Int getRandom( Int minValue, Int maxValue )
+{
+  return minValue + Int( getRandom() % UInt( maxValue - minValue + 1 ) );
+}
+
+static Bool getRandomFlag()
+{
+  return ( getRandom() & 1 ) != 0;
+}
+
+static Int getRandomBlockSize()
+{
+  static const Int sizes[] = { 4, 8, 12, 16, 24, 32, 48, 64 };
+  return sizes[getRandom( 0, 7 )];
+}
+
+/// fills a block with samples of bitDepth bits: either noise over the whole range, or a ramp with noise of a random
+/// amplitude, which gives the small differences the filters and the edge classification act upon
+static Void fillSamples( Pel* dst, Int stride, Int width, Int height, Int bitDepth )
+{
+  const Int maxValue = ( 1 << bitDepth ) - 1;
+  if( getRandom( 0, 3 ) == 0 )
+  {
+    for( Int y = 0; y < height; y++ )
+    {
+      for( Int x = 0; x < width; x++ )
+      {
+        dst[y * stride + x] = Pel( getRandom( 0, maxValue ) );
+      }
+    }
+    return;
+  }
+
+  const Int base      = getRandom( 0, maxValue );
+  const Int slopeX    = getRandom( -4, 4 );
+  const Int slopeY    = getRandom( -4, 4 );
+  const Int amplitude = ( 1 << getRandom( 0, 5 ) ) >> 1;
+  for( Int y = 0; y < height; y++ )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      dst[y * stride + x] = Pel( Clip3( 0, maxValue, base + slopeX * x + slopeY * y + getRandom( -amplitude, amplitude ) ) );
+    }
+  }
+}
+
+static Void appendBlock( CheckResult& result, const Pel* src, Int stride, Int width, Int height )
+{
+  for( Int y = 0; y < height; y++ )
+  {
+    result.insert( result.end(), src + y * stride, src + y * stride + width );
+  }
+}
+
+/// fills a block with the intermediate values of the interpolation filter (isLast false) for random samples, as
+/// used for the inputs of the bi-prediction averaging and the second filter stage; always computed by the C version
+static Void fillIntermediate( Pel* dst, Int stride, Int width, Int height, Int bitDepth, Bool isLuma )
+{
+  // large enough for the blocks with margins of the other checks
+  const Int   margin    = 8;
+  const Int   srcStride = MAX_CU_SIZE + 4 * margin;
+  vector<Pel> src( srcStride * srcStride );
+  vector<Pel> tmp( srcStride * srcStride );
+  fillSamples( &src[0], srcStride, srcStride, srcStride, bitDepth );
+
+  const SIMDLevel level = getSIMDLevel();
+  setSIMDLevelLimit( SIMD_NONE );
+
+  TComInterpolationFilter filter;
+  const ComponentID compID  = isLuma ? COMPONENT_Y : COMPONENT_Cb;
+  const Int         numFrac = isLuma ? 4 : 8;
+  const Int         fracX   = getRandom( 0, numFrac - 1 );
+  const Int         fracY   = getRandom( 0, numFrac - 1 );
+  Pel* const        srcOrg  = &src[margin * srcStride + margin];
+  Pel* const        tmpOrg  = &tmp[margin * srcStride + margin];
+  if( fracY == 0 )
+  {
+    filter.filterHor( compID, srcOrg, srcStride, dst, stride, width, height, fracX, false, CHROMA_420, bitDepth );
+  }
+  else
+  {
+    const Int halfTaps = isLuma ? NTAPS_LUMA / 2 : NTAPS_CHROMA / 2;
+    filter.filterHor( compID, srcOrg - ( halfTaps - 1 ) * srcStride, srcStride, tmpOrg - ( halfTaps - 1 ) * srcStride, srcStride,
+                      width, height + 2 * halfTaps - 1, fracX, false, CHROMA_420, bitDepth );
+    filter.filterVer( compID, tmpOrg, srcStride, dst, stride, width, height, fracY, false, false, CHROMA_420, bitDepth );
+  }
+
+  setSIMDLevelLimit( level );
+}
+
+// ====================================================================================================================
+// Access to the protected functions that dispatch to the kernels
+// ====================================================================================================================
+
+class CheckTrQuant : public TComTrQuant
+{
+public:
+  using TComTrQuant::xT;
+  using TComTrQuant::xIT;
+  using TComTrQuant::xQuantBlock;
+  using TComTrQuant::xDeQuantBlock;
+};
+
+class CheckPrediction : public TComPrediction
+{
+public:
+  using TComPrediction::xPredIntraAng;
+  using TComPrediction::xPredIntraPlanar;
+  using TComPrediction::xDCPredFiltering;
+};
+
+class CheckLoopFilter : public TComLoopFilter
+{
+public:
+  using TComLoopFilter::xEdgeFilterLumaSegment;
+  using TComLoopFilter::xEdgeFilterChromaSegment;
+  static Int getTc  ( Int index ) { return sm_tcTable[index];   }
+  static Int getBeta( Int index ) { return sm_betaTable[index]; }
+};
+
+class CheckSampleAdaptiveOffset : public TEncSampleAdaptiveOffset
+{
+public:
+  using TComSampleAdaptiveOffset::offsetBlock;
+  using TEncSampleAdaptiveOffset::getBlkStats;
+};
+
+// ====================================================================================================================
+// Checks; each one draws its inputs from the random number generator and appends all outputs to result
+// ====================================================================================================================
+
+/// TComRdCost: SSE, SAD and Hadamard distortion functions, getSADs and getSADs8
+static Void checkDistortion( CheckResult& result )
+{
+  TComRdCost rdCost;   // selects the distortion functions for the current limit
+
+  const Int bitDepth  = getRandomFlag() ? 8 : 10;
+  const Int width     = getRandomBlockSize();
+  const Int height    = getRandomBlockSize();
+  const Int stride    = MAX_CU_SIZE + 16;
+  const Int numCands  = getRandom( 1, 9 );
+  vector<Pel> org( stride * stride );
+  vector<Pel> ref( stride * stride );
+  fillSamples( &org[0], stride, stride, stride, bitDepth );
+  fillSamples( &ref[0], stride, stride, stride, bitDepth );
+  const Pel* cur = &ref[getRandom( 0, 8 ) * stride + getRandom( 0, 8 )];
+
+  result.push_back( rdCost.getDistPart( bitDepth, cur, stride, &org[0], stride, width, height, COMPONENT_Y, DF_SSE ) );
+
+  // set up as in the integer motion search, which is the only user of getSADs
+  TComPattern pattern;
+  pattern.initPattern( &org[0], width, height, stride, bitDepth );
+  DistParam distParam;
+  rdCost.setDistParam( &pattern, cur, stride, distParam );
+  distParam.bitDepth   = bitDepth;
+  distParam.iSubShift  = getRandom( 0, 1 );
+  result.push_back( distParam.DistFunc( &distParam ) );
+
+  const Pel*  piCurs[9];
+  Distortion  sads[9];
+  for( Int i = 0; i < numCands; i++ )
+  {
+    piCurs[i] = &ref[getRandom( 0, 8 ) * stride + getRandom( 0, 8 )];
+  }
+  TComRdCost::getSADs( distParam, piCurs, numCands, sads );
+  result.insert( result.end(), sads, sads + numCands );
+
+  // 8-bit copies as kept by the hierarchical motion search
+  vector<UChar> org8( org.size() );
+  vector<UChar> ref8( ref.size() );
+  for( size_t i = 0; i < org.size(); i++ )
+  {
+    org8[i] = UChar( org[i] >> ( bitDepth - 8 ) );
+    ref8[i] = UChar( ref[i] >> ( bitDepth - 8 ) );
+  }
+  const UChar* piCurs8[9];
+  for( Int i = 0; i < numCands; i++ )
+  {
+    piCurs8[i] = &ref8[piCurs[i] - &ref[0]];
+  }
+  TComRdCost::getSADs8( distParam, &org8[0], stride, piCurs8, stride, numCands, sads );
+  result.insert( result.end(), sads, sads + numCands );
+
+  rdCost.setDistParam( distParam, bitDepth, &org[0], stride, cur, stride, width, height, false );
+  result.push_back( distParam.DistFunc( &distParam ) );
+  rdCost.setDistParam( distParam, bitDepth, &org[0], stride, cur, stride, width, height, true );
+  result.push_back( distParam.DistFunc( &distParam ) );
+}
+
+/// TComTrQuant: forward and inverse transforms
+static Void checkTransform( CheckResult& result )
+{
+  CheckTrQuant trQuant;
+
+  const Int  bitDepth = getRandomFlag() ? 8 : 10;
+  const Int  size     = 4 << getRandom( 0, 3 );
+  const Bool useDST   = size == 4 && getRandomFlag();
+  const Int  maxLog2TrDynamicRange = 15;
+
+  Pel    residual[MAX_TU_SIZE * MAX_TU_SIZE];
+  Pel    prediction[MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff coeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  fillSamples( residual, size, size, size, bitDepth );
+  fillSamples( prediction, size, size, size, bitDepth );
+  for( Int i = 0; i < size * size; i++ )
+  {
+    residual[i] -= prediction[i];
+  }
+
+  trQuant.xT( bitDepth, useDST, residual, size, coeff, size, size, maxLog2TrDynamicRange );
+  result.insert( result.end(), coeff, coeff + size * size );
+
+  // inverse of the forward result, and of sparse coefficients over the whole range
+  trQuant.xIT( bitDepth, useDST, coeff, residual, size, size, size, maxLog2TrDynamicRange );
+  appendBlock( result, residual, size, size, size );
+
+  const Int numNonZero = getRandom( 1, size * size );
+  memset( coeff, 0, sizeof( coeff ) );
+  for( Int i = 0; i < numNonZero; i++ )
+  {
+    coeff[getRandom( 0, size * size - 1 )] = getRandom( -( 1 << maxLog2TrDynamicRange ), ( 1 << maxLog2TrDynamicRange ) - 1 );
+  }
+  trQuant.xIT( bitDepth, useDST, coeff, residual, size, size, size, maxLog2TrDynamicRange );
+  appendBlock( result, residual, size, size, size );
+}
+
+/// TComTrQuant: quantisation without RDOQ and dequantisation, with and without scaling lists
+static Void checkQuantisation( CheckResult& result )
+{
+  const Int    bitDepth        = getRandomFlag() ? 8 : 10;
+  const Int    log2TrSize      = getRandom( 2, 5 );
+  const Int    numSamples      = 1 << ( 2 * log2TrSize );
+  const Int    maxLog2TrDynamicRange = 15;
+  const TCoeff coeffMinimum    = -( 1 << maxLog2TrDynamicRange );
+  const TCoeff coeffMaximum    =  ( 1 << maxLog2TrDynamicRange ) - 1;
+  const Int    transformShift  = maxLog2TrDynamicRange - bitDepth - log2TrSize;
+  const Int    qpPer           = getRandom( 0, ( 51 + 6 * ( bitDepth - 8 ) ) / 6 );
+  const Int    qpRem           = getRandom( 0, 5 );
+  const Bool   useScalingList  = getRandomFlag();
+
+  TCoeff coeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff qCoeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff deltaU[MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff arlCoeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  Int    scalingFactors[MAX_TU_SIZE * MAX_TU_SIZE];
+
+  const Int magnitude = 1 << getRandom( 4, maxLog2TrDynamicRange );
+  for( Int i = 0; i < numSamples; i++ )
+  {
+    coeff[i] = getRandom( std::max( coeffMinimum, -magnitude ), std::min( coeffMaximum, magnitude ) );
+  }
+
+  // quantisation: the scaling list values are g_quantScales * 16 / scaling_list_entry
+  for( Int i = 0; i < numSamples; i++ )
+  {
+    scalingFactors[i] = ( g_quantScales[qpRem] << LOG2_SCALING_LIST_NEUTRAL_VALUE ) / getRandom( 1, 255 );
+  }
+  const Int  iQBits  = QUANT_SHIFT + qpPer + transformShift;
+  const Int  iAdd    = ( getRandomFlag() ? 171 : 85 ) << ( iQBits - 9 );
+  const Int  iQBitsC = iQBits - ARL_C_PRECISION;
+  const Int  iAddC   = 1 << ( iQBitsC - 1 );
+  const Bool useArl  = getRandomFlag();
+  const TCoeff absSum = CheckTrQuant::xQuantBlock( coeff, qCoeff, deltaU, useArl ? arlCoeff : NULL, numSamples,
+                                                   useScalingList ? scalingFactors : NULL, g_quantScales[qpRem],
+                                                   iQBits, iAdd, iQBitsC, iAddC, coeffMinimum, coeffMaximum );
+  result.push_back( absSum );
+  result.insert( result.end(), qCoeff, qCoeff + numSamples );
+  result.insert( result.end(), deltaU, deltaU + numSamples );
+  if( useArl )
+  {
+    result.insert( result.end(), arlCoeff, arlCoeff + numSamples );
+  }
+
+  // dequantisation, with the clipping of the input derived as in xDeQuant
+  for( Int i = 0; i < numSamples; i++ )
+  {
+    qCoeff[i]         = getRandom( std::max( coeffMinimum, -magnitude ), std::min( coeffMaximum, magnitude ) );
+    scalingFactors[i] = g_invQuantScales[qpRem] * getRandom( 1, 255 );
+  }
+  const Int  rightShift    = ( IQUANT_SHIFT - ( transformShift + qpPer ) ) + ( useScalingList ? LOG2_SCALING_LIST_NEUTRAL_VALUE : 0 );
+  const UInt factorBits    = useScalingList ? ( 1 + IQUANT_SHIFT + SCALING_LIST_BITS ) : ( IQUANT_SHIFT + 1 );
+  const UInt inputBitDepth = std::min<UInt>( maxLog2TrDynamicRange + 1, ( ( sizeof( Intermediate_Int ) * 8 ) + rightShift ) - factorBits );
+  CheckTrQuant::xDeQuantBlock( qCoeff, coeff, numSamples, useScalingList ? scalingFactors : NULL, g_invQuantScales[qpRem], rightShift,
+                               -( 1 << ( inputBitDepth - 1 ) ), ( 1 << ( inputBitDepth - 1 ) ) - 1, coeffMinimum, coeffMaximum );
+  result.insert( result.end(), coeff, coeff + numSamples );
+}
+
+/// TComInterpolationFilter: horizontal and vertical luma and chroma filters
+static Void checkInterpolation( CheckResult& result )
+{
+  TComInterpolationFilter filter;
+
+  const Bool        isLuma   = getRandomFlag();
+  const ComponentID compID   = isLuma ? COMPONENT_Y : COMPONENT_Cb;
+  const Int         bitDepth = getRandomFlag() ? 8 : 10;
+  const Int         width    = getRandomBlockSize() >> ( isLuma ? 0 : 1 );
+  const Int         height   = getRandomBlockSize() >> ( isLuma ? 0 : 1 );
+  const Int         frac     = getRandom( 1, isLuma ? 3 : 7 );
+  const Int         margin   = 8;
+  const Int         stride   = MAX_CU_SIZE + 2 * margin;
+  vector<Pel> src( stride * stride );
+  vector<Pel> dst( stride * stride );
+  Pel* const  srcOrg = &src[margin * stride + margin];
+
+  const Bool isLast = getRandomFlag();
+  fillSamples( &src[0], stride, stride, stride, bitDepth );
+  filter.filterHor( compID, srcOrg, stride, &dst[0], stride, width, height, frac, isLast, CHROMA_420, bitDepth );
+  appendBlock( result, &dst[0], stride, width, height );
+
+  const Bool isFirst = getRandomFlag();
+  if( !isFirst )
+  {
+    fillIntermediate( &src[0], stride, stride, stride, bitDepth, isLuma );
+  }
+  filter.filterVer( compID, srcOrg, stride, &dst[0], stride, width, height, frac, isFirst, getRandomFlag(), CHROMA_420, bitDepth );
+  appendBlock( result, &dst[0], stride, width, height );
+}
+
+static Void fillPredictionYuv( TComYuv& yuv, Int width, Int height, Int bitDepth )
+{
+  for( UInt comp = 0; comp < yuv.getNumberValidComponents(); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    fillIntermediate( yuv.getAddr( compID ), yuv.getStride( compID ), width >> yuv.getComponentScaleX( compID ),
+                      height >> yuv.getComponentScaleY( compID ), bitDepth, isLuma( compID ) );
+  }
+}
+
+static Void appendYuv( CheckResult& result, const TComYuv& yuv, Int width, Int height )
+{
+  for( UInt comp = 0; comp < yuv.getNumberValidComponents(); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    appendBlock( result, yuv.getAddr( compID ), yuv.getStride( compID ), width >> yuv.getComponentScaleX( compID ), height >> yuv.getComponentScaleY( compID ) );
+  }
+}
+
+/// TComYuv::addAvg and TComWeightPrediction: bi-prediction averaging and explicit weighted prediction
+static Void checkBiPrediction( CheckResult& result )
+{
+  const Int width    = getRandomBlockSize();
+  const Int height   = getRandomBlockSize();
+  const Int bitDepth = getRandomFlag() ? 8 : 10;
+  BitDepths bitDepths;
+  for( UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++ )
+  {
+    bitDepths.recon[ch] = bitDepth;
+  }
+
+  TComYuv src0, src1, dst;
+  src0.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  src1.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  dst.create ( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420 );
+  fillPredictionYuv( src0, width, height, bitDepth );
+  fillPredictionYuv( src1, width, height, bitDepth );
+
+  dst.addAvg( &src0, &src1, 0, width, height, bitDepths );
+  appendYuv( result, dst, width, height );
+
+  WPScalingParam wp[NUM_REF_PIC_LIST_01][MAX_NUM_COMPONENT];
+  for( Int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    for( Int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+    {
+      WPScalingParam& param = wp[list][comp];
+      param.uiLog2WeightDenom = getRandom( 0, 7 );
+      param.iWeight           = getRandom( 0, 3 ) == 0 ? ( 1 << param.uiLog2WeightDenom ) : getRandom( -128, 127 );
+      param.iOffset           = getRandom( -128, 127 );
+      param.w                 = param.iWeight;
+      param.offset            = param.iOffset << ( bitDepth - 8 );
+      param.shift             = param.uiLog2WeightDenom;
+      param.round             = param.shift ? ( 1 << ( param.shift - 1 ) ) : 0;
+      param.o                 = param.offset;
+    }
+  }
+
+  TComWeightPrediction weightPrediction;
+  weightPrediction.addWeightBi( &src0, &src1, bitDepths, 0, width, height, wp[0], wp[1], &dst, getRandomFlag() );
+  appendYuv( result, dst, width, height );
+  weightPrediction.addWeightUni( &src0, bitDepths, 0, width, height, wp[0], &dst );
+  appendYuv( result, dst, width, height );
+
+  src0.destroy();
+  src1.destroy();
+  dst.destroy();
+}
+
+/// TComPrediction: angular, DC and planar intra prediction and the DC edge filter
+static Void checkIntraPrediction( CheckResult& result )
+{
+  CheckPrediction prediction;
+
+  const Int  bitDepth  = getRandomFlag() ? 8 : 10;
+  const Int  width     = 4 << getRandom( 0, 3 );
+  const Int  refStride = 2 * MAX_CU_SIZE + 1;
+  vector<Pel> ref( refStride * refStride );
+  Pel         dst[MAX_CU_SIZE * MAX_CU_SIZE];
+  fillSamples( &ref[0], refStride, refStride, refStride, bitDepth );
+  const Pel* const src = &ref[refStride + 1];
+
+  const Bool        isLumaBlock = getRandomFlag();
+  const ChannelType channelType = isLumaBlock ? CHANNEL_TYPE_LUMA : CHANNEL_TYPE_CHROMA;
+  const UInt        dirMode     = getRandom( DC_IDX, NUM_INTRA_MODE - 2 );
+  prediction.xPredIntraAng( bitDepth, src, refStride, dst, MAX_CU_SIZE, width, width, channelType, dirMode, getRandomFlag() );
+  appendBlock( result, dst, MAX_CU_SIZE, width, width );
+
+  fillSamples( dst, MAX_CU_SIZE, width, width, bitDepth );
+  prediction.xDCPredFiltering( src, refStride, dst, MAX_CU_SIZE, width, width, channelType );
+  appendBlock( result, dst, MAX_CU_SIZE, width, width );
+
+  // 4:2:2 chroma blocks are twice as high as wide
+  const Int height = ( getRandomFlag() || width == MAX_CU_SIZE / 2 ) ? width : 2 * width;
+  prediction.xPredIntraPlanar( src, refStride, dst, MAX_CU_SIZE, width, height );
+  appendBlock( result, dst, MAX_CU_SIZE, width, height );
+}
+
+/// TComLoopFilter: luma and chroma deblocking of a segment across a vertical or horizontal edge
+static Void checkDeblocking( CheckResult& result )
+{
+  CheckLoopFilter loopFilter;
+
+  const Int  bitDepth = getRandomFlag() ? 8 : 10;
+  const Int  scale    = 1 << ( bitDepth - 8 );
+  const Int  size     = 16;
+  const Bool vertical = getRandomFlag();
+  Pel        block[size * size];
+
+  // smooth sides with a step at the edge, so that all filter decisions are taken
+  fillSamples( block, size, size, size, bitDepth );
+  const Int step = getRandom( -8, 8 ) * scale;
+  for( Int y = 0; y < size; y++ )
+  {
+    for( Int x = 0; x < size; x++ )
+    {
+      if( ( vertical ? x : y ) >= size / 2 )
+      {
+        block[y * size + x] = Pel( Clip3( 0, ( 1 << bitDepth ) - 1, block[y * size + x] + step ) );
+      }
+    }
+  }
+
+  const Int  offset     = vertical ? 1 : size;
+  const Int  lineStep   = vertical ? size : 1;
+  Pel* const edge       = vertical ? &block[4 * size + size / 2] : &block[( size / 2 ) * size + 4];
+  const Int  tc         = CheckLoopFilter::getTc( getRandom( 0, MAX_QP + 2 ) ) * scale;
+  const Int  beta       = CheckLoopFilter::getBeta( getRandom( 0, MAX_QP ) ) * scale;
+  const Bool partPNoFilter = getRandom( 0, 7 ) == 0;
+  const Bool partQNoFilter = getRandom( 0, 7 ) == 0;
+
+  if( getRandomFlag() )
+  {
+    loopFilter.xEdgeFilterLumaSegment( edge, offset, lineStep, beta, tc, ( beta + ( beta >> 1 ) ) >> 3, tc * 10, partPNoFilter, partQNoFilter, bitDepth );
+  }
+  else
+  {
+    loopFilter.xEdgeFilterChromaSegment( edge, offset, lineStep, 1 << getRandom( 0, 2 ), tc, partPNoFilter, partQNoFilter, bitDepth );
+  }
+  appendBlock( result, block, size, size, size );
+}
+
+/// TComSampleAdaptiveOffset::offsetBlock and TEncSampleAdaptiveOffset::getBlkStats for all SAO types
+static Void checkSampleAdaptiveOffset( CheckResult& result )
+{
+  CheckSampleAdaptiveOffset sao;
+  const Bool isPreDBFSamplesUsed = getRandomFlag();
+  sao.create( 2 * MAX_CU_SIZE, 2 * MAX_CU_SIZE, CHROMA_420, MAX_CU_SIZE, MAX_CU_SIZE, MAX_CU_DEPTH, 0, 0 );
+  sao.createEncData( isPreDBFSamplesUsed );
+
+  const Bool        isLumaBlock = getRandomFlag();
+  const ComponentID compID      = isLumaBlock ? COMPONENT_Y : COMPONENT_Cb;
+  const Int         bitDepth    = getRandomFlag() ? 8 : 10;
+  const Int         maxSize     = isLumaBlock ? MAX_CU_SIZE : MAX_CU_SIZE / 2;
+  const Int         width       = getRandom( 1, maxSize / 4 ) * 4;
+  const Int         height      = getRandom( 1, maxSize / 4 ) * 4;
+  const Int         margin      = 8;
+  const Int         stride      = MAX_CU_SIZE + 2 * margin;
+  vector<Pel> src( stride * stride );
+  vector<Pel> org( stride * stride );
+  fillSamples( &src[0], stride, stride, stride, bitDepth );
+  fillSamples( &org[0], stride, stride, stride, bitDepth );
+  vector<Pel> res( src );
+  Pel* const  srcBlk = &src[margin * stride + margin];
+  Pel* const  orgBlk = &org[margin * stride + margin];
+  Pel* const  resBlk = &res[margin * stride + margin];
+
+  Bool avail[8];
+  for( Int i = 0; i < 8; i++ )
+  {
+    avail[i] = getRandom( 0, 3 ) != 0;
+  }
+  // as in a picture, only CTUs of full width (height) have neighbours to the right (below)
+  if( width < maxSize )
+  {
+    avail[1] = avail[5] = avail[7] = false;
+  }
+  if( height < maxSize )
+  {
+    avail[3] = avail[6] = avail[7] = false;
+  }
+
+  const Int typeIdx = getRandom( SAO_TYPE_START_EO, SAO_TYPE_BO );
+  const Int maxOffset = ( 1 << ( std::min( bitDepth, 10 ) - 5 ) ) - 1;
+  Int offsets[MAX_NUM_SAO_CLASSES];
+  for( Int i = 0; i < MAX_NUM_SAO_CLASSES; i++ )
+  {
+    offsets[i] = getRandom( -maxOffset, maxOffset );
+  }
+  if( typeIdx != SAO_TYPE_BO )
+  {
+    offsets[SAO_CLASS_EO_PLAIN] = 0;
+  }
+  sao.offsetBlock( bitDepth, typeIdx, offsets, srcBlk, resBlk, stride, stride, width, height,
+                   avail[0], avail[1], avail[2], avail[3], avail[4], avail[5], avail[6], avail[7] );
+  appendBlock( result, &res[0], stride, stride, stride );
+
+  SAOStatData stats[NUM_SAO_NEW_TYPES];
+  sao.getBlkStats( compID, bitDepth, stats, srcBlk, orgBlk, stride, stride, width, height,
+                   avail[0], avail[1], avail[2], avail[3], avail[4], avail[5], isPreDBFSamplesUsed && getRandomFlag() );
+  for( Int type = 0; type < NUM_SAO_NEW_TYPES; type++ )
+  {
+    result.insert( result.end(), stats[type].diff,  stats[type].diff  + MAX_NUM_SAO_CLASSES );
+    result.insert( result.end(), stats[type].count, stats[type].count + MAX_NUM_SAO_CLASSES );
+  }
+
+  sao.destroyEncData();
+  sao.destroy();
+}
+
+/// TComByteScan: searches for zero byte pairs and start codes, emulation prevention
+static Void checkByteScan( CheckResult& result )
+{
+  const Int       size        = getRandom( 0, 300 );
+  const Int       zeroPercent = getRandom( 0, 100 );
+  vector<uint8_t> data( size + 1 );
+  for( Int i = 0; i < size; i++ )
+  {
+    data[i] = getRandom( 0, 99 ) < zeroPercent ? 0 : uint8_t( getRandom( 0, 3 ) == 0 ? getRandom( 1, 3 ) : getRandom( 1, 255 ) );
+  }
+  const Int start = getRandom( 0, size );
+
+  result.push_back( findZeroBytePair( &data[0], start, size ) );
+  result.push_back( findStartCodePrefix( &data[0], start, size ) );
+
+  vector<uint8_t> ebsp( 2 * size + 1 );
+  const std::size_t ebspSize = insertEmulationPreventionBytes( &data[0], size, &ebsp[0] );
+  result.push_back( ebspSize );
+  result.insert( result.end(), ebsp.begin(), ebsp.begin() + ebspSize );
+}
+
+static std::string s_temporaryFile;
+
+/// TVideoIOYuv: conversion of the file formats and bit depth scaling, through a file written and read again
+static Void checkVideoIO( CheckResult& result )
+{
+  const Int width  = getRandom( 1, 17 ) * 8;
+  const Int height = getRandom( 1, 8 ) * 8;
+
+  // 8 bit file with 10 bit internal samples, or 16 bit file with 8 or 10 bit internal samples
+  Int fileBitDepths[MAX_NUM_CHANNEL_TYPE];
+  Int internalBitDepths[MAX_NUM_CHANNEL_TYPE];
+  const Int mode = getRandom( 0, 2 );
+  for( UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++ )
+  {
+    fileBitDepths[ch]     = mode == 0 ? 8 : 10;
+    internalBitDepths[ch] = mode == 1 ? 8 : 10;
+  }
+
+  TComPicYuv picture;
+  TComPicYuv trueOrg;
+  picture.createWithoutCUInfo( width, height, CHROMA_420 );
+  trueOrg.createWithoutCUInfo( width, height, CHROMA_420 );
+  for( UInt comp = 0; comp < picture.getNumberValidComponents(); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    fillSamples( picture.getAddr( compID ), picture.getStride( compID ), picture.getWidth( compID ), picture.getHeight( compID ), internalBitDepths[toChannelType( compID )] );
+  }
+
+  TVideoIOYuv output;
+  output.open( s_temporaryFile, true, fileBitDepths, fileBitDepths, internalBitDepths );
+  output.write( &picture, IPCOLOURSPACE_UNCHANGED );
+  output.close();
+
+  ifstream file( s_temporaryFile.c_str(), ifstream::binary );
+  result.insert( result.end(), istreambuf_iterator<char>( file ), istreambuf_iterator<char>() );
+  file.close();
+
+  Int pad[2] = { 0, 0 };
+  TVideoIOYuv input;
+  input.open( s_temporaryFile, false, fileBitDepths, fileBitDepths, internalBitDepths );
+  input.read( &picture, &trueOrg, IPCOLOURSPACE_UNCHANGED, pad );
+  input.close();
+  for( UInt comp = 0; comp < picture.getNumberValidComponents(); comp++ )
+  {
+    const ComponentID compID = ComponentID( comp );
+    appendBlock( result, picture.getAddr( compID ), picture.getStride( compID ), picture.getWidth( compID ), picture.getHeight( compID ) );
+  }
+
+  picture.destroy();
+  trueOrg.destroy();
+}
+
+// ====================================================================================================================
+// Main
+// ====================================================================================================================
+
+typedef Void (*CheckFunction)( CheckResult& result );
+
+/** runs numTests random tests of one check at each instruction set up to maxLevel and compares the outputs with
+ *  those of the C version
+ */
+static Bool runCheck( const char* name, CheckFunction check, SIMDLevel maxLevel, UInt seed, UInt numTests )
+{
+  for( UInt test = 0; test < numTests; test++ )
+  {
+    CheckResult reference;
+    seedRandom( seed + test );
+    setSIMDLevelLimit( SIMD_NONE );
+    check( reference );
+
+    for( Int level = SIMD_SSE2; level <= maxLevel; level++ )
+    {
+      CheckResult result;
+      seedRandom( seed + test );
+      setSIMDLevelLimit( SIMDLevel( level ) );
+      check( result );
+
+      if( result != reference )
+      {
+        size_t pos = 0;
+        while( pos < result.size() && pos < reference.size() && result[pos] == reference[pos] )
+        {
+          pos++;
+        }
+        printf( "%-24s FAILED at SIMD level %d, seed %u: output %d is %lld instead of %lld\n", name, level, seed + test, Int( pos ),
+                pos < result.size() ? (long long)result[pos] : -1LL, pos < reference.size() ? (long long)reference[pos] : -1LL );
+        return false;
+      }
+    }
+  }
+  printf( "%-24s OK\n", name );
+  return true;
+}
+
+Int main( Int argc, const char** argv )
+{
+  Bool do_help;
+  UInt seed;
+  UInt numTests;
+
+  po::Options opts;
+  opts.addOptions()
+  ("help",          do_help,         false,                            "this help text")
+  ("Seed",          seed,            1u,                               "seed of the first test")
+  ("Iterations",    numTests,        1000u,                            "number of random tests of each kernel")
+  ("TemporaryFile", s_temporaryFile, string("checkSIMDKernels.yuv"),   "file written and read by the check of the YUV file input and output, removed at the end")
+  ;
+
+  po::setDefaults( opts );
+  po::scanArgv( opts, argc, argv );
+
+  if( do_help )
+  {
+    po::doHelp( cout, opts );
+    return EXIT_SUCCESS;
+  }
+
+  const SIMDLevel maxLevel = getSIMDLevel();
+  printf( "SIMD level supported by the CPU: %d\n", Int( maxLevel ) );
+  if( maxLevel < SIMD_AVX2 )
+  {
+    printf( "The AVX2 kernels cannot be checked on this CPU\n" );
+  }
+
+  initROM();
+
+  Bool passed = true;
+  passed &= runCheck( "Distortion",              checkDistortion,           maxLevel, seed, numTests );
+  passed &= runCheck( "Transform",               checkTransform,            maxLevel, seed, numTests );
+  passed &= runCheck( "Quantisation",            checkQuantisation,         maxLevel, seed, numTests );
+  passed &= runCheck( "Interpolation",           checkInterpolation,        maxLevel, seed, numTests );
+  passed &= runCheck( "BiPrediction",            checkBiPrediction,         maxLevel, seed, numTests );
+  passed &= runCheck( "IntraPrediction",         checkIntraPrediction,      maxLevel, seed, numTests );
+  passed &= runCheck( "Deblocking",              checkDeblocking,           maxLevel, seed, numTests );
+  passed &= runCheck( "SampleAdaptiveOffset",    checkSampleAdaptiveOffset, maxLevel, seed, numTests );
+  passed &= runCheck( "ByteScan",                checkByteScan,             maxLevel, seed, numTests );
+  passed &= runCheck( "VideoIO",                 checkVideoIO,              maxLevel, seed, numTests );
+
+  remove( s_temporaryFile.c_str() );
+  destroyROM();
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
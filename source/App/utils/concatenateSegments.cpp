@@ -0,0 +1,221 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     concatenateSegments.cpp
+    \brief    Concatenates IDR-aligned segment bitstreams produced by segment-parallel encoding
+
+    Every segment has to start with an IDR picture (TAppEncoder --NumSegments/--SegmentIndex with
+    DecodingRefreshType 2). As the picture order count is reset at each IDR picture, the segments can be
+    appended without rewriting any slice data; parameter sets that are identical to the ones already
+    active in the output are dropped.
+*/
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "TLibDecoder/AnnexBread.h"
+#include "TLibDecoder/NALread.h"
+
+using namespace std;
+
+static const uint8_t startCodePrefix[] = { 0, 0, 0, 1 };
+
+static UInt readUvlc(TComInputBitstream& bs)
+{
+  UInt leadingZeroBits = 0;
+  while (bs.read(1) == 0)
+  {
+    leadingZeroBits++;
+  }
+  return leadingZeroBits > 0 ? ((1u << leadingZeroBits) - 1 + bs.read(leadingZeroBits)) : 0;
+}
+
+static Void skipProfileTierLevel(TComInputBitstream& bs, UInt maxNumSubLayersMinus1)
+{
+  bs.read(32); bs.read(32); bs.read(24);   // general profile/tier/level: 88 bits ...
+  bs.read(8);                              // ... followed by general_level_idc
+
+  vector<UInt> subLayerProfilePresent(maxNumSubLayersMinus1);
+  vector<UInt> subLayerLevelPresent(maxNumSubLayersMinus1);
+  for (UInt i = 0; i < maxNumSubLayersMinus1; i++)
+  {
+    subLayerProfilePresent[i] = bs.read(1);
+    subLayerLevelPresent[i]   = bs.read(1);
+  }
+  if (maxNumSubLayersMinus1 > 0)
+  {
+    for (UInt i = maxNumSubLayersMinus1; i < 8; i++)
+    {
+      bs.read(2);                          // reserved_zero_2bits
+    }
+  }
+  for (UInt i = 0; i < maxNumSubLayersMinus1; i++)
+  {
+    if (subLayerProfilePresent[i])
+    {
+      bs.read(32); bs.read(32); bs.read(24);
+    }
+    if (subLayerLevelPresent[i])
+    {
+      bs.read(8);
+    }
+  }
+}
+
+/// returns the id of a VPS, SPS or PPS NAL unit
+static Int getParameterSetId(const vector<uint8_t>& nalUnit)
+{
+  InputNALUnit nalu;
+  nalu.getBitstream().getFifo() = nalUnit;
+  read(nalu);
+  TComInputBitstream& bs = nalu.getBitstream();
+
+  switch (nalu.m_nalUnitType)
+  {
+  case NAL_UNIT_VPS:
+    return bs.read(4);
+  case NAL_UNIT_SPS:
+    {
+      bs.read(4);                                  // sps_video_parameter_set_id
+      const UInt maxSubLayersMinus1 = bs.read(3);
+      bs.read(1);                                  // sps_temporal_id_nesting_flag
+      skipProfileTierLevel(bs, maxSubLayersMinus1);
+      return readUvlc(bs);
+    }
+  case NAL_UNIT_PPS:
+    return readUvlc(bs);
+  default:
+    return -1;
+  }
+}
+
+static Bool isParameterSet(NalUnitType nalUnitType)
+{
+  return nalUnitType == NAL_UNIT_VPS || nalUnitType == NAL_UNIT_SPS || nalUnitType == NAL_UNIT_PPS;
+}
+
+static Bool isSlice(NalUnitType nalUnitType)
+{
+  return nalUnitType <= NAL_UNIT_RESERVED_VCL31;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    cerr << "Usage: " << argv[0] << " output.bin segment0.bin [segment1.bin ...]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  ofstream out(argv[1], ofstream::out | ofstream::binary);
+  if (!out)
+  {
+    cerr << "failed to open bitstream file `" << argv[1] << "' for writing" << endl;
+    return EXIT_FAILURE;
+  }
+
+  map<pair<Int, Int>, vector<uint8_t> > activeParameterSets;   ///< last written parameter set for each (type, id)
+  UInt numDroppedParameterSets = 0;
+
+  for (Int segment = 2; segment < argc; segment++)
+  {
+    ifstream in(argv[segment], ifstream::in | ifstream::binary);
+    if (!in)
+    {
+      cerr << "failed to open bitstream file `" << argv[segment] << "' for reading" << endl;
+      return EXIT_FAILURE;
+    }
+    InputByteStream bytestream(in);
+    Bool firstSlice = true;
+    UInt numNALUnits = 0;
+
+    while (!!in)
+    {
+      AnnexBStats stats = AnnexBStats();
+      vector<uint8_t> nalUnit;
+      byteStreamNALUnit(bytestream, nalUnit, stats);
+      if (nalUnit.empty())
+      {
+        continue;
+      }
+
+      const NalUnitType nalUnitType = NalUnitType((nalUnit[0] >> 1) & 0x3f);
+      if (isSlice(nalUnitType) && firstSlice)
+      {
+        if (nalUnitType != NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalUnitType != NAL_UNIT_CODED_SLICE_IDR_N_LP)
+        {
+          cerr << "segment `" << argv[segment] << "' does not start with an IDR picture" << endl;
+          return EXIT_FAILURE;
+        }
+        firstSlice = false;
+      }
+
+      if (isParameterSet(nalUnitType))
+      {
+        vector<uint8_t>& active = activeParameterSets[make_pair(Int(nalUnitType), getParameterSetId(nalUnit))];
+        if (active == nalUnit)
+        {
+          numDroppedParameterSets++;
+          continue;
+        }
+        active = nalUnit;
+      }
+
+      if (stats.m_numZeroByteBytes)
+      {
+        out.write(reinterpret_cast<const char*>(startCodePrefix), 4);
+      }
+      else
+      {
+        out.write(reinterpret_cast<const char*>(startCodePrefix + 1), 3);
+      }
+      out.write(reinterpret_cast<const char*>(&nalUnit[0]), nalUnit.size());
+      numNALUnits++;
+    }
+
+    if (firstSlice)
+    {
+      cerr << "segment `" << argv[segment] << "' does not contain any slice" << endl;
+      return EXIT_FAILURE;
+    }
+    cout << "Segment " << segment - 2 << ": " << argv[segment] << " (" << numNALUnits << " NAL units)" << endl;
+  }
+
+  cout << "Dropped " << numDroppedParameterSets << " duplicated parameter sets" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#! /bin/sh
+
+# The copyright in this software is being made available under the BSD
+# License, included below. This software may be subject to other third party
+# and contributor rights, including patent rights, and no such rights are
+# granted under this license.  
+#
+# Copyright (c) 2010-2017, ITU/ISO/IEC
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#  * Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+#    be used to endorse or promote products derived from this software without
+#    specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+# Segment-parallel encoding: splits the input into IDR-aligned segments, encodes each segment in its own
+# worker process and concatenates the resulting bitstreams with concatenateSegments.
+#
+# Usage: encodeSegments.sh encoder concatenateSegments numWorkers output.bin [encoder arguments]
+#
+# The encoder arguments must specify FramesToBeEncoded, a positive IntraPeriod and DecodingRefreshType 2.
+# The segment bitstreams and logs are written next to output.bin.
+
+if [ $# -lt 4 ]; then
+  echo "Usage: $0 encoder concatenateSegments numWorkers output.bin [encoder arguments]" >&2
+  exit 1
+fi
+
+ENCODER=$1
+CONCATENATE=$2
+NUM_WORKERS=$3
+OUTPUT=$4
+shift 4
+
+PIDS=""
+SEGMENTS=""
+INDEX=0
+while [ $INDEX -lt $NUM_WORKERS ]; do
+  SEGMENT="${OUTPUT}.segment${INDEX}"
+  rm -f "${SEGMENT}.bin"
+  "$ENCODER" "$@" --NumSegments=$NUM_WORKERS --SegmentIndex=$INDEX -b "${SEGMENT}.bin" > "${SEGMENT}.log" 2>&1 &
+  PIDS="$PIDS $!"
+  INDEX=`expr $INDEX + 1`
+done
+
+STATUS=0
+for PID in $PIDS; do
+  wait $PID || STATUS=1
+done
+if [ $STATUS -ne 0 ]; then
+  echo "At least one segment failed to encode, see ${OUTPUT}.segment*.log" >&2
+  exit 1
+fi
+
+# segments beyond the last intra period are empty and write no bitstream
+INDEX=0
+while [ $INDEX -lt $NUM_WORKERS ]; do
+  SEGMENT="${OUTPUT}.segment${INDEX}"
+  if [ -f "${SEGMENT}.bin" ]; then
+    SEGMENTS="$SEGMENTS ${SEGMENT}.bin"
+  fi
+  INDEX=`expr $INDEX + 1`
+done
+
+"$CONCATENATE" "$OUTPUT" $SEGMENTS
@@ -0,0 +1,92 @@
+#! /bin/sh
+
+# The copyright in this software is being made available under the BSD
+# License, included below. This software may be subject to other third party
+# and contributor rights, including patent rights, and no such rights are
+# granted under this license.  
+#
+# Copyright (c) 2010-2017, ITU/ISO/IEC
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#  * Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+#    be used to endorse or promote products derived from this software without
+#    specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+# BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+# THE POSSIBILITY OF SUCH DAMAGE.
+
+# Spatially distributed encoding: splits the source picture into CTU-aligned tile columns, encodes each column
+# as a sub-picture in its own worker process and merges the resulting bitstreams into one bitstream with one
+# tile per column using the merge mode of the extractor.
+#
+# Usage: encodeSubPictures.sh encoder extractor numWorkers sourceWidth ctuSize output.bin [encoder arguments]
+#
+# The encoder arguments must not enable tiles, slices or wavefronts. The sub-picture bitstreams and logs are
+# written next to output.bin.
+
+if [ $# -lt 6 ]; then
+  echo "Usage: $0 encoder extractor numWorkers sourceWidth ctuSize output.bin [encoder arguments]" >&2
+  exit 1
+fi
+
+ENCODER=$1
+EXTRACTOR=$2
+NUM_WORKERS=$3
+SOURCE_WIDTH=$4
+CTU_SIZE=$5
+OUTPUT=$6
+shift 6
+
+WIDTH_IN_CTUS=`expr \( $SOURCE_WIDTH + $CTU_SIZE - 1 \) / $CTU_SIZE`
+if [ $NUM_WORKERS -gt $WIDTH_IN_CTUS ]; then
+  echo "The picture is only $WIDTH_IN_CTUS CTUs wide" >&2
+  exit 1
+fi
+
+PIDS=""
+SUB_PICTURES=""
+INDEX=0
+while [ $INDEX -lt $NUM_WORKERS ]; do
+  # same column boundaries as uniformly spaced tiles
+  OFFSET=`expr $INDEX \* $WIDTH_IN_CTUS / $NUM_WORKERS \* $CTU_SIZE`
+  NEXT_INDEX=`expr $INDEX + 1`
+  if [ $NEXT_INDEX -eq $NUM_WORKERS ]; then
+    END=$SOURCE_WIDTH
+  else
+    END=`expr $NEXT_INDEX \* $WIDTH_IN_CTUS / $NUM_WORKERS \* $CTU_SIZE`
+  fi
+  SUB_PICTURE="${OUTPUT}.column${INDEX}"
+  "$ENCODER" "$@" --SourceWidth=$SOURCE_WIDTH --MaxCUSize=$CTU_SIZE --SubPictureOffsetX=$OFFSET --SubPictureWidth=`expr $END - $OFFSET` \
+    --SEIMCTSExtractionInfoSets=0 -b "${SUB_PICTURE}.bin" > "${SUB_PICTURE}.log" 2>&1 &
+  PIDS="$PIDS $!"
+  SUB_PICTURES="$SUB_PICTURES ${SUB_PICTURE}.bin"
+  INDEX=$NEXT_INDEX
+done
+
+STATUS=0
+for PID in $PIDS; do
+  wait $PID || STATUS=1
+done
+if [ $STATUS -ne 0 ]; then
+  echo "At least one sub-picture failed to encode, see ${OUTPUT}.column*.log" >&2
+  exit 1
+fi
+
+"$EXTRACTOR" --MergeBitstreamFiles="$SUB_PICTURES" --MergeTileColumns=$NUM_WORKERS -o "$OUTPUT"
@@ -0,0 +1,161 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComByteScan.cpp
+    \brief    byte pattern searches used to pack and unpack NAL units
+*/
+
+#include <string.h>
+#include "TComByteScan.h"
+
+#if VECTOR_CODING__AVX2_DISPATCH
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+#if VECTOR_CODING__AVX2_DISPATCH
+static inline UInt xCountTrailingZeros( UInt mask )
+{
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanForward( &idx, mask );
+  return UInt( idx );
+#else
+  return UInt( __builtin_ctz( mask ) );
+#endif
+}
+
+/** AVX2 version of findZeroBytePair: tests 32 candidate positions at a time by combining each byte with its successor
+ */
+SIMD_TARGET_AVX2 static std::size_t simdFindZeroBytePairAVX2( const uint8_t* data, std::size_t start, std::size_t size )
+{
+  std::size_t i = start;
+  for( ; i + 33 <= size; i += 32 )
+  {
+    const __m256i mmCur  = _mm256_loadu_si256( ( const __m256i* )( data + i ) );
+    const __m256i mmNext = _mm256_loadu_si256( ( const __m256i* )( data + i + 1 ) );
+    const UInt    mask   = UInt( _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_or_si256( mmCur, mmNext ), _mm256_setzero_si256() ) ) );
+    if( mask )
+    {
+      return i + xCountTrailingZeros( mask );
+    }
+  }
+  for( ; i + 1 < size; i++ )
+  {
+    if( data[i] == 0 && data[i + 1] == 0 )
+    {
+      return i;
+    }
+  }
+  return size;
+}
+#endif
+
+std::size_t findZeroBytePair( const uint8_t* data, std::size_t start, std::size_t size )
+{
+#if VECTOR_CODING__AVX2_DISPATCH
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    return simdFindZeroBytePairAVX2( data, start, size );
+  }
+#endif
+  for( std::size_t i = start; i + 1 < size; i++ )
+  {
+    if( data[i + 1] != 0 )
+    {
+      i++; // neither pair containing data[i+1] can match
+    }
+    else if( data[i] == 0 )
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+std::size_t findStartCodePrefix( const uint8_t* data, std::size_t start, std::size_t size )
+{
+  for( std::size_t i = findZeroBytePair( data, start, size ); i + 2 < size; i = findZeroBytePair( data, i + 1, size ) )
+  {
+    if( data[i + 2] <= 2 )
+    {
+      return i;
+    }
+  }
+  return size;
+}
+
+std::size_t insertEmulationPreventionBytes( const uint8_t* rbsp, std::size_t size, uint8_t* ebsp )
+{
+  static const uint8_t emulation_prevention_three_byte = 3;
+
+  std::size_t readPos  = 0;
+  std::size_t writePos = 0;
+  for( ;; )
+  {
+    // only a pair of zero bytes followed by a byte <= 3 needs an emulation_prevention_three_byte
+    const std::size_t pairPos = findZeroBytePair( rbsp, readPos, size );
+    if( pairPos + 2 >= size )
+    {
+      memcpy( ebsp + writePos, rbsp + readPos, size - readPos );
+      writePos += size - readPos;
+      break;
+    }
+    memcpy( ebsp + writePos, rbsp + readPos, pairPos + 2 - readPos );
+    writePos += pairPos + 2 - readPos;
+    readPos   = pairPos + 2;
+    if( rbsp[readPos] <= 3 )
+    {
+      ebsp[writePos++] = emulation_prevention_three_byte;
+    }
+  }
+
+  /* 7.4.1.1
+   * ... when the last byte of the RBSP data is equal to 0x00 (which can
+   * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
+   * to 0x03 is appended to the end of the data.
+   */
+  if( size > 0 && rbsp[size - 1] == 0 )
+  {
+    ebsp[writePos++] = emulation_prevention_three_byte;
+  }
+  return writePos;
+}
+
+//! \}
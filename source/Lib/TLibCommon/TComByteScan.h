@@ -0,0 +1,62 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComByteScan.h
+    \brief    byte pattern searches used to pack and unpack NAL units
+*/
+
+#ifndef __TCOMBYTESCAN__
+#define __TCOMBYTESCAN__
+
+#include <stdint.h>
+#include <cstddef>
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+/// position of the first byte-aligned pair 0x00 0x00 in data[start..size), or size if there is none
+std::size_t findZeroBytePair( const uint8_t* data, std::size_t start, std::size_t size );
+
+/// position of the first byte-aligned three-byte sequence 0x000000, 0x000001 or 0x000002 in data[start..size), or size if there is none
+std::size_t findStartCodePrefix( const uint8_t* data, std::size_t start, std::size_t size );
+
+/** copies the RBSP bytes rbsp[0..size) to ebsp and inserts the emulation_prevention_three_byte's required by 7.4.2,
+ *  including the final one when the RBSP ends with 0x00. ebsp must hold at least 2*size+1 bytes.
+ * \returns the number of bytes written to ebsp
+ */
+std::size_t insertEmulationPreventionBytes( const uint8_t* rbsp, std::size_t size, uint8_t* ebsp );
+
+//! \}
+
+#endif // __TCOMBYTESCAN__
@@ -0,0 +1,107 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCPUFeatures.cpp
+    \brief    run-time detection of the SIMD instruction sets supported by the CPU
+*/
+
+#include "TComCPUFeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+static SIMDLevel s_simdLevelLimit = SIMD_AVX2;
+
+static SIMDLevel xDetectSIMDLevel()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if( __builtin_cpu_supports( "avx2" ) )
+  {
+    return SIMD_AVX2;
+  }
+  if( __builtin_cpu_supports( "sse4.1" ) )
+  {
+    return SIMD_SSE41;
+  }
+  if( __builtin_cpu_supports( "sse2" ) )
+  {
+    return SIMD_SSE2;
+  }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  Int regs[4];
+  __cpuid( regs, 0 );
+  const Int maxLeaf = regs[0];
+  __cpuid( regs, 1 );
+  const Bool bSSE2   = ( regs[3] & ( 1 << 26 ) ) != 0;
+  const Bool bSSE41  = ( regs[2] & ( 1 << 19 ) ) != 0;
+  // AVX needs OS support for saving the YMM registers
+  const Bool bOSAVX  = ( regs[2] & ( 1 << 27 ) ) != 0 && ( regs[2] & ( 1 << 28 ) ) != 0 && ( _xgetbv( 0 ) & 0x6 ) == 0x6;
+  Bool bAVX2 = false;
+  if( bOSAVX && maxLeaf >= 7 )
+  {
+    __cpuidex( regs, 7, 0 );
+    bAVX2 = ( regs[1] & ( 1 << 5 ) ) != 0;
+  }
+  if( bAVX2 )
+  {
+    return SIMD_AVX2;
+  }
+  if( bSSE41 )
+  {
+    return SIMD_SSE41;
+  }
+  if( bSSE2 )
+  {
+    return SIMD_SSE2;
+  }
+#endif
+  return SIMD_NONE;
+}
+
+SIMDLevel getSIMDLevel()
+{
+  static const SIMDLevel detectedLevel = xDetectSIMDLevel();
+  return detectedLevel < s_simdLevelLimit ? detectedLevel : s_simdLevelLimit;
+}
+
+Void setSIMDLevelLimit( SIMDLevel level )
+{
+  s_simdLevelLimit = level;
+}
+
+//! \}
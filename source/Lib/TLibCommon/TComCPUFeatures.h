@@ -0,0 +1,72 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCPUFeatures.h
+    \brief    run-time detection of the SIMD instruction sets supported by the CPU
+*/
+
+#ifndef __TCOMCPUFEATURES__
+#define __TCOMCPUFEATURES__
+
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+/// SIMD instruction sets, in increasing order of capability
+enum SIMDLevel
+{
+  SIMD_NONE  = 0,
+  SIMD_SSE2  = 1,
+  SIMD_SSE41 = 2,
+  SIMD_AVX2  = 3
+};
+
+#if VECTOR_CODING__AVX2_DISPATCH
+#if defined(__GNUC__)
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))   ///< compile a function for AVX2 without enabling AVX2 for the whole file
+#else
+#define SIMD_TARGET_AVX2
+#endif
+#endif
+
+/// highest instruction set supported by the CPU and the OS, limited by setSIMDLevelLimit()
+SIMDLevel getSIMDLevel();
+
+/// limit the instruction set returned by getSIMDLevel(), e.g. to compare the kernels of different levels.
+/// Only affects the kernels selected after the call.
+Void      setSIMDLevelLimit( SIMDLevel level );
+
+//! \}
+
+#endif // __TCOMCPUFEATURES__
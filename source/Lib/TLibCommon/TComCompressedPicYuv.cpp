@@ -0,0 +1,372 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCompressedPicYuv.cpp
+    \brief    lossless compressed storage of a picture buffer
+*/
+
+#include <assert.h>
+#include "TComCompressedPicYuv.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+static const Int MAX_PREFIX_LENGTH = 24;   ///< longer Golomb-Rice prefixes are replaced by an escape and the raw value
+static const Int RESET_COUNT       = 64;   ///< the statistics of the Rice parameter are halved after this many values
+
+// ====================================================================================================================
+// Bit writer and reader
+// ====================================================================================================================
+
+class TComCompressedPicYuvWriter
+{
+private:
+  std::vector<UChar> &m_data;
+  UInt64              m_bits;
+  Int                 m_numBits;
+
+public:
+  TComCompressedPicYuvWriter( std::vector<UChar> &data ) : m_data( data ), m_bits( 0 ), m_numBits( 0 ) {}
+
+  Void write( const UInt value, const Int numBits )
+  {
+    m_bits     = ( m_bits << numBits ) | value;
+    m_numBits += numBits;
+    while( m_numBits >= 8 )
+    {
+      m_numBits -= 8;
+      m_data.push_back( UChar( m_bits >> m_numBits ) );
+    }
+  }
+
+  Void writeOnes( Int num )
+  {
+    for( ; num >= 16; num -= 16 )
+    {
+      write( 0xffff, 16 );
+    }
+    write( ( 1u << num ) - 1, num );
+  }
+
+  Void flush()
+  {
+    if( m_numBits > 0 )
+    {
+      m_data.push_back( UChar( m_bits << ( 8 - m_numBits ) ) );
+    }
+    m_bits    = 0;
+    m_numBits = 0;
+  }
+};
+
+class TComCompressedPicYuvReader
+{
+private:
+  const UChar *m_pData;
+  UInt64       m_bits;
+  Int          m_numBits;
+
+  Void xFill( const Int numBits )
+  {
+    while( m_numBits < numBits )
+    {
+      m_bits     = ( m_bits << 8 ) | *m_pData++;
+      m_numBits += 8;
+    }
+  }
+
+public:
+  TComCompressedPicYuvReader( const UChar *pData ) : m_pData( pData ), m_bits( 0 ), m_numBits( 0 ) {}
+
+  UInt read( const Int numBits )
+  {
+    xFill( numBits );
+    m_numBits -= numBits;
+    return UInt( m_bits >> m_numBits ) & ( ( 1u << numBits ) - 1 );
+  }
+
+  Int readOnes( const Int maxNum )
+  {
+    Int num = 0;
+    while( num < maxNum && read( 1 ) )
+    {
+      num++;
+    }
+    return num;
+  }
+};
+
+// ====================================================================================================================
+// Prediction and parameter adaptation, shared by the coding and the decoding
+// ====================================================================================================================
+
+/// median edge detector of LOCO-I, a is the left, b the above and c the above-left sample
+static inline Int predictSample( const Int a, const Int b, const Int c )
+{
+  if( c >= std::max( a, b ) )
+  {
+    return std::min( a, b );
+  }
+  if( c <= std::min( a, b ) )
+  {
+    return std::max( a, b );
+  }
+  return a + b - c;
+}
+
+/// prediction of the sample at (x,y) of a block, from the samples of the block only
+static inline Int predictBlockSample( const Pel *p, const Int stride, const Int x, const Int y, const Int midValue )
+{
+  if( y == 0 )
+  {
+    return x == 0 ? midValue : p[-1];
+  }
+  if( x == 0 )
+  {
+    return p[-stride];
+  }
+  return predictSample( p[-1], p[-stride], p[-stride-1] );
+}
+
+/// adaptive Golomb-Rice parameter, from the sum of the coded values and their number
+class TComRiceParameter
+{
+private:
+  UInt m_sum;
+  UInt m_count;
+
+public:
+  TComRiceParameter( const Int bitDepth ) : m_sum( std::max( 2, ( ( 1 << bitDepth ) + 32 ) >> 6 ) ), m_count( 1 ) {}
+
+  Int get() const
+  {
+    Int k = 0;
+    while( ( m_count << k ) < m_sum )
+    {
+      k++;
+    }
+    return k;
+  }
+
+  Void update( const UInt value )
+  {
+    m_sum += value;
+    if( ++m_count == RESET_COUNT )
+    {
+      m_sum   >>= 1;
+      m_count >>= 1;
+    }
+  }
+};
+
+// ====================================================================================================================
+// Class member functions
+// ====================================================================================================================
+
+TComCompressedPicYuv::TComCompressedPicYuv()
+: m_picWidth        ( 0 )
+, m_picHeight       ( 0 )
+, m_chromaFormatIDC ( CHROMA_420 )
+, m_ctuWidth        ( 0 )
+, m_ctuHeight       ( 0 )
+{
+  for( Int ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++ )
+  {
+    m_bitDepths[ch] = 0;
+  }
+}
+
+Void TComCompressedPicYuv::clear()
+{
+  m_data.clear();
+  m_ctuOffset.clear();
+}
+
+Int TComCompressedPicYuv::xGetNumCtusInWidth() const
+{
+  return Int( ( m_picWidth + m_ctuWidth - 1 ) / m_ctuWidth );
+}
+
+/// size of the part of a CTU that is in the picture
+Void TComCompressedPicYuv::xGetCtuSize( const Int ctuRsAddr, const ComponentID compID, Int &width, Int &height ) const
+{
+  const Int ctuPosX = ( ctuRsAddr % xGetNumCtusInWidth() ) * m_ctuWidth;
+  const Int ctuPosY = ( ctuRsAddr / xGetNumCtusInWidth() ) * m_ctuHeight;
+  width  = std::min( Int( m_ctuWidth  ), m_picWidth  - ctuPosX ) >> getComponentScaleX( compID, m_chromaFormatIDC );
+  height = std::min( Int( m_ctuHeight ), m_picHeight - ctuPosY ) >> getComponentScaleY( compID, m_chromaFormatIDC );
+}
+
+Void TComCompressedPicYuv::compress( const TComPicYuv* pcPicYuv, const UInt maxCUWidth, const UInt maxCUHeight, const BitDepths &bitDepths )
+{
+  clear();
+  m_picWidth        = pcPicYuv->getWidth( COMPONENT_Y );
+  m_picHeight       = pcPicYuv->getHeight( COMPONENT_Y );
+  m_chromaFormatIDC = pcPicYuv->getChromaFormat();
+  m_ctuWidth        = maxCUWidth;
+  m_ctuHeight       = maxCUHeight;
+  for( Int ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++ )
+  {
+    m_bitDepths[ch] = bitDepths.recon[ch];
+  }
+
+  const Int numCtus = xGetNumCtusInWidth() * Int( ( m_picHeight + m_ctuHeight - 1 ) / m_ctuHeight );
+  m_ctuOffset.resize( numCtus );
+  m_data.reserve( size_t( m_picWidth ) * m_picHeight * 3 + numCtus );
+
+  for( Int ctuRsAddr = 0; ctuRsAddr < numCtus; ctuRsAddr++ )
+  {
+    m_ctuOffset[ctuRsAddr] = m_data.size();
+    TComCompressedPicYuvWriter writer( m_data );
+    writer.write( 0, 1 );
+    Int rawBits = 1;
+
+    for( UInt comp = 0; comp < pcPicYuv->getNumberValidComponents(); comp++ )
+    {
+      const ComponentID compID   = ComponentID( comp );
+      const Int         bitDepth = m_bitDepths[toChannelType( compID )];
+      const Int         stride   = pcPicYuv->getStride( compID );
+      const Pel        *pSrc     = pcPicYuv->getAddr( compID, ctuRsAddr );
+      TComRiceParameter riceParam( bitDepth );
+      Int width, height;
+      xGetCtuSize( ctuRsAddr, compID, width, height );
+      rawBits += width * height * bitDepth;
+
+      for( Int y = 0; y < height; y++, pSrc += stride )
+      {
+        for( Int x = 0; x < width; x++ )
+        {
+          const Int  error  = pSrc[x] - predictBlockSample( pSrc + x, stride, x, y, 1 << ( bitDepth - 1 ) );
+          const UInt value  = error >= 0 ? UInt( error ) << 1 : ( UInt( -error ) << 1 ) - 1;
+          const Int  k      = riceParam.get();
+          const UInt prefix = value >> k;
+          if( prefix < MAX_PREFIX_LENGTH )
+          {
+            writer.writeOnes( prefix );
+            writer.write( 0, 1 );
+            writer.write( value & ( ( 1u << k ) - 1 ), k );
+          }
+          else
+          {
+            writer.writeOnes( MAX_PREFIX_LENGTH );
+            writer.write( value, bitDepth + 1 );
+          }
+          riceParam.update( value );
+        }
+      }
+    }
+    writer.flush();
+
+    // CTUs that do not compress, such as noise, are stored with the samples as they are
+    if( ( m_data.size() - m_ctuOffset[ctuRsAddr] ) * 8 > size_t( rawBits ) )
+    {
+      m_data.resize( m_ctuOffset[ctuRsAddr] );
+      writer.write( 1, 1 );
+      for( UInt comp = 0; comp < pcPicYuv->getNumberValidComponents(); comp++ )
+      {
+        const ComponentID compID   = ComponentID( comp );
+        const Int         bitDepth = m_bitDepths[toChannelType( compID )];
+        const Int         stride   = pcPicYuv->getStride( compID );
+        const Pel        *pSrc     = pcPicYuv->getAddr( compID, ctuRsAddr );
+        Int width, height;
+        xGetCtuSize( ctuRsAddr, compID, width, height );
+
+        for( Int y = 0; y < height; y++, pSrc += stride )
+        {
+          for( Int x = 0; x < width; x++ )
+          {
+            writer.write( pSrc[x], bitDepth );
+          }
+        }
+      }
+      writer.flush();
+    }
+  }
+
+  // release the capacity that the coded samples do not use
+  std::vector<UChar>( m_data ).swap( m_data );
+}
+
+Void TComCompressedPicYuv::decompressCtu( TComPicYuv* pcPicYuv, const Int ctuRsAddr ) const
+{
+  assert( pcPicYuv->getWidth( COMPONENT_Y ) == m_picWidth && pcPicYuv->getHeight( COMPONENT_Y ) == m_picHeight );
+  assert( pcPicYuv->getChromaFormat() == m_chromaFormatIDC );
+
+  TComCompressedPicYuvReader reader( &m_data[m_ctuOffset[ctuRsAddr]] );
+  const Bool bRaw = reader.read( 1 ) != 0;
+
+  for( UInt comp = 0; comp < pcPicYuv->getNumberValidComponents(); comp++ )
+  {
+    const ComponentID compID   = ComponentID( comp );
+    const Int         bitDepth = m_bitDepths[toChannelType( compID )];
+    const Int         stride   = pcPicYuv->getStride( compID );
+          Pel        *pDst     = pcPicYuv->getAddr( compID, ctuRsAddr );
+    TComRiceParameter riceParam( bitDepth );
+    Int width, height;
+    xGetCtuSize( ctuRsAddr, compID, width, height );
+
+    if( bRaw )
+    {
+      for( Int y = 0; y < height; y++, pDst += stride )
+      {
+        for( Int x = 0; x < width; x++ )
+        {
+          pDst[x] = Pel( reader.read( bitDepth ) );
+        }
+      }
+      continue;
+    }
+
+    for( Int y = 0; y < height; y++, pDst += stride )
+    {
+      for( Int x = 0; x < width; x++ )
+      {
+        const Int  k      = riceParam.get();
+        const UInt prefix = reader.readOnes( MAX_PREFIX_LENGTH );
+        const UInt value  = prefix < MAX_PREFIX_LENGTH ? ( prefix << k ) | reader.read( k ) : reader.read( bitDepth + 1 );
+        const Int  error  = ( value & 1 ) ? -Int( ( value + 1 ) >> 1 ) : Int( value >> 1 );
+        pDst[x] = Pel( predictBlockSample( pDst + x, stride, x, y, 1 << ( bitDepth - 1 ) ) + error );
+        riceParam.update( value );
+      }
+    }
+  }
+}
+
+Void TComCompressedPicYuv::decompress( TComPicYuv* pcPicYuv ) const
+{
+  for( Int ctuRsAddr = 0; ctuRsAddr < Int( m_ctuOffset.size() ); ctuRsAddr++ )
+  {
+    decompressCtu( pcPicYuv, ctuRsAddr );
+  }
+}
+
+//! \}
@@ -0,0 +1,88 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCompressedPicYuv.h
+    \brief    lossless compressed storage of a picture buffer (header)
+*/
+
+#ifndef __TCOMCOMPRESSEDPICYUV__
+#define __TCOMCOMPRESSEDPICYUV__
+
+#include <vector>
+#include "CommonDef.h"
+#include "TComPicYuv.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Lossless compressed copy of the samples of a picture. Each CTU is coded on its own, so that it can be decoded
+ *  without the others: the samples are predicted with the median edge detector of LOCO-I from their neighbours in
+ *  the CTU, and the prediction errors are coded with adaptive Golomb-Rice codes.
+ */
+class TComCompressedPicYuv
+{
+private:
+  std::vector<UChar>  m_data;                       ///< the coded CTUs, each starting on a byte boundary
+  std::vector<size_t> m_ctuOffset;                  ///< position of each CTU in m_data, in raster scan order
+  Int                 m_picWidth;
+  Int                 m_picHeight;
+  ChromaFormat        m_chromaFormatIDC;
+  UInt                m_ctuWidth;
+  UInt                m_ctuHeight;
+  Int                 m_bitDepths[MAX_NUM_CHANNEL_TYPE];
+
+  Int   xGetNumCtusInWidth() const;
+  Void  xGetCtuSize       ( const Int ctuRsAddr, const ComponentID compID, Int &width, Int &height ) const;
+
+public:
+  TComCompressedPicYuv();
+
+  /// code the samples of the picture, which has CUs of maxCUWidth x maxCUHeight
+  Void  compress      ( const TComPicYuv* pcPicYuv, const UInt maxCUWidth, const UInt maxCUHeight, const BitDepths &bitDepths );
+  /// decode the samples of all CTUs into pcPicYuv, which has the geometry of the compressed picture. The margins are not set.
+  Void  decompress    ( TComPicYuv* pcPicYuv ) const;
+  /// decode the samples of one CTU into pcPicYuv
+  Void  decompressCtu ( TComPicYuv* pcPicYuv, const Int ctuRsAddr ) const;
+
+  Void  clear         ();
+  Bool  isEmpty       () const { return m_ctuOffset.empty(); }
+  size_t getSize      () const { return m_data.size(); }   ///< size of the coded samples in bytes
+};
+
+//! \}
+
+#endif // __TCOMCOMPRESSEDPICYUV__
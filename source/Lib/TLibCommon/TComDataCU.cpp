@@ -92,6 +92,7 @@ TComDataCU::TComDataCU()
   m_pCtuAboveRight     = NULL;
   m_pCtuAbove          = NULL;
   m_pCtuLeft           = NULL;
+  m_ctuNeighbourAvailability = 0;
 
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
@@ -203,6 +204,7 @@ Void TComDataCU::create( ChromaFormat chromaFormatIDC, UInt uiNumPartition, UInt
   m_pCtuAboveRight     = NULL;
   m_pCtuAbove          = NULL;
   m_pCtuLeft           = NULL;
+  m_ctuNeighbourAvailability = 0;
 }
 
 Void TComDataCU::destroy()
@@ -365,6 +367,7 @@ Void TComDataCU::destroy()
   m_pCtuAboveRight     = NULL;
   m_pCtuAbove          = NULL;
   m_pCtuLeft           = NULL;
+  m_ctuNeighbourAvailability = 0;
 
 }
 
@@ -510,6 +513,30 @@ Void TComDataCU::initCtu( TComPic* pcPic, UInt ctuRsAddr )
   {
     m_pCtuAboveRight = pcPic->getCtu( m_ctuRsAddr - frameWidthInCtus + 1 );
   }
+
+  xSetCtuNeighbourAvailability();
+}
+
+/** Record once per CTU whether each neighbouring CTU lies in the same slice and/or the same tile,
+ *  so that the neighbour derivations of every PU in the CTU can test a flag instead of comparing
+ *  slice start addresses and tile indices on each call.
+ */
+Void TComDataCU::xSetCtuNeighbourAvailability()
+{
+  const TComDataCU* const neighbours[NUMBER_OF_CTU_NEIGHBOURS] = { m_pCtuLeft, m_pCtuAbove, m_pCtuAboveLeft, m_pCtuAboveRight };
+
+  m_ctuNeighbourAvailability = 0;
+  for(UInt i=0; i<NUMBER_OF_CTU_NEIGHBOURS; i++)
+  {
+    if ( neighbours[i] != NULL && neighbours[i]->getSlice() != NULL && CUIsFromSameSlice( neighbours[i] ) )
+    {
+      m_ctuNeighbourAvailability |= CTU_NEIGHBOUR_SAME_SLICE << (i*2);
+    }
+    if ( CUIsFromSameTile( neighbours[i] ) )
+    {
+      m_ctuNeighbourAvailability |= CTU_NEIGHBOUR_SAME_TILE << (i*2);
+    }
+  }
 }
 
 
@@ -532,45 +559,42 @@ Void TComDataCU::initEstData( const UInt uiDepth, const Int qp, const Bool bTran
   const UChar uhWidth  = getSlice()->getSPS()->getMaxCUWidth()  >> uiDepth;
   const UChar uhHeight = getSlice()->getSPS()->getMaxCUHeight() >> uiDepth;
 
-  for (UInt ui = 0; ui < m_uiNumPartition; ui++)
-  {
-    for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
-    {
-      const RefPicList rpl=RefPicList(i);
-      m_apiMVPIdx[rpl][ui]  = -1;
-      m_apiMVPNum[rpl][ui]  = -1;
-    }
-    m_puhDepth  [ui]    = uiDepth;
-    m_puhWidth  [ui]    = uhWidth;
-    m_puhHeight [ui]    = uhHeight;
-    m_puhTrIdx  [ui]    = 0;
-    for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
-    {
-      m_crossComponentPredictionAlpha[comp][ui] = 0;
-      m_puhTransformSkip             [comp][ui] = 0;
-      m_explicitRdpcmMode            [comp][ui] = NUMBER_OF_RDPCM_MODES;
-    }
-    m_skipFlag[ui]      = false;
-    m_pePartSize[ui]    = NUMBER_OF_PART_SIZES;
-    m_pePredMode[ui]    = NUMBER_OF_PREDICTION_MODES;
-    m_CUTransquantBypass[ui] = bTransquantBypass;
-    m_pbIPCMFlag[ui]    = 0;
-    m_phQP[ui]          = qp;
-    m_ChromaQpAdj[ui]   = 0;
-    m_pbMergeFlag[ui]   = 0;
-    m_puhMergeIndex[ui] = 0;
-
-    for (UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
-    {
-      m_puhIntraDir[ch][ui] = ((ch==0) ? DC_IDX : 0);
-    }
+  // this is done for every mode tested, so each array is filled in one go rather than all of them per partition
+  const Int iSizeInUchar = sizeof( UChar ) * m_uiNumPartition;
+  const Int iSizeInBool  = sizeof( Bool  ) * m_uiNumPartition;
+  const Int sizeInChar   = sizeof( SChar ) * m_uiNumPartition;
 
-    m_puhInterDir[ui] = 0;
-    for (UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
-    {
-      m_puhCbf[comp][ui] = 0;
-    }
+  for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
+  {
+    const RefPicList rpl=RefPicList(i);
+    memset( m_apiMVPIdx[rpl], -1, sizeInChar );
+    memset( m_apiMVPNum[rpl], -1, sizeInChar );
+  }
+  memset( m_puhDepth,  uiDepth,  iSizeInUchar );
+  memset( m_puhWidth,  uhWidth,  iSizeInUchar );
+  memset( m_puhHeight, uhHeight, iSizeInUchar );
+  memset( m_puhTrIdx,  0,        iSizeInUchar );
+  for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
+  {
+    memset( m_crossComponentPredictionAlpha[comp], 0,                     sizeInChar   );
+    memset( m_puhTransformSkip[comp],              0,                     iSizeInUchar );
+    memset( m_explicitRdpcmMode[comp],             NUMBER_OF_RDPCM_MODES, iSizeInUchar );
+    memset( m_puhCbf[comp],                        0,                     iSizeInUchar );
+  }
+  memset( m_skipFlag,           false,                      iSizeInBool  );
+  memset( m_pePartSize,         NUMBER_OF_PART_SIZES,       sizeInChar   );
+  memset( m_pePredMode,         NUMBER_OF_PREDICTION_MODES, sizeInChar   );
+  memset( m_CUTransquantBypass, bTransquantBypass,          iSizeInBool  );
+  memset( m_pbIPCMFlag,         0,                          iSizeInBool  );
+  memset( m_phQP,               qp,                         sizeInChar   );
+  memset( m_ChromaQpAdj,        0,                          iSizeInUchar );
+  memset( m_pbMergeFlag,        0,                          iSizeInBool  );
+  memset( m_puhMergeIndex,      0,                          iSizeInUchar );
+  for (UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    memset( m_puhIntraDir[ch], ((ch==0) ? DC_IDX : 0), iSizeInUchar );
   }
+  memset( m_puhInterDir,        0,                          iSizeInUchar );
 
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
@@ -679,6 +703,7 @@ Void TComDataCU::initSubCU( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth,
   m_pCtuAbove       = pcCU->getCtuAbove();
   m_pCtuAboveLeft   = pcCU->getCtuAboveLeft();
   m_pCtuAboveRight  = pcCU->getCtuAboveRight();
+  m_ctuNeighbourAvailability = pcCU->getCtuNeighbourAvailability();
 }
 
 Void TComDataCU::setOutsideCUPart( UInt uiAbsPartIdx, UInt uiDepth )
@@ -746,6 +771,7 @@ Void TComDataCU::copySubCU( TComDataCU* pcCU, UInt uiAbsPartIdx )
   m_pCtuAboveRight     = pcCU->getCtuAboveRight();
   m_pCtuAbove          = pcCU->getCtuAbove();
   m_pCtuLeft           = pcCU->getCtuLeft();
+  m_ctuNeighbourAvailability = pcCU->getCtuNeighbourAvailability();
 
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
@@ -794,6 +820,7 @@ Void TComDataCU::copyInterPredInfoFrom    ( TComDataCU* pcCU, UInt uiAbsPartIdx,
   m_pCtuAboveRight     = pcCU->getCtuAboveRight();
   m_pCtuAbove          = pcCU->getCtuAbove();
   m_pCtuLeft           = pcCU->getCtuLeft();
+  m_ctuNeighbourAvailability = pcCU->getCtuNeighbourAvailability();
 
   m_skipFlag           = pcCU->getSkipFlag ()             + uiAbsPartIdx;
 
@@ -870,6 +897,7 @@ Void TComDataCU::copyPartFrom( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDept
   m_pCtuAboveRight     = pcCU->getCtuAboveRight();
   m_pCtuAbove          = pcCU->getCtuAbove();
   m_pCtuLeft           = pcCU->getCtuLeft();
+  m_ctuNeighbourAvailability = pcCU->getCtuNeighbourAvailability();
 
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
@@ -978,6 +1006,22 @@ Void TComDataCU::copyToPic( UChar uhDepth )
   pCtu->getTotalBins() = m_uiTotalBins;
 }
 
+/** copyToPic for a CU whose other data the CTU already holds, which is the case when the CU is split and each sub-CU
+ *  has copied its own data when it was decided: only the costs and the QPs, which the encoder sets once the sub-CUs are
+ *  done, are copied.
+ */
+Void TComDataCU::copyQPToPic()
+{
+  TComDataCU* pCtu = m_pcPic->getCtu( m_ctuRsAddr );
+
+  pCtu->getTotalCost()       = m_dTotalCost;
+  pCtu->getTotalDistortion() = m_uiTotalDistortion;
+  pCtu->getTotalBits()       = m_uiTotalBits;
+  pCtu->getTotalBins()       = m_uiTotalBins;
+
+  memcpy( pCtu->getQP() + m_absZIdxInCtu, m_phQP, sizeof( SChar ) * m_uiNumPartition );
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // Other public functions
 // --------------------------------------------------------------------------------------------------------------------
@@ -1006,7 +1050,7 @@ const TComDataCU* TComDataCU::getPULeft( UInt& uiLPartUnitIdx,
   }
 
   uiLPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdx + numPartInCtuWidth - 1 ];
-  if ( (bEnforceSliceRestriction && !CUIsFromSameSlice(m_pCtuLeft)) || (bEnforceTileRestriction && !CUIsFromSameTile(m_pCtuLeft)) )
+  if ( (bEnforceSliceRestriction && !isCtuNeighbourInSameSlice(CTU_NEIGHBOUR_LEFT)) || (bEnforceTileRestriction && !isCtuNeighbourInSameTile(CTU_NEIGHBOUR_LEFT)) )
   {
     return NULL;
   }
@@ -1045,7 +1089,7 @@ const TComDataCU* TComDataCU::getPUAbove( UInt& uiAPartUnitIdx,
 
   uiAPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdx + m_pcPic->getNumPartitionsInCtu() - numPartInCtuWidth ];
 
-  if ( (bEnforceSliceRestriction && !CUIsFromSameSlice(m_pCtuAbove)) || (bEnforceTileRestriction && !CUIsFromSameTile(m_pCtuAbove)) )
+  if ( (bEnforceSliceRestriction && !isCtuNeighbourInSameSlice(CTU_NEIGHBOUR_ABOVE)) || (bEnforceTileRestriction && !isCtuNeighbourInSameTile(CTU_NEIGHBOUR_ABOVE)) )
   {
     return NULL;
   }
@@ -1074,7 +1118,7 @@ const TComDataCU* TComDataCU::getPUAboveLeft( UInt& uiALPartUnitIdx, UInt uiCurr
       }
     }
     uiALPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdx + getPic()->getNumPartitionsInCtu() - numPartInCtuWidth - 1 ];
-    if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuAbove) )
+    if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_ABOVE) )
     {
       return NULL;
     }
@@ -1084,7 +1128,7 @@ const TComDataCU* TComDataCU::getPUAboveLeft( UInt& uiALPartUnitIdx, UInt uiCurr
   if ( !RasterAddress::isZeroRow( uiAbsPartIdx, numPartInCtuWidth ) )
   {
     uiALPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdx - 1 ];
-    if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuLeft) )
+    if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_LEFT) )
     {
       return NULL;
     }
@@ -1092,7 +1136,7 @@ const TComDataCU* TComDataCU::getPUAboveLeft( UInt& uiALPartUnitIdx, UInt uiCurr
   }
 
   uiALPartUnitIdx = g_auiRasterToZscan[ m_pcPic->getNumPartitionsInCtu() - 1 ];
-  if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuAboveLeft) )
+  if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_ABOVE_LEFT) )
   {
     return NULL;
   }
@@ -1132,7 +1176,7 @@ const TComDataCU* TComDataCU::getPUBelowLeft(UInt& uiBLPartUnitIdx,  UInt uiCurr
       return NULL;
     }
     uiBLPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdxLB + (1+uiPartUnitOffset) * numPartInCtuWidth - 1 ];
-    if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuLeft) )
+    if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_LEFT) )
     {
       return NULL;
     }
@@ -1177,7 +1221,7 @@ const TComDataCU* TComDataCU::getPUAboveRight(UInt&  uiARPartUnitIdx, UInt uiCur
     }
 
     uiARPartUnitIdx = g_auiRasterToZscan[ uiAbsPartIdxRT + m_pcPic->getNumPartitionsInCtu() - numPartInCtuWidth + uiPartUnitOffset ];
-    if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuAbove) )
+    if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_ABOVE) )
     {
       return NULL;
     }
@@ -1191,7 +1235,7 @@ const TComDataCU* TComDataCU::getPUAboveRight(UInt&  uiARPartUnitIdx, UInt uiCur
   }
 
   uiARPartUnitIdx = g_auiRasterToZscan[ m_pcPic->getNumPartitionsInCtu() - numPartInCtuWidth + uiPartUnitOffset-1 ];
-  if ( bEnforceSliceRestriction && !CUIsFromSameSliceAndTile(m_pCtuAboveRight) )
+  if ( bEnforceSliceRestriction && !isCtuNeighbourInSameSliceAndTile(CTU_NEIGHBOUR_ABOVE_RIGHT) )
   {
     return NULL;
   }
@@ -3020,7 +3064,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
 
   RefPicList eColRefPicList = getSlice()->getCheckLDC() ? eRefPicList : RefPicList(getSlice()->getColFromL0Flag());
 #if REDUCED_ENCODER_MEMORY
-  Int iColRefIdx            = pColDpbCtu->getCUMvField(RefPicList(eColRefPicList))->getRefIdx(absPartAddr);
+  Int iColRefIdx            = pColDpbCtu->getRefIdx(RefPicList(eColRefPicList), absPartAddr);
 #else
   Int iColRefIdx            = pColCtu->getCUMvField(RefPicList(eColRefPicList))->getRefIdx(absPartAddr);
 #endif
@@ -3029,7 +3073,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
   {
     eColRefPicList = RefPicList(1 - eColRefPicList);
 #if REDUCED_ENCODER_MEMORY
-    iColRefIdx = pColDpbCtu->getCUMvField(RefPicList(eColRefPicList))->getRefIdx(absPartAddr);
+    iColRefIdx = pColDpbCtu->getRefIdx(RefPicList(eColRefPicList), absPartAddr);
 #else
     iColRefIdx = pColCtu->getCUMvField(RefPicList(eColRefPicList))->getRefIdx(absPartAddr);
 #endif
@@ -3054,7 +3098,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
 
   // Scale the vector.
 #if REDUCED_ENCODER_MEMORY
-  const TComMv &cColMv = pColDpbCtu->getCUMvField(eColRefPicList)->getMv(absPartAddr);
+  const TComMv &cColMv = pColDpbCtu->getMv(eColRefPicList, absPartAddr);
 #else
   const TComMv &cColMv = pColCtu->getCUMvField(eColRefPicList)->getMv(absPartAddr);
 #endif
@@ -3123,16 +3167,22 @@ Void TComDataCU::xDeriveCenterIdx( UInt uiPartIdx, UInt& ruiPartIdxCenter ) cons
 Void TComDataCU::compressMV()
 {
 #if REDUCED_ENCODER_MEMORY
-  const Int scaleFactor = std::max<Int>(1,4 * AMVP_DECIMATION_FACTOR / m_unitSize);
   TComPicSym &picSym=*(getPic()->getPicSym());
   TComPicSym::DPBPerCtuData &dpbForCtu=picSym.getDPBPerCtuData(getCtuRsAddr());
+  const UInt numSubpartsWithIdenticalMotion = 1 << dpbForCtu.m_log2PartsPerBlock;
 
-  for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
+  // the motion of each 16x16 block is that of its top-left partition
+  for (UInt partIdx = 0, blockIdx = 0; partIdx < m_uiNumPartition; partIdx += numSubpartsWithIdenticalMotion, blockIdx++)
   {
-    dpbForCtu.m_CUMvField[i].compress(dpbForCtu.m_pePredMode, m_pePredMode, scaleFactor,m_acCUMvField[i]);
-    memcpy(dpbForCtu.m_pePartSize, m_pePartSize, sizeof(*m_pePartSize)*m_uiNumPartition);
-    dpbForCtu.m_pSlice = getSlice();
+    dpbForCtu.m_pePredMode[blockIdx] = m_pePredMode[partIdx];
+    dpbForCtu.m_pePartSize[blockIdx] = m_pePartSize[partIdx];
+    for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
+    {
+      dpbForCtu.m_pcMv    [i][blockIdx] = m_acCUMvField[i].getMv    (partIdx);
+      dpbForCtu.m_piRefIdx[i][blockIdx] = m_acCUMvField[i].getRefIdx(partIdx);
+    }
   }
+  dpbForCtu.m_pSlice = getSlice();
 #else
   Int scaleFactor = 4 * AMVP_DECIMATION_FACTOR / m_unitSize;
   if (scaleFactor > 0)
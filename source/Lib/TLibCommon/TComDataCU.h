@@ -56,6 +56,19 @@ class TComTU; // forward declaration
 
 static const UInt NUM_MOST_PROBABLE_MODES=3;
 
+/// neighbouring CTUs whose slice/tile membership is cached per CTU
+enum CtuNeighbour
+{
+  CTU_NEIGHBOUR_LEFT        = 0,
+  CTU_NEIGHBOUR_ABOVE       = 1,
+  CTU_NEIGHBOUR_ABOVE_LEFT  = 2,
+  CTU_NEIGHBOUR_ABOVE_RIGHT = 3,
+  NUMBER_OF_CTU_NEIGHBOURS  = 4
+};
+
+static const UChar CTU_NEIGHBOUR_SAME_SLICE = 1;
+static const UChar CTU_NEIGHBOUR_SAME_TILE  = 2;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -118,6 +131,7 @@ private:
   TComDataCU*   m_pCtuAboveRight;                       ///< pointer of above-right CTU.
   TComDataCU*   m_pCtuAbove;                            ///< pointer of above CTU.
   TComDataCU*   m_pCtuLeft;                             ///< pointer of left CTU
+  UChar         m_ctuNeighbourAvailability;             ///< slice/tile membership of the neighbouring CTUs, two bits per CtuNeighbour
   TComMvField   m_cMvFieldA;                            ///< motion vector of position A
   TComMvField   m_cMvFieldB;                            ///< motion vector of position B
   TComMvField   m_cMvFieldC;                            ///< motion vector of position C
@@ -167,6 +181,8 @@ protected:
 
   Void          xDeriveCenterIdx              ( UInt uiPartIdx, UInt& ruiPartIdxCenter ) const;
 
+  Void          xSetCtuNeighbourAvailability  ( );
+
 public:
                 TComDataCU();
   virtual       ~TComDataCU();
@@ -192,6 +208,7 @@ public:
   Void          copyPartFrom                  ( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth );
 
   Void          copyToPic                     ( UChar uiDepth );
+  Void          copyQPToPic                   ( );  ///< copyToPic for a CU whose other data the CTU already holds
 
   // -------------------------------------------------------------------------------------------------------------------
   // member functions for CU description
@@ -400,6 +417,10 @@ public:
   TComDataCU*   getCtuAbove                   ( )                                                          { return m_pCtuAbove;                        }
   TComDataCU*   getCtuAboveLeft               ( )                                                          { return m_pCtuAboveLeft;                    }
   TComDataCU*   getCtuAboveRight              ( )                                                          { return m_pCtuAboveRight;                   }
+  UChar         getCtuNeighbourAvailability   ( ) const                                                    { return m_ctuNeighbourAvailability;         }
+  Bool          isCtuNeighbourInSameSlice     ( CtuNeighbour n ) const                                     { return ( m_ctuNeighbourAvailability & (CTU_NEIGHBOUR_SAME_SLICE << (n*2)) ) != 0; }
+  Bool          isCtuNeighbourInSameTile      ( CtuNeighbour n ) const                                     { return ( m_ctuNeighbourAvailability & (CTU_NEIGHBOUR_SAME_TILE  << (n*2)) ) != 0; }
+  Bool          isCtuNeighbourInSameSliceAndTile( CtuNeighbour n ) const                                   { return isCtuNeighbourInSameSlice(n) && isCtuNeighbourInSameTile(n); }
   Bool          CUIsFromSameSlice             ( const TComDataCU *pCU /* Can be NULL */ ) const            { return ( pCU!=NULL && pCU->getSlice()->getSliceCurStartCtuTsAddr() == getSlice()->getSliceCurStartCtuTsAddr() ); }
   Bool          CUIsFromSameTile              ( const TComDataCU *pCU /* Can be NULL */ ) const;
   Bool          CUIsFromSameSliceAndTile      ( const TComDataCU *pCU /* Can be NULL */ ) const;
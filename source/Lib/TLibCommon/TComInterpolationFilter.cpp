@@ -49,6 +49,10 @@
 #if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
 #include <emmintrin.h>
 #endif
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -178,6 +182,80 @@ inline __m128i simdClip3( __m128i mmMin , __m128i mmMax , __m128i mmPix )
 }
 #endif
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+/**
+ * \brief AVX2 version of the FIR filter for 16-bit samples, used for an even number of taps and widths that are a multiple of 4
+ *
+ * Pairs of taps are applied with a single multiply-add on interleaved samples; 16, 8 or 4 output samples are produced at a time.
+ */
+template<Int N, Bool isLast>
+SIMD_TARGET_AVX2 static Void simdFilterAVX2( Pel const *src, Int srcStride, Int cStride, Pel *dst, Int dstStride, Int width, Int height, Pel const *c, Int offset, Int shift, Pel maxVal )
+{
+  __m256i mmCoeff[N/2];
+  for( Int n = 0 ; n < N / 2 ; n++ )
+  {
+    mmCoeff[n] = _mm256_unpacklo_epi16( _mm256_set1_epi16( c[2*n] ), _mm256_set1_epi16( c[2*n+1] ) );
+  }
+  const __m256i mmOffset = _mm256_set1_epi32( offset );
+  const __m128i mmShift  = _mm_cvtsi32_si128( shift );
+  const __m256i mmMin    = _mm256_setzero_si256();
+  const __m256i mmMax    = _mm256_set1_epi16( maxVal );
+
+  for( Int row = 0 ; row < height ; row++ )
+  {
+    Int col = 0;
+    for( ; col + 16 <= width ; col += 16 )
+    {
+      __m256i sumLo = mmOffset;
+      __m256i sumHi = mmOffset;
+      for( Int n = 0 ; n < N / 2 ; n++ )
+      {
+        const __m256i mmPix0 = _mm256_loadu_si256( ( const __m256i* )( src + col + ( 2 * n     ) * cStride ) );
+        const __m256i mmPix1 = _mm256_loadu_si256( ( const __m256i* )( src + col + ( 2 * n + 1 ) * cStride ) );
+        sumLo = _mm256_add_epi32( sumLo , _mm256_madd_epi16( _mm256_unpacklo_epi16( mmPix0 , mmPix1 ) , mmCoeff[n] ) );
+        sumHi = _mm256_add_epi32( sumHi , _mm256_madd_epi16( _mm256_unpackhi_epi16( mmPix0 , mmPix1 ) , mmCoeff[n] ) );
+      }
+      __m256i mmFiltered = _mm256_packs_epi32( _mm256_sra_epi32( sumLo , mmShift ) , _mm256_sra_epi32( sumHi , mmShift ) );
+      if( isLast )
+      {
+        mmFiltered = _mm256_min_epi16( mmMax , _mm256_max_epi16( mmMin , mmFiltered ) );
+      }
+      _mm256_storeu_si256( ( __m256i* )( dst + col ) , mmFiltered );
+    }
+    for( ; col < width ; col += 8 )
+    {
+      // 8 samples, or 4 for the last columns of a width that is not a multiple of 8
+      const Bool bHalf = ( col + 8 > width );
+      __m128i sumLo = _mm256_castsi256_si128( mmOffset );
+      __m128i sumHi = _mm256_castsi256_si128( mmOffset );
+      for( Int n = 0 ; n < N / 2 ; n++ )
+      {
+        const Pel *pSrc = src + col + ( 2 * n ) * cStride;
+        const __m128i mmPix0 = bHalf ? _mm_loadl_epi64( ( const __m128i* )pSrc )               : _mm_loadu_si128( ( const __m128i* )pSrc );
+        const __m128i mmPix1 = bHalf ? _mm_loadl_epi64( ( const __m128i* )( pSrc + cStride ) ) : _mm_loadu_si128( ( const __m128i* )( pSrc + cStride ) );
+        sumLo = _mm_add_epi32( sumLo , _mm_madd_epi16( _mm_unpacklo_epi16( mmPix0 , mmPix1 ) , _mm256_castsi256_si128( mmCoeff[n] ) ) );
+        sumHi = _mm_add_epi32( sumHi , _mm_madd_epi16( _mm_unpackhi_epi16( mmPix0 , mmPix1 ) , _mm256_castsi256_si128( mmCoeff[n] ) ) );
+      }
+      __m128i mmFiltered = _mm_packs_epi32( _mm_sra_epi32( sumLo , mmShift ) , _mm_sra_epi32( sumHi , mmShift ) );
+      if( isLast )
+      {
+        mmFiltered = _mm_min_epi16( _mm256_castsi256_si128( mmMax ) , _mm_max_epi16( _mm256_castsi256_si128( mmMin ) , mmFiltered ) );
+      }
+      if( bHalf )
+      {
+        _mm_storel_epi64( ( __m128i* )( dst + col ) , mmFiltered );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* )( dst + col ) , mmFiltered );
+      }
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -322,6 +400,14 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
     maxVal = 0;
   }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( bitDepth <= 10 && !( N & 0x01 ) && !( width & 0x03 ) && getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdFilterAVX2<N, isLast>( src, srcStride, cStride, dst, dstStride, width, height, c, offset, shift, maxVal );
+    return;
+  }
+#endif
+
 #if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
   if( bitDepth <= 10 )
   {
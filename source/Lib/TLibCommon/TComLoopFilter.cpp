@@ -40,6 +40,11 @@
 #include "TComMv.h"
 #include "TComTU.h"
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -66,6 +71,240 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
   0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,7,8,9,10,11,12,13,14,15,16,17,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64
 };
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 kernels
+// ====================================================================================================================
+
+// The kernels below keep the 16-bit samples of one to four lines (one per lane) in the low half of a register and
+// reproduce xPelFilterLuma/xPelFilterChroma and the filter decisions exactly for bit depths up to 10, where none of
+// the intermediate values exceed 16 bits.
+
+SIMD_TARGET_AVX2 static inline __m128i simdClip3Epi16( const __m128i &mmMin, const __m128i &mmMax, const __m128i &mmVal )
+{
+  return _mm_min_epi16( _mm_max_epi16( mmMin, mmVal ), mmMax );
+}
+
+/** loads the samples m[0..7] (p3..q3) of the four lines of a luma edge segment; piSrc points to q0 of the first line
+ */
+SIMD_TARGET_AVX2 static inline Void simdLoadLumaSegment( const Pel* piSrc, Int iOffset, Int iSrcStep, __m128i* m )
+{
+  if( iOffset == 1 )
+  {
+    // vertical edge: each line holds p3..q3 contiguously, transpose 4x8
+    const __m128i r0  = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 ) );
+    const __m128i r1  = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep ) );
+    const __m128i r2  = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep * 2 ) );
+    const __m128i r3  = _mm_loadu_si128( ( const __m128i* )( piSrc - 4 + iSrcStep * 3 ) );
+    const __m128i t0  = _mm_unpacklo_epi16( r0, r1 );
+    const __m128i t1  = _mm_unpackhi_epi16( r0, r1 );
+    const __m128i t2  = _mm_unpacklo_epi16( r2, r3 );
+    const __m128i t3  = _mm_unpackhi_epi16( r2, r3 );
+    const __m128i m01 = _mm_unpacklo_epi32( t0, t2 );
+    const __m128i m23 = _mm_unpackhi_epi32( t0, t2 );
+    const __m128i m45 = _mm_unpacklo_epi32( t1, t3 );
+    const __m128i m67 = _mm_unpackhi_epi32( t1, t3 );
+    m[0] = m01; m[1] = _mm_unpackhi_epi64( m01, m01 );
+    m[2] = m23; m[3] = _mm_unpackhi_epi64( m23, m23 );
+    m[4] = m45; m[5] = _mm_unpackhi_epi64( m45, m45 );
+    m[6] = m67; m[7] = _mm_unpackhi_epi64( m67, m67 );
+  }
+  else
+  {
+    for( Int k = 0; k < 8; k++ )
+    {
+      m[k] = _mm_loadl_epi64( ( const __m128i* )( piSrc + ( k - 4 ) * iOffset ) );
+    }
+  }
+}
+
+/** stores the samples m[1..6] (p2..q2) of the four lines of a luma edge segment
+ */
+SIMD_TARGET_AVX2 static inline Void simdStoreLumaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, const __m128i* m )
+{
+  if( iOffset == 1 )
+  {
+    const __m128i t0   = _mm_unpacklo_epi16( m[0], m[1] );
+    const __m128i t1   = _mm_unpacklo_epi16( m[2], m[3] );
+    const __m128i t2   = _mm_unpacklo_epi16( m[4], m[5] );
+    const __m128i t3   = _mm_unpacklo_epi16( m[6], m[7] );
+    const __m128i r01l = _mm_unpacklo_epi32( t0, t1 );
+    const __m128i r01h = _mm_unpacklo_epi32( t2, t3 );
+    const __m128i r23l = _mm_unpackhi_epi32( t0, t1 );
+    const __m128i r23h = _mm_unpackhi_epi32( t2, t3 );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 ),                _mm_unpacklo_epi64( r01l, r01h ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep ),     _mm_unpackhi_epi64( r01l, r01h ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep * 2 ), _mm_unpacklo_epi64( r23l, r23h ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc - 4 + iSrcStep * 3 ), _mm_unpackhi_epi64( r23l, r23h ) );
+  }
+  else
+  {
+    for( Int k = 1; k < 7; k++ )
+    {
+      _mm_storel_epi64( ( __m128i* )( piSrc + ( k - 4 ) * iOffset ), m[k] );
+    }
+  }
+}
+
+/** filter decisions and strong/weak luma filtering of one segment of four lines, equivalent to the xCalcDP/xCalcDQ,
+ *  xUseStrongFiltering and xPelFilterLuma sequence in xEdgeFilterLuma
+ */
+SIMD_TARGET_AVX2 static Void simdEdgeFilterLumaAVX2( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut,
+                                                     Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma )
+{
+  __m128i m[8];
+  simdLoadLumaSegment( piSrc, iOffset, iSrcStep, m );
+
+  const __m128i mmDP = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[1], _mm_slli_epi16( m[2], 1 ) ), m[3] ) );
+  const __m128i mmDQ = _mm_abs_epi16( _mm_add_epi16( _mm_sub_epi16( m[4], _mm_slli_epi16( m[5], 1 ) ), m[6] ) );
+  const Int dp0 = _mm_extract_epi16( mmDP, 0 );
+  const Int dp3 = _mm_extract_epi16( mmDP, 3 );
+  const Int dq0 = _mm_extract_epi16( mmDQ, 0 );
+  const Int dq3 = _mm_extract_epi16( mmDQ, 3 );
+  const Int d0  = dp0 + dq0;
+  const Int d3  = dp3 + dq3;
+
+  if( d0 + d3 >= iBeta )
+  {
+    return;
+  }
+
+  const Bool bFilterP = ( dp0 + dp3 < iSideThreshold );
+  const Bool bFilterQ = ( dq0 + dq3 < iSideThreshold );
+
+  const __m128i mmStrong = _mm_add_epi16( _mm_abs_epi16( _mm_sub_epi16( m[0], m[3] ) ), _mm_abs_epi16( _mm_sub_epi16( m[7], m[4] ) ) );
+  const __m128i mmStep   = _mm_abs_epi16( _mm_sub_epi16( m[3], m[4] ) );
+  const Bool sw = ( _mm_extract_epi16( mmStrong, 0 ) < ( iBeta >> 3 ) ) && ( 2 * d0 < ( iBeta >> 2 ) ) && ( _mm_extract_epi16( mmStep, 0 ) < ( ( iTc * 5 + 1 ) >> 1 ) )
+               && ( _mm_extract_epi16( mmStrong, 3 ) < ( iBeta >> 3 ) ) && ( 2 * d3 < ( iBeta >> 2 ) ) && ( _mm_extract_epi16( mmStep, 3 ) < ( ( iTc * 5 + 1 ) >> 1 ) );
+
+  __m128i f[8];
+  for( Int k = 0; k < 8; k++ )
+  {
+    f[k] = m[k];
+  }
+
+  if( sw )
+  {
+    const __m128i mmTc2 = _mm_set1_epi16( 2 * iTc );
+    const __m128i mm2   = _mm_set1_epi16( 2 );
+    const __m128i mm4   = _mm_set1_epi16( 4 );
+    const __m128i m34   = _mm_add_epi16( m[3], m[4] );
+    f[3] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[5] ), _mm_slli_epi16( _mm_add_epi16( m[2], m34 ), 1 ) ), mm4 ), 3 );
+    f[4] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[2], m[6] ), _mm_slli_epi16( _mm_add_epi16( m[5], m34 ), 1 ) ), mm4 ), 3 );
+    f[2] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[2] ), m34 ), mm2 ), 2 );
+    f[5] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( m[5], m[6] ), m34 ), mm2 ), 2 );
+    f[1] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[0], 1 ), _mm_add_epi16( m[1], _mm_slli_epi16( m[1], 1 ) ) ), _mm_add_epi16( m[2], m34 ) ), mm4 ), 3 );
+    f[6] = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( _mm_add_epi16( _mm_slli_epi16( m[7], 1 ), _mm_add_epi16( m[6], _mm_slli_epi16( m[6], 1 ) ) ), _mm_add_epi16( m[5], m34 ) ), mm4 ), 3 );
+    for( Int k = 1; k < 7; k++ )
+    {
+      f[k] = simdClip3Epi16( _mm_sub_epi16( m[k], mmTc2 ), _mm_add_epi16( m[k], mmTc2 ), f[k] );
+    }
+  }
+  else
+  {
+    const __m128i mmTc     = _mm_set1_epi16( iTc );
+    const __m128i mmNegTc  = _mm_set1_epi16( -iTc );
+    const __m128i mmTcH    = _mm_set1_epi16( iTc >> 1 );
+    const __m128i mmNegTcH = _mm_set1_epi16( -( iTc >> 1 ) );
+    const __m128i mmZero   = _mm_setzero_si128();
+    const __m128i mmMaxVal = _mm_set1_epi16( ( 1 << bitDepthLuma ) - 1 );
+    const __m128i mmOne    = _mm_set1_epi16( 1 );
+
+    const __m128i d43   = _mm_sub_epi16( m[4], m[3] );
+    const __m128i d52   = _mm_sub_epi16( m[5], m[2] );
+    __m128i       delta = _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( _mm_add_epi16( _mm_slli_epi16( d43, 3 ), d43 ), _mm_add_epi16( _mm_slli_epi16( d52, 1 ), d52 ) ), _mm_set1_epi16( 8 ) ), 4 );
+    const __m128i mask  = _mm_cmpgt_epi16( _mm_set1_epi16( iThrCut ), _mm_abs_epi16( delta ) );
+
+    delta = simdClip3Epi16( mmNegTc, mmTc, delta );
+    f[3]  = _mm_blendv_epi8( m[3], simdClip3Epi16( mmZero, mmMaxVal, _mm_add_epi16( m[3], delta ) ), mask );
+    f[4]  = _mm_blendv_epi8( m[4], simdClip3Epi16( mmZero, mmMaxVal, _mm_sub_epi16( m[4], delta ) ), mask );
+
+    if( bFilterP )
+    {
+      const __m128i avg    = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( m[1], m[3] ), mmOne ), 1 );
+      const __m128i delta1 = simdClip3Epi16( mmNegTcH, mmTcH, _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( avg, m[2] ), delta ), 1 ) );
+      f[2] = _mm_blendv_epi8( m[2], simdClip3Epi16( mmZero, mmMaxVal, _mm_add_epi16( m[2], delta1 ) ), mask );
+    }
+    if( bFilterQ )
+    {
+      const __m128i avg    = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( m[6], m[4] ), mmOne ), 1 );
+      const __m128i delta2 = simdClip3Epi16( mmNegTcH, mmTcH, _mm_srai_epi16( _mm_sub_epi16( _mm_sub_epi16( avg, m[5] ), delta ), 1 ) );
+      f[5] = _mm_blendv_epi8( m[5], simdClip3Epi16( mmZero, mmMaxVal, _mm_add_epi16( m[5], delta2 ) ), mask );
+    }
+  }
+
+  if( bPartPNoFilter )
+  {
+    f[1] = m[1]; f[2] = m[2]; f[3] = m[3];
+  }
+  if( bPartQNoFilter )
+  {
+    f[4] = m[4]; f[5] = m[5]; f[6] = m[6];
+  }
+
+  simdStoreLumaSegment( piSrc, iOffset, iSrcStep, f );
+}
+
+/** chroma filtering of numLines (2 or 4) lines, equivalent to calling xPelFilterChroma for each line
+ */
+SIMD_TARGET_AVX2 static Void simdEdgeFilterChromaAVX2( Pel* piSrc, Int iOffset, Int iSrcStep, Int numLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma )
+{
+  __m128i m2, m3, m4, m5;
+  if( iOffset == 1 )
+  {
+    // vertical edge: each line holds p1 p0 q0 q1 contiguously, transpose 4x4
+    const __m128i r0  = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 ) );
+    const __m128i r1  = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep ) );
+    const __m128i r2  = numLines > 2 ? _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep * 2 ) ) : _mm_setzero_si128();
+    const __m128i r3  = numLines > 2 ? _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 + iSrcStep * 3 ) ) : _mm_setzero_si128();
+    const __m128i t0  = _mm_unpacklo_epi32( _mm_unpacklo_epi16( r0, r1 ), _mm_unpacklo_epi16( r2, r3 ) );
+    const __m128i t1  = _mm_unpackhi_epi32( _mm_unpacklo_epi16( r0, r1 ), _mm_unpacklo_epi16( r2, r3 ) );
+    m2 = t0; m3 = _mm_unpackhi_epi64( t0, t0 );
+    m4 = t1; m5 = _mm_unpackhi_epi64( t1, t1 );
+  }
+  else if( numLines > 2 )
+  {
+    m2 = _mm_loadl_epi64( ( const __m128i* )( piSrc - 2 * iOffset ) );
+    m3 = _mm_loadl_epi64( ( const __m128i* )( piSrc - iOffset ) );
+    m4 = _mm_loadl_epi64( ( const __m128i* )( piSrc ) );
+    m5 = _mm_loadl_epi64( ( const __m128i* )( piSrc + iOffset ) );
+  }
+  else
+  {
+    m2 = _mm_setr_epi16( piSrc[-2 * iOffset], piSrc[-2 * iOffset + 1], 0, 0, 0, 0, 0, 0 );
+    m3 = _mm_setr_epi16( piSrc[    -iOffset], piSrc[    -iOffset + 1], 0, 0, 0, 0, 0, 0 );
+    m4 = _mm_setr_epi16( piSrc[           0], piSrc[               1], 0, 0, 0, 0, 0, 0 );
+    m5 = _mm_setr_epi16( piSrc[     iOffset], piSrc[     iOffset + 1], 0, 0, 0, 0, 0, 0 );
+  }
+
+  const __m128i mmTc     = _mm_set1_epi16( iTc );
+  const __m128i mmNegTc  = _mm_set1_epi16( -iTc );
+  const __m128i mmZero   = _mm_setzero_si128();
+  const __m128i mmMaxVal = _mm_set1_epi16( ( 1 << bitDepthChroma ) - 1 );
+
+  const __m128i delta = simdClip3Epi16( mmNegTc, mmTc, _mm_srai_epi16( _mm_add_epi16( _mm_sub_epi16( _mm_add_epi16( _mm_slli_epi16( _mm_sub_epi16( m4, m3 ), 2 ), m2 ), m5 ), _mm_set1_epi16( 4 ) ), 3 ) );
+  const __m128i p0    = bPartPNoFilter ? m3 : simdClip3Epi16( mmZero, mmMaxVal, _mm_add_epi16( m3, delta ) );
+  const __m128i q0    = bPartQNoFilter ? m4 : simdClip3Epi16( mmZero, mmMaxVal, _mm_sub_epi16( m4, delta ) );
+
+  Pel p0Buf[8], q0Buf[8];
+  _mm_storeu_si128( ( __m128i* )p0Buf, p0 );
+  _mm_storeu_si128( ( __m128i* )q0Buf, q0 );
+  if( iOffset == 1 || numLines <= 2 )
+  {
+    for( Int i = 0; i < numLines; i++ )
+    {
+      piSrc[iSrcStep * i - iOffset] = p0Buf[i];
+      piSrc[iSrcStep * i]           = q0Buf[i];
+    }
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* )( piSrc - iOffset ), p0 );
+    _mm_storel_epi64( ( __m128i* )( piSrc ), q0 );
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -632,17 +871,6 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* const pcCU, const UInt uiAbsZo
       UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
       for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
       {
-        Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dq0 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dp3 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int dq3 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int d0 = dp0 + dq0;
-        Int d3 = dp3 + dq3;
-
-        Int dp = dp0 + dp3;
-        Int dq = dq0 + dq3;
-        Int d =  d0 + d3;
-
         if (bPCMFilter || ppsTransquantBypassEnabledFlag)
         {
           // Check if each of PUs is I_PCM with LF disabling
@@ -654,19 +882,7 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* const pcCU, const UInt uiAbsZo
           bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
         }
 
-        if (d < iBeta)
-        {
-          Bool bFilterP = (dp < iSideThreshold);
-          Bool bFilterQ = (dq < iSideThreshold);
-
-          Bool sw =  xUseStrongFiltering( iOffset, 2*d0, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0))
-          && xUseStrongFiltering( iOffset, 2*d3, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3));
-
-          for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
-          {
-            xPelFilterLuma( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+i), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
-          }
-        }
+        xEdgeFilterLumaSegment( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4), iOffset, iSrcStep, iBeta, iTc, iSideThreshold, iThrCut, bPartPNoFilter, bPartQNoFilter, bitDepthLuma );
       }
     }
   }
@@ -804,15 +1020,90 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* const pcCU, const UInt uiAbs
         Int iIndexTC = Clip3(0, MAX_QP+DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*(ucBs - 1) + (tcOffsetDiv2 << 1));
         Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
 
-        for ( UInt uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiLoopLength), iOffset, iTc , bPartPNoFilter, bPartQNoFilter, bitDepthChroma);
-        }
+        xEdgeFilterChromaSegment( piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, bPartPNoFilter, bPartQNoFilter, bitDepthChroma );
       }
     }
   }
 }
 
+/**
+ - Deblocking of one segment of four lines across a luma edge
+ .
+ \param piSrc           pointer to the first line of the segment
+ \param iOffset         offset value for picture data
+ \param iSrcStep        distance between the lines of the segment
+ \param iBeta           beta value
+ \param iTc             tc value
+ \param iSideThreshold  threshold for the filtering of the second sample on each side
+ \param iThrCut         threshold value for weak filter decision
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ \param bitDepthLuma    luma bit depth
+*/
+Void TComLoopFilter::xEdgeFilterLumaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma )
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if ( bitDepthLuma <= 10 && getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdEdgeFilterLumaAVX2( piSrc, iOffset, iSrcStep, iBeta, iTc, iSideThreshold, iThrCut, bPartPNoFilter, bPartQNoFilter, bitDepthLuma );
+    return;
+  }
+#endif
+
+  Int dp0 = xCalcDP( piSrc, iOffset);
+  Int dq0 = xCalcDQ( piSrc, iOffset);
+  Int dp3 = xCalcDP( piSrc+iSrcStep*3, iOffset);
+  Int dq3 = xCalcDQ( piSrc+iSrcStep*3, iOffset);
+  Int d0 = dp0 + dq0;
+  Int d3 = dp3 + dq3;
+
+  Int dp = dp0 + dp3;
+  Int dq = dq0 + dq3;
+  Int d =  d0 + d3;
+
+  if (d < iBeta)
+  {
+    Bool bFilterP = (dp < iSideThreshold);
+    Bool bFilterQ = (dq < iSideThreshold);
+
+    Bool sw =  xUseStrongFiltering( iOffset, 2*d0, iBeta, iTc, piSrc)
+    && xUseStrongFiltering( iOffset, 2*d3, iBeta, iTc, piSrc+iSrcStep*3);
+
+    for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
+    {
+      xPelFilterLuma( piSrc+iSrcStep*i, iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
+    }
+  }
+}
+
+/**
+ - Deblocking of numLines lines across a chroma edge
+ .
+ \param piSrc           pointer to the first line
+ \param iOffset         offset value for picture data
+ \param iSrcStep        distance between the lines
+ \param numLines        number of lines
+ \param iTc             tc value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ \param bitDepthChroma  chroma bit depth
+*/
+Void TComLoopFilter::xEdgeFilterChromaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, UInt numLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma )
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if ( bitDepthChroma <= 10 && (numLines == 2 || numLines == 4) && getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdEdgeFilterChromaAVX2( piSrc, iOffset, iSrcStep, numLines, iTc, bPartPNoFilter, bPartQNoFilter, bitDepthChroma );
+    return;
+  }
+#endif
+
+  for ( UInt uiStep = 0; uiStep < numLines; uiStep++ )
+  {
+    xPelFilterChroma( piSrc + iSrcStep*uiStep, iOffset, iTc , bPartPNoFilter, bPartQNoFilter, bitDepthChroma);
+  }
+}
+
 /**
  - Deblocking for the luminance component with strong or weak filter
  .
@@ -107,6 +107,9 @@ protected:
   Void xEdgeFilterLuma            ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
   Void xEdgeFilterChroma          ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
 
+  Void xEdgeFilterLumaSegment    ( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma );
+  Void xEdgeFilterChromaSegment  ( Pel* piSrc, Int iOffset, Int iSrcStep, UInt numLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma );
+
   __inline Void xPelFilterLuma( Pel* piSrc, Int iOffset, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, const Int bitDepthLuma);
   __inline Void xPelFilterChroma( Pel* piSrc, Int iOffset, Int tc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma);
 
@@ -327,30 +327,7 @@ Void TComCUMvField::setAllMvField( TComMvField const & mvField, PartSize eCUMode
  * \param pePredMode Pointer to prediction modes
  * \param scale      Factor by which to subsample motion information
  */
-#if REDUCED_ENCODER_MEMORY
-Void TComCUMvField::compress(SChar *pePredMode, const SChar* pePredModeSource, const Int scale, const TComCUMvField &source)
-{
-  const Int numSubpartsWithIdenticalMotion = scale * scale;
-  assert( numSubpartsWithIdenticalMotion > 0 && numSubpartsWithIdenticalMotion <= m_uiNumPartition);
-  assert(source.m_uiNumPartition == m_uiNumPartition);
-
-  for ( Int partIdx = 0; partIdx < m_uiNumPartition; partIdx += numSubpartsWithIdenticalMotion )
-  {
-    TComMv cMv(0,0);
-    Int iRefIdx = 0;
-
-    cMv = source.m_pcMv[ partIdx ];
-    PredMode predMode = static_cast<PredMode>( pePredModeSource[ partIdx ] );
-    iRefIdx = source.m_piRefIdx[ partIdx ];
-    for ( Int i = 0; i < numSubpartsWithIdenticalMotion; i++ )
-    {
-      m_pcMv[ partIdx + i ] = cMv;
-      pePredMode[ partIdx + i ] = predMode;
-      m_piRefIdx[ partIdx + i ] = iRefIdx;
-    }
-  }
-}
-#else
+#if !REDUCED_ENCODER_MEMORY
 Void TComCUMvField::compress(SChar* pePredMode, Int scale)
 {
   Int N = scale * scale;
@@ -37,6 +37,7 @@
 
 #include "TComPic.h"
 #include "SEI.h"
+#include "TComSubPelPlanes.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -49,6 +50,10 @@ TComPic::TComPic()
 : m_uiTLayer                              (0)
 , m_bUsedByCurr                           (false)
 , m_bIsLongTerm                           (false)
+, m_pcPicYuvOrgTiles                      (NULL)
+#if REDUCED_ENCODER_MEMORY
+, m_pcBufferPool                          (NULL)
+#endif
 , m_pcPicYuvPred                          (NULL)
 , m_pcPicYuvResi                          (NULL)
 , m_bReconstructed                        (false)
@@ -75,31 +80,33 @@ Void TComPic::create( const TComSPS &sps, const TComPPS &pps, const Bool bIsVirt
 {
   destroy();
 
-  const ChromaFormat chromaFormatIDC = sps.getChromaFormatIdc();
-  const Int          iWidth          = sps.getPicWidthInLumaSamples();
-  const Int          iHeight         = sps.getPicHeightInLumaSamples();
-  const UInt         uiMaxCuWidth    = sps.getMaxCUWidth();
-  const UInt         uiMaxCuHeight   = sps.getMaxCUHeight();
   const UInt         uiMaxDepth      = sps.getMaxTotalCUDepth();
 
 #if REDUCED_ENCODER_MEMORY
   m_picSym.create( sps, pps, uiMaxDepth, bCreateForImmediateReconstruction );
   if (bCreateEncoderSourcePicYuv)
+  {
+    m_apcPicYuv[PIC_YUV_ORG    ]   = xCreatePicYuv( sps );
+    m_apcPicYuv[PIC_YUV_TRUE_ORG]  = xCreatePicYuv( sps );
+  }
+  if (bCreateForImmediateReconstruction)
+  {
+    m_apcPicYuv[PIC_YUV_REC]  = xCreatePicYuv( sps );
+  }
 #else
+  const ChromaFormat chromaFormatIDC = sps.getChromaFormatIdc();
+  const Int          iWidth          = sps.getPicWidthInLumaSamples();
+  const Int          iHeight         = sps.getPicHeightInLumaSamples();
+  const UInt         uiMaxCuWidth    = sps.getMaxCUWidth();
+  const UInt         uiMaxCuHeight   = sps.getMaxCUHeight();
+
   m_picSym.create( sps, pps, uiMaxDepth );
   if (!bIsVirtual)
-#endif
   {
     m_apcPicYuv[PIC_YUV_ORG    ]   = new TComPicYuv;  m_apcPicYuv[PIC_YUV_ORG     ]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
     m_apcPicYuv[PIC_YUV_TRUE_ORG]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_TRUE_ORG]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
   }
-#if REDUCED_ENCODER_MEMORY
-  if (bCreateForImmediateReconstruction)
-  {
-#endif
-    m_apcPicYuv[PIC_YUV_REC]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_REC]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
-#if REDUCED_ENCODER_MEMORY
-  }
+  m_apcPicYuv[PIC_YUV_REC]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_REC]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
 #endif
 
   // there are no SEI messages associated with this picture initially
@@ -115,36 +122,22 @@ Void TComPic::prepareForEncoderSourcePicYuv()
 {
   const TComSPS &sps=m_picSym.getSPS();
 
-  const ChromaFormat chromaFormatIDC = sps.getChromaFormatIdc();
-  const Int          iWidth          = sps.getPicWidthInLumaSamples();
-  const Int          iHeight         = sps.getPicHeightInLumaSamples();
-  const UInt         uiMaxCuWidth    = sps.getMaxCUWidth();
-  const UInt         uiMaxCuHeight   = sps.getMaxCUHeight();
-  const UInt         uiMaxDepth      = sps.getMaxTotalCUDepth();
-
   if (m_apcPicYuv[PIC_YUV_ORG    ]==NULL)
   {
-    m_apcPicYuv[PIC_YUV_ORG    ]   = new TComPicYuv;  m_apcPicYuv[PIC_YUV_ORG     ]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
+    m_apcPicYuv[PIC_YUV_ORG    ]   = xCreatePicYuv( sps );
   }
   if (m_apcPicYuv[PIC_YUV_TRUE_ORG    ]==NULL)
   {
-    m_apcPicYuv[PIC_YUV_TRUE_ORG]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_TRUE_ORG]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
+    m_apcPicYuv[PIC_YUV_TRUE_ORG]  = xCreatePicYuv( sps );
   }
 }
 
 Void TComPic::prepareForReconstruction()
 {
+  m_compressedRec.clear();
   if (m_apcPicYuv[PIC_YUV_REC] == NULL)
   {
-    const TComSPS &sps=m_picSym.getSPS();
-    const ChromaFormat chromaFormatIDC = sps.getChromaFormatIdc();
-    const Int          iWidth          = sps.getPicWidthInLumaSamples();
-    const Int          iHeight         = sps.getPicHeightInLumaSamples();
-    const UInt         uiMaxCuWidth    = sps.getMaxCUWidth();
-    const UInt         uiMaxCuHeight   = sps.getMaxCUHeight();
-    const UInt         uiMaxDepth      = sps.getMaxTotalCUDepth();
-
-    m_apcPicYuv[PIC_YUV_REC]  = new TComPicYuv;  m_apcPicYuv[PIC_YUV_REC]->create( iWidth, iHeight, chromaFormatIDC, uiMaxCuWidth, uiMaxCuHeight, uiMaxDepth, true );
+    m_apcPicYuv[PIC_YUV_REC]  = xCreatePicYuv( m_picSym.getSPS() );
   }
 
   // mark it should be extended
@@ -160,29 +153,76 @@ Void TComPic::releaseReconstructionIntermediateData()
 
 Void TComPic::releaseEncoderSourceImageData()
 {
-  if (m_apcPicYuv[PIC_YUV_ORG    ])
+  xReleasePicYuv(PIC_YUV_ORG);
+  xReleasePicYuv(PIC_YUV_TRUE_ORG);
+  xDestroyPicYuvOrgTiles();
+}
+
+Void TComPic::releaseAllReconstructionData()
+{
+  m_compressedRec.clear();
+  xReleasePicYuv(PIC_YUV_REC);
+  m_picSym.releaseAllReconstructionData();
+}
+
+Void TComPic::compressReconstruction()
+{
+  if (m_apcPicYuv[PIC_YUV_REC] != NULL)
   {
-    m_apcPicYuv[PIC_YUV_ORG]->destroy();
-    delete m_apcPicYuv[PIC_YUV_ORG];
-    m_apcPicYuv[PIC_YUV_ORG] = NULL;
+    const TComSPS &sps = m_picSym.getSPS();
+    m_compressedRec.compress( m_apcPicYuv[PIC_YUV_REC], sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getBitDepths() );
+    xReleasePicYuv(PIC_YUV_REC);
   }
-  if (m_apcPicYuv[PIC_YUV_TRUE_ORG    ])
+}
+
+Void TComPic::decompressReconstruction()
+{
+  if (isReconstructionCompressed())
   {
-    m_apcPicYuv[PIC_YUV_TRUE_ORG]->destroy();
-    delete m_apcPicYuv[PIC_YUV_TRUE_ORG];
-    m_apcPicYuv[PIC_YUV_TRUE_ORG] = NULL;
+    m_apcPicYuv[PIC_YUV_REC] = xCreatePicYuv( m_picSym.getSPS() );
+    m_compressedRec.decompress( m_apcPicYuv[PIC_YUV_REC] );
+    m_compressedRec.clear();
+
+    // the buffer may come from another picture: drop what was derived from its samples and extend the new ones
+    if (m_apcPicYuv[PIC_YUV_REC]->getSubPelPlanes() != NULL)
+    {
+      m_apcPicYuv[PIC_YUV_REC]->getSubPelPlanes()->reset();
+    }
+    m_apcPicYuv[PIC_YUV_REC]->invalidateLuma8();
+    m_apcPicYuv[PIC_YUV_REC]->setBorderExtension(false);
+    m_apcPicYuv[PIC_YUV_REC]->extendPicBorder();
   }
 }
 
-Void TComPic::releaseAllReconstructionData()
+/** get a picture buffer with the geometry of the SPS, from the buffer pool if one is set
+ */
+TComPicYuv* TComPic::xCreatePicYuv( const TComSPS &sps )
 {
-  if (m_apcPicYuv[PIC_YUV_REC    ])
+  if (m_pcBufferPool != NULL)
   {
-    m_apcPicYuv[PIC_YUV_REC]->destroy();
-    delete m_apcPicYuv[PIC_YUV_REC];
-    m_apcPicYuv[PIC_YUV_REC] = NULL;
+    return m_pcBufferPool->getPicYuv( sps );
+  }
+
+  TComPicYuv *pcPicYuv = new TComPicYuv;
+  pcPicYuv->create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxTotalCUDepth(), true );
+  return pcPicYuv;
+}
+
+Void TComPic::xReleasePicYuv( const PIC_YUV_T picYuvType )
+{
+  if (m_apcPicYuv[picYuvType])
+  {
+    if (m_pcBufferPool != NULL)
+    {
+      m_pcBufferPool->recyclePicYuv( m_apcPicYuv[picYuvType], m_picSym.getSPS() );
+    }
+    else
+    {
+      m_apcPicYuv[picYuvType]->destroy();
+      delete m_apcPicYuv[picYuvType];
+    }
+    m_apcPicYuv[picYuvType] = NULL;
   }
-  m_picSym.releaseAllReconstructionData();
 }
 #endif
 
@@ -192,17 +232,54 @@ Void TComPic::destroy()
 
   for(UInt i=0; i<NUM_PIC_YUV; i++)
   {
+#if REDUCED_ENCODER_MEMORY
+    xReleasePicYuv(PIC_YUV_T(i));
+#else
     if (m_apcPicYuv[i])
     {
       m_apcPicYuv[i]->destroy();
       delete m_apcPicYuv[i];
       m_apcPicYuv[i]  = NULL;
     }
+#endif
   }
+  xDestroyPicYuvOrgTiles();
 
   deleteSEIs(m_SEIs);
 }
 
+Void TComPic::copyPicYuvOrgToTiles()
+{
+  if (m_pcPicYuvOrgTiles == NULL)
+  {
+    const TComSPS &sps = m_picSym.getSPS();
+    std::vector<Int> tileColumnWidths(m_picSym.getNumTileColumnsMinus1() + 1);
+    std::vector<Int> tileRowHeights  (m_picSym.getNumTileRowsMinus1() + 1);
+    for (Int col = 0; col < Int(tileColumnWidths.size()); col++)
+    {
+      tileColumnWidths[col] = m_picSym.getTComTile(col)->getTileWidthInCtus();
+    }
+    for (Int row = 0; row < Int(tileRowHeights.size()); row++)
+    {
+      tileRowHeights[row] = m_picSym.getTComTile(row * Int(tileColumnWidths.size()))->getTileHeightInCtus();
+    }
+
+    m_pcPicYuvOrgTiles = new TComPicYuv;
+    m_pcPicYuvOrgTiles->createTileMajor( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxTotalCUDepth(), tileColumnWidths, tileRowHeights, false );
+  }
+  m_apcPicYuv[PIC_YUV_ORG]->copyToPicByCtus( m_pcPicYuvOrgTiles );
+}
+
+Void TComPic::xDestroyPicYuvOrgTiles()
+{
+  if (m_pcPicYuvOrgTiles)
+  {
+    m_pcPicYuvOrgTiles->destroy();
+    delete m_pcPicYuvOrgTiles;
+    m_pcPicYuvOrgTiles = NULL;
+  }
+}
+
 Void TComPic::compressMotion()
 {
   TComPicSym* pPicSym = getPicSym();
@@ -43,6 +43,10 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#if REDUCED_ENCODER_MEMORY
+#include "TComPicBufferPool.h"
+#include "TComCompressedPicYuv.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -66,6 +70,11 @@ private:
   Bool                  m_bIsLongTerm;            //  IS long term picture
   TComPicSym            m_picSym;                 //  Symbol
   TComPicYuv*           m_apcPicYuv[NUM_PIC_YUV];
+  TComPicYuv*           m_pcPicYuvOrgTiles;       //  tile-major copy of the original picture, NULL when not used
+#if REDUCED_ENCODER_MEMORY
+  TComPicBufferPool*    m_pcBufferPool;           //  pool the buffers are taken from and returned to, NULL to allocate them here
+  TComCompressedPicYuv  m_compressedRec;          //  reconstruction while it is kept compressed, empty otherwise
+#endif
 
   TComPicYuv*           m_pcPicYuvPred;           //  Prediction
   TComPicYuv*           m_pcPicYuvResi;           //  Residual
@@ -81,6 +90,12 @@ private:
 
   SEIMessages  m_SEIs; ///< Any SEI messages that have been received.  If !NULL we own the object.
 
+  Void          xDestroyPicYuvOrgTiles();
+#if REDUCED_ENCODER_MEMORY
+  TComPicYuv*   xCreatePicYuv ( const TComSPS &sps );
+  Void          xReleasePicYuv( const PIC_YUV_T picYuvType );
+#endif
+
 public:
   TComPic();
   virtual ~TComPic();
@@ -92,6 +107,10 @@ public:
   Void          releaseReconstructionIntermediateData();
   Void          releaseAllReconstructionData();
   Void          releaseEncoderSourceImageData();
+  Void          compressReconstruction();       ///< keep the reconstruction compressed, and release its buffer
+  Void          decompressReconstruction();     ///< restore the reconstruction if it is kept compressed
+  Bool          isReconstructionCompressed() const { return !m_compressedRec.isEmpty(); }
+  Void          setBufferPool( TComPicBufferPool* pcBufferPool ) { m_pcBufferPool = pcBufferPool; m_picSym.setBufferPool( pcBufferPool ); } ///< to be called before create()
 #else
   Void          create( const TComSPS &sps, const TComPPS &pps, const Bool bIsVirtual /*= false*/ );
 #endif
@@ -117,6 +136,8 @@ public:
   const TComDataCU* getCtu( UInt ctuRsAddr ) const { return  m_picSym.getCtu( ctuRsAddr ); }
 
   TComPicYuv*   getPicYuvOrg()        { return  m_apcPicYuv[PIC_YUV_ORG]; }
+  TComPicYuv*   getPicYuvOrgForCtuAccess() { return m_pcPicYuvOrgTiles != NULL ? m_pcPicYuvOrgTiles : m_apcPicYuv[PIC_YUV_ORG]; } ///< the original picture to be read by CTU, in tile-major layout when there is a copy
+  Void          copyPicYuvOrgToTiles();                       ///< copy the original picture to its tile-major copy, created with the tiles of the picture when needed
   TComPicYuv*   getPicYuvRec()        { return  m_apcPicYuv[PIC_YUV_REC]; }
 
   TComPicYuv*   getPicYuvPred()       { return  m_pcPicYuvPred; }
@@ -0,0 +1,224 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComPicBufferPool.cpp
+    \brief    pool of picture buffers recycled between the pictures of an encoder
+*/
+
+#include <assert.h>
+#include "TComPicBufferPool.h"
+
+#if REDUCED_ENCODER_MEMORY
+
+//! \ingroup TLibCommon
+//! \{
+
+TComPicBufferPool::TComPicBufferPool()
+: m_bHasGeometry     ( false )
+, m_picWidth         ( 0 )
+, m_picHeight        ( 0 )
+, m_chromaFormatIDC  ( CHROMA_420 )
+, m_maxCUWidth       ( 0 )
+, m_maxCUHeight      ( 0 )
+, m_maxTotalCUDepth  ( 0 )
+, m_numCtusInFrame   ( 0 )
+#if ADAPTIVE_QP_SELECTION
+, m_pParentARLBuffer ( NULL )
+#endif
+{
+}
+
+TComPicBufferPool::~TComPicBufferPool()
+{
+  destroy();
+}
+
+Void TComPicBufferPool::destroy()
+{
+  xFreeIdleBuffers();
+  m_bHasGeometry = false;
+
+#if ADAPTIVE_QP_SELECTION
+  if( m_pParentARLBuffer != NULL )
+  {
+    delete [] m_pParentARLBuffer;
+    m_pParentARLBuffer = NULL;
+  }
+#endif
+}
+
+Bool TComPicBufferPool::xMatchesGeometry( const TComSPS &sps ) const
+{
+  return m_bHasGeometry
+      && m_picWidth        == sps.getPicWidthInLumaSamples()
+      && m_picHeight       == sps.getPicHeightInLumaSamples()
+      && m_chromaFormatIDC == sps.getChromaFormatIdc()
+      && m_maxCUWidth      == sps.getMaxCUWidth()
+      && m_maxCUHeight     == sps.getMaxCUHeight()
+      && m_maxTotalCUDepth == sps.getMaxTotalCUDepth();
+}
+
+Void TComPicBufferPool::xSetGeometry( const TComSPS &sps )
+{
+  if( xMatchesGeometry( sps ) )
+  {
+    return;
+  }
+
+  xFreeIdleBuffers();
+
+  m_bHasGeometry    = true;
+  m_picWidth        = sps.getPicWidthInLumaSamples();
+  m_picHeight       = sps.getPicHeightInLumaSamples();
+  m_chromaFormatIDC = sps.getChromaFormatIdc();
+  m_maxCUWidth      = sps.getMaxCUWidth();
+  m_maxCUHeight     = sps.getMaxCUHeight();
+  m_maxTotalCUDepth = sps.getMaxTotalCUDepth();
+  m_numCtusInFrame  = TComPicSym::getNumCtusInFrame( sps );
+}
+
+Void TComPicBufferPool::xFreeIdleBuffers()
+{
+  for( UInt i = 0; i < m_idlePicYuv.size(); i++ )
+  {
+    m_idlePicYuv[i]->destroy();
+    delete m_idlePicYuv[i];
+  }
+  m_idlePicYuv.clear();
+
+  for( UInt i = 0; i < m_idleCtuArrays.size(); i++ )
+  {
+    TComPicSym::destroyCtuArray( m_idleCtuArrays[i], m_numCtusInFrame );
+  }
+  m_idleCtuArrays.clear();
+
+  for( UInt i = 0; i < m_idleDPBPerCtuData.size(); i++ )
+  {
+    TComPicSym::destroyDPBPerCtuData( m_idleDPBPerCtuData[i], m_numCtusInFrame );
+  }
+  m_idleDPBPerCtuData.clear();
+}
+
+TComPicYuv* TComPicBufferPool::getPicYuv( const TComSPS &sps )
+{
+  xSetGeometry( sps );
+
+  if( !m_idlePicYuv.empty() )
+  {
+    TComPicYuv* pcPicYuv = m_idlePicYuv.back();
+    m_idlePicYuv.pop_back();
+    return pcPicYuv;
+  }
+
+  TComPicYuv* pcPicYuv = new TComPicYuv;
+  pcPicYuv->create( m_picWidth, m_picHeight, m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, true );
+  return pcPicYuv;
+}
+
+Void TComPicBufferPool::recyclePicYuv( TComPicYuv* pcPicYuv, const TComSPS &sps )
+{
+  if( xMatchesGeometry( sps ) )
+  {
+    m_idlePicYuv.push_back( pcPicYuv );
+  }
+  else
+  {
+    pcPicYuv->destroy();
+    delete pcPicYuv;
+  }
+}
+
+TComDataCU** TComPicBufferPool::getCtuArray( const TComSPS &sps )
+{
+  xSetGeometry( sps );
+
+  if( !m_idleCtuArrays.empty() )
+  {
+    TComDataCU** ppcCtus = m_idleCtuArrays.back();
+    m_idleCtuArrays.pop_back();
+    return ppcCtus;
+  }
+
+#if ADAPTIVE_QP_SELECTION
+  if( m_pParentARLBuffer == NULL )
+  {
+    m_pParentARLBuffer = new TCoeff[MAX_CU_SIZE*MAX_CU_SIZE*MAX_NUM_COMPONENT];
+  }
+  return TComPicSym::createCtuArray( sps, m_pParentARLBuffer );
+#else
+  return TComPicSym::createCtuArray( sps, NULL );
+#endif
+}
+
+Void TComPicBufferPool::recycleCtuArray( TComDataCU** ppcCtus, const TComSPS &sps )
+{
+  if( xMatchesGeometry( sps ) )
+  {
+    m_idleCtuArrays.push_back( ppcCtus );
+  }
+  else
+  {
+    TComPicSym::destroyCtuArray( ppcCtus, TComPicSym::getNumCtusInFrame( sps ) );
+  }
+}
+
+TComPicSym::DPBPerCtuData* TComPicBufferPool::getDPBPerCtuData( const TComSPS &sps )
+{
+  xSetGeometry( sps );
+
+  if( !m_idleDPBPerCtuData.empty() )
+  {
+    TComPicSym::DPBPerCtuData* pData = m_idleDPBPerCtuData.back();
+    m_idleDPBPerCtuData.pop_back();
+    TComPicSym::resetDPBPerCtuData( pData, sps );
+    return pData;
+  }
+
+  return TComPicSym::createDPBPerCtuData( sps );
+}
+
+Void TComPicBufferPool::recycleDPBPerCtuData( TComPicSym::DPBPerCtuData* pData, const TComSPS &sps )
+{
+  if( xMatchesGeometry( sps ) )
+  {
+    m_idleDPBPerCtuData.push_back( pData );
+  }
+  else
+  {
+    TComPicSym::destroyDPBPerCtuData( pData, TComPicSym::getNumCtusInFrame( sps ) );
+  }
+}
+
+//! \}
+
+#endif // REDUCED_ENCODER_MEMORY
@@ -0,0 +1,102 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComPicBufferPool.h
+    \brief    pool of picture buffers recycled between the pictures of an encoder (header)
+*/
+
+#ifndef __TCOMPICBUFFERPOOL__
+#define __TCOMPICBUFFERPOOL__
+
+#include <vector>
+#include "CommonDef.h"
+#include "TComPicSym.h"
+#include "TComPicYuv.h"
+
+#if REDUCED_ENCODER_MEMORY
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Picture buffers released by the pictures of an encoder (sample planes with margins, CTU arrays and the motion data
+ *  kept for TMVP) are held here and handed out again to the next picture that needs them, so that in steady state the
+ *  encoder does not allocate or free them. All buffers have the geometry of one SPS; a picture with a different
+ *  geometry makes the pool free its idle buffers and start again with the new geometry.
+ */
+class TComPicBufferPool
+{
+private:
+  Bool                                     m_bHasGeometry;
+  UInt                                     m_picWidth;
+  UInt                                     m_picHeight;
+  ChromaFormat                             m_chromaFormatIDC;
+  UInt                                     m_maxCUWidth;
+  UInt                                     m_maxCUHeight;
+  UInt                                     m_maxTotalCUDepth;
+  UInt                                     m_numCtusInFrame;
+
+#if ADAPTIVE_QP_SELECTION
+  TCoeff*                                  m_pParentARLBuffer;      ///< shared by the CTUs of all CTU arrays of the pool, freed by destroy() only
+#endif
+  std::vector<TComPicYuv*>                 m_idlePicYuv;
+  std::vector<TComDataCU**>                m_idleCtuArrays;
+  std::vector<TComPicSym::DPBPerCtuData*>  m_idleDPBPerCtuData;
+
+  Bool  xMatchesGeometry ( const TComSPS &sps ) const;
+  Void  xSetGeometry     ( const TComSPS &sps );
+  Void  xFreeIdleBuffers ();
+
+public:
+  TComPicBufferPool();
+  ~TComPicBufferPool();
+
+  /// frees all buffers held by the pool (buffers still used by pictures are freed when returned)
+  Void                        destroy             ();
+
+  TComPicYuv*                 getPicYuv           ( const TComSPS &sps );
+  Void                        recyclePicYuv       ( TComPicYuv* pcPicYuv, const TComSPS &sps );
+  TComDataCU**                getCtuArray         ( const TComSPS &sps );
+  Void                        recycleCtuArray     ( TComDataCU** ppcCtus, const TComSPS &sps );
+  TComPicSym::DPBPerCtuData*  getDPBPerCtuData    ( const TComSPS &sps );
+  Void                        recycleDPBPerCtuData( TComPicSym::DPBPerCtuData* pData, const TComSPS &sps );
+};
+
+//! \}
+
+#endif // REDUCED_ENCODER_MEMORY
+
+#endif // __TCOMPICBUFFERPOOL__
@@ -38,6 +38,9 @@
 #include "TComPicSym.h"
 #include "TComSampleAdaptiveOffset.h"
 #include "TComSlice.h"
+#if REDUCED_ENCODER_MEMORY
+#include "TComPicBufferPool.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -65,6 +68,7 @@ TComPicSym::TComPicSym()
 ,m_ctuRsToTsAddrMap(NULL)
 #if REDUCED_ENCODER_MEMORY
 ,m_dpbPerCtuData(NULL)
+,m_pcBufferPool(NULL)
 #endif
 ,m_saoBlkParams(NULL)
 #if ADAPTIVE_QP_SELECTION
@@ -165,38 +169,24 @@ Void TComPicSym::create  ( const TComSPS &sps, const TComPPS &pps, UInt uiMaxDep
 #if REDUCED_ENCODER_MEMORY
 Void TComPicSym::prepareForReconstruction()
 {
-  const ChromaFormat chromaFormatIDC = m_sps.getChromaFormatIdc();
-  const UInt uiMaxCuWidth  = m_sps.getMaxCUWidth();
-  const UInt uiMaxCuHeight = m_sps.getMaxCUHeight();
   if (m_pictureCtuArray == NULL)
   {
-    m_pictureCtuArray = new TComDataCU*[m_numCtusInFrame];
-
-    for (UInt i=0; i<m_numCtusInFrame ; i++ )
+    if (m_pcBufferPool != NULL)
+    {
+      m_pictureCtuArray = m_pcBufferPool->getCtuArray(m_sps);
+    }
+    else
     {
-      m_pictureCtuArray[i] = new TComDataCU;
-      m_pictureCtuArray[i]->create( chromaFormatIDC, m_numPartitionsInCtu, uiMaxCuWidth, uiMaxCuHeight, false, uiMaxCuWidth >> m_uhTotalDepth
 #if ADAPTIVE_QP_SELECTION
-        , m_pParentARLBuffer
+      m_pictureCtuArray = createCtuArray(m_sps, m_pParentARLBuffer);
+#else
+      m_pictureCtuArray = createCtuArray(m_sps, NULL);
 #endif
-        );
     }
   }
   if (m_dpbPerCtuData == NULL)
   {
-    m_dpbPerCtuData = new DPBPerCtuData[m_numCtusInFrame];
-    for(UInt i=0; i<m_numCtusInFrame; i++)
-    {
-      for(Int j=0; j<NUM_REF_PIC_LIST_01; j++)
-      {
-        m_dpbPerCtuData[i].m_CUMvField[j].create( m_numPartitionsInCtu );
-      }
-      m_dpbPerCtuData[i].m_pePredMode = new SChar[m_numPartitionsInCtu];
-      memset(m_dpbPerCtuData[i].m_pePredMode, NUMBER_OF_PREDICTION_MODES, m_numPartitionsInCtu);
-      m_dpbPerCtuData[i].m_pePartSize = new SChar[m_numPartitionsInCtu];
-      memset(m_dpbPerCtuData[i].m_pePartSize, NUMBER_OF_PART_SIZES, m_numPartitionsInCtu);
-      m_dpbPerCtuData[i].m_pSlice=NULL;
-    }
+    m_dpbPerCtuData = (m_pcBufferPool != NULL) ? m_pcBufferPool->getDPBPerCtuData(m_sps) : createDPBPerCtuData(m_sps);
   }
 }
 
@@ -204,16 +194,14 @@ Void TComPicSym::releaseReconstructionIntermediateData()
 {
   if (m_pictureCtuArray)
   {
-    for (Int i = 0; i < m_numCtusInFrame; i++)
+    if (m_pcBufferPool != NULL)
     {
-      if (m_pictureCtuArray[i])
-      {
-        m_pictureCtuArray[i]->destroy();
-        delete m_pictureCtuArray[i];
-        m_pictureCtuArray[i] = NULL;
-      }
+      m_pcBufferPool->recycleCtuArray(m_pictureCtuArray, m_sps);
+    }
+    else
+    {
+      destroyCtuArray(m_pictureCtuArray, m_numCtusInFrame);
     }
-    delete [] m_pictureCtuArray;
     m_pictureCtuArray = NULL;
   }
 }
@@ -224,19 +212,137 @@ Void TComPicSym::releaseAllReconstructionData()
 
   if (m_dpbPerCtuData != NULL)
   {
-    for(UInt i=0; i<m_numCtusInFrame; i++)
+    if (m_pcBufferPool != NULL)
     {
-      for(Int j=0; j<NUM_REF_PIC_LIST_01; j++)
-      {
-        m_dpbPerCtuData[i].m_CUMvField[j].destroy();
-      }
-      delete [] m_dpbPerCtuData[i].m_pePredMode;
-      delete [] m_dpbPerCtuData[i].m_pePartSize;
+      m_pcBufferPool->recycleDPBPerCtuData(m_dpbPerCtuData, m_sps);
+    }
+    else
+    {
+      destroyDPBPerCtuData(m_dpbPerCtuData, m_numCtusInFrame);
     }
-    delete [] m_dpbPerCtuData;
     m_dpbPerCtuData=NULL;
   }
 }
+
+UInt TComPicSym::getNumCtusInFrame(const TComSPS &sps)
+{
+  const UInt uiMaxCuWidth  = sps.getMaxCUWidth();
+  const UInt uiMaxCuHeight = sps.getMaxCUHeight();
+  const UInt frameWidthInCtus  = (sps.getPicWidthInLumaSamples()  + uiMaxCuWidth  - 1) / uiMaxCuWidth;
+  const UInt frameHeightInCtus = (sps.getPicHeightInLumaSamples() + uiMaxCuHeight - 1) / uiMaxCuHeight;
+  return frameWidthInCtus * frameHeightInCtus;
+}
+
+/** allocate the CTUs of a picture
+ * \param sps               SPS of the picture
+ * \param pParentARLBuffer  buffer shared by the CTUs for the adaptive reconstruction levels
+ */
+TComDataCU** TComPicSym::createCtuArray(const TComSPS &sps, TCoeff *pParentARLBuffer)
+{
+  const ChromaFormat chromaFormatIDC    = sps.getChromaFormatIdc();
+  const UInt         uiMaxCuWidth       = sps.getMaxCUWidth();
+  const UInt         uiMaxCuHeight      = sps.getMaxCUHeight();
+  const UInt         uiTotalDepth       = sps.getMaxTotalCUDepth();
+  const UInt         numPartitionsInCtu = 1<<(uiTotalDepth<<1);
+  const UInt         numCtusInFrame     = getNumCtusInFrame(sps);
+
+  TComDataCU** ppcCtus = new TComDataCU*[numCtusInFrame];
+  for (UInt i=0; i<numCtusInFrame ; i++ )
+  {
+    ppcCtus[i] = new TComDataCU;
+    ppcCtus[i]->create( chromaFormatIDC, numPartitionsInCtu, uiMaxCuWidth, uiMaxCuHeight, false, uiMaxCuWidth >> uiTotalDepth
+#if ADAPTIVE_QP_SELECTION
+      , pParentARLBuffer
+#endif
+      );
+  }
+  return ppcCtus;
+}
+
+Void TComPicSym::destroyCtuArray(TComDataCU** ppcCtus, const UInt numCtusInFrame)
+{
+  for (UInt i = 0; i < numCtusInFrame; i++)
+  {
+    if (ppcCtus[i])
+    {
+      ppcCtus[i]->destroy();
+      delete ppcCtus[i];
+    }
+  }
+  delete [] ppcCtus;
+}
+
+/** allocate the motion data kept for TMVP for the CTUs of a picture
+ * \param sps  SPS of the picture
+ */
+TComPicSym::DPBPerCtuData* TComPicSym::createDPBPerCtuData(const TComSPS &sps)
+{
+  const UInt numPartitionsInCtu = 1<<(sps.getMaxTotalCUDepth()<<1);
+  const UInt uiMinCUWidth       = sps.getMaxCUWidth() >> sps.getMaxTotalCUDepth();
+  const UInt numCtusInFrame     = getNumCtusInFrame(sps);
+
+  // one entry per block of identical motion after TComDataCU::compressMV
+  const UInt scaleFactor       = std::max<UInt>(1, 4 * AMVP_DECIMATION_FACTOR / uiMinCUWidth);
+  UInt       log2PartsPerBlock = 0;
+  while ((1u << log2PartsPerBlock) < scaleFactor * scaleFactor)
+  {
+    log2PartsPerBlock++;
+  }
+  const UInt numBlocks         = numPartitionsInCtu >> log2PartsPerBlock;
+  assert(numBlocks > 0);
+
+  DPBPerCtuData *pData = new DPBPerCtuData[numCtusInFrame];
+  for(UInt i=0; i<numCtusInFrame; i++)
+  {
+    for(Int j=0; j<NUM_REF_PIC_LIST_01; j++)
+    {
+      pData[i].m_pcMv[j]     = new TComMv[numBlocks];
+      pData[i].m_piRefIdx[j] = new SChar[numBlocks];
+    }
+    pData[i].m_pePredMode = new SChar[numBlocks];
+    pData[i].m_pePartSize = new SChar[numBlocks];
+    pData[i].m_log2PartsPerBlock = log2PartsPerBlock;
+  }
+  resetDPBPerCtuData(pData, sps);
+  return pData;
+}
+
+/** mark the motion data of all CTUs as not available
+ * \param pData  motion data created by createDPBPerCtuData
+ * \param sps    SPS the data was created for
+ */
+Void TComPicSym::resetDPBPerCtuData(DPBPerCtuData* pData, const TComSPS &sps)
+{
+  const UInt numPartitionsInCtu = 1<<(sps.getMaxTotalCUDepth()<<1);
+  const UInt numCtusInFrame     = getNumCtusInFrame(sps);
+
+  for(UInt i=0; i<numCtusInFrame; i++)
+  {
+    const UInt numBlocks = numPartitionsInCtu >> pData[i].m_log2PartsPerBlock;
+    for(Int j=0; j<NUM_REF_PIC_LIST_01; j++)
+    {
+      memset(pData[i].m_piRefIdx[j], NOT_VALID, numBlocks);
+    }
+    memset(pData[i].m_pePredMode, NUMBER_OF_PREDICTION_MODES, numBlocks);
+    memset(pData[i].m_pePartSize, NUMBER_OF_PART_SIZES, numBlocks);
+    pData[i].m_pSlice=NULL;
+  }
+}
+
+Void TComPicSym::destroyDPBPerCtuData(DPBPerCtuData* pData, const UInt numCtusInFrame)
+{
+  for(UInt i=0; i<numCtusInFrame; i++)
+  {
+    for(Int j=0; j<NUM_REF_PIC_LIST_01; j++)
+    {
+      delete [] pData[i].m_pcMv[j];
+      delete [] pData[i].m_piRefIdx[j];
+    }
+    delete [] pData[i].m_pePredMode;
+    delete [] pData[i].m_pePartSize;
+  }
+  delete [] pData;
+}
 #endif
 
 Void TComPicSym::destroy()
@@ -46,6 +46,9 @@
 #include "TComDataCU.h"
 class TComSampleAdaptiveOffset;
 class TComPPS;
+#if REDUCED_ENCODER_MEMORY
+class TComPicBufferPool;
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -107,21 +110,27 @@ private:
 
 #if REDUCED_ENCODER_MEMORY
 public:
+  // motion data of a CTU kept for TMVP, stored once per 16x16 block (the granularity of the compressed motion)
+  // rather than once per partition; the accessors take the address of any partition in the block.
   struct DPBPerCtuData
   {
-    Bool isInter(const UInt absPartAddr)                const { return m_pePredMode[absPartAddr] == MODE_INTER; }
-    PartSize getPartitionSize( const UInt absPartAddr ) const { return static_cast<PartSize>( m_pePartSize[absPartAddr] ); }
-    const TComCUMvField* getCUMvField ( RefPicList e )  const { return &m_CUMvField[e];                  }
+    Bool isInter(const UInt absPartAddr)                const { return m_pePredMode[absPartAddr >> m_log2PartsPerBlock] == MODE_INTER; }
+    PartSize getPartitionSize( const UInt absPartAddr ) const { return static_cast<PartSize>( m_pePartSize[absPartAddr >> m_log2PartsPerBlock] ); }
+    const TComMv& getMv( RefPicList e, const UInt absPartAddr ) const { return m_pcMv[e][absPartAddr >> m_log2PartsPerBlock]; }
+    Int getRefIdx( RefPicList e, const UInt absPartAddr ) const       { return m_piRefIdx[e][absPartAddr >> m_log2PartsPerBlock]; }
     const TComSlice* getSlice()                         const { return m_pSlice; }
 
     SChar        * m_pePredMode;
     SChar        * m_pePartSize;
-    TComCUMvField  m_CUMvField[NUM_REF_PIC_LIST_01];
+    TComMv       * m_pcMv[NUM_REF_PIC_LIST_01];
+    SChar        * m_piRefIdx[NUM_REF_PIC_LIST_01];
+    UInt           m_log2PartsPerBlock;         ///< log2 of the number of partitions per 16x16 block
     TComSlice    * m_pSlice;
   };
 
 private:
   DPBPerCtuData *m_dpbPerCtuData;
+  TComPicBufferPool *m_pcBufferPool;      ///< pool the CTU array and DPB data are taken from and returned to, NULL to allocate them here
 #endif
   SAOBlkParam  *m_saoBlkParams;
 #if ADAPTIVE_QP_SELECTION
@@ -143,6 +152,14 @@ public:
   Void               prepareForReconstruction();
   Void               releaseReconstructionIntermediateData();
   Void               releaseAllReconstructionData();
+  Void               setBufferPool( TComPicBufferPool* pcBufferPool )      { m_pcBufferPool = pcBufferPool; }
+
+  static UInt           getNumCtusInFrame   ( const TComSPS &sps );
+  static TComDataCU**   createCtuArray      ( const TComSPS &sps, TCoeff *pParentARLBuffer );
+  static Void           destroyCtuArray     ( TComDataCU** ppcCtus, const UInt numCtusInFrame );
+  static DPBPerCtuData* createDPBPerCtuData ( const TComSPS &sps );
+  static Void           resetDPBPerCtuData  ( DPBPerCtuData* pData, const TComSPS &sps );
+  static Void           destroyDPBPerCtuData( DPBPerCtuData* pData, const UInt numCtusInFrame );
 #else
   Void               create  ( const TComSPS &sps, const TComPPS &pps, UInt uiMaxDepth );
 #endif
@@ -44,20 +44,72 @@
 #else
 #include <malloc.h>
 #endif
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #include "TComPicYuv.h"
+#include "TComSubPelPlanes.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
 
 //! \ingroup TLibCommon
 //! \{
 
+static const size_t LARGE_PAGE_SIZE  = 2 * 1024 * 1024;
+static const Int    BUFFER_ALIGNMENT = 64;    ///< alignment (in bytes) of the rows and picture areas of large page buffers
+
+/** allocate a buffer aligned to BUFFER_ALIGNMENT bytes. Buffers of at least LARGE_PAGE_SIZE bytes are
+ *  aligned to and padded to whole large pages, and marked for transparent huge pages where supported.
+ */
+static Void* allocateLargePageBuffer( size_t size )
+{
+#ifdef _WIN32
+  return _aligned_malloc( size, BUFFER_ALIGNMENT );
+#else
+  const Bool bLargePages = size >= LARGE_PAGE_SIZE;
+  if( bLargePages )
+  {
+    size = ( size + LARGE_PAGE_SIZE - 1 ) / LARGE_PAGE_SIZE * LARGE_PAGE_SIZE;
+  }
+  Void* pBuf = NULL;
+  if( posix_memalign( &pBuf, bLargePages ? LARGE_PAGE_SIZE : BUFFER_ALIGNMENT, size ) != 0 )
+  {
+    return NULL;
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if( bLargePages )
+  {
+    madvise( pBuf, size, MADV_HUGEPAGE );  // only advice, normal pages are used when no huge pages are available
+  }
+#endif
+  return pBuf;
+#endif
+}
+
+static Void freeLargePageBuffer( Void* pBuf )
+{
+#ifdef _WIN32
+  _aligned_free( pBuf );
+#else
+  free( pBuf );
+#endif
+}
+
+Bool TComPicYuv::s_bLargePagePlanes = false;
+
 TComPicYuv::TComPicYuv()
 {
   for(UInt i=0; i<MAX_NUM_COMPONENT; i++)
   {
-    m_apiPicBuf[i]    = NULL;   // Buffer (including margin)
-    m_piPicOrg[i]     = NULL;    // m_apiPicBufY + m_iMarginLuma*getStride() + m_iMarginLuma
+    m_apiPicBuf[i]      = NULL;   // Buffer (including margin)
+    m_apiPicBufAlloc[i] = NULL;
+    m_piPicOrg[i]       = NULL;    // m_apiPicBufY + m_iMarginLuma*getStride() + m_iMarginLuma
   }
+  m_bLargePageBuffers = false;
+  m_stride            = 0;
+  m_ctuWidth          = 0;
+  m_ctuHeight         = 0;
+  m_bTileMajor        = false;
 
   for(UInt i=0; i<MAX_NUM_CHANNEL_TYPE; i++)
   {
@@ -66,6 +118,9 @@ TComPicYuv::TComPicYuv()
   }
 
   m_bIsBorderExtended = false;
+  m_pcSubPelPlanes    = NULL;
+  m_piLuma8Buf        = NULL;
+  m_bLuma8Valid       = false;
 }
 
 
@@ -94,19 +149,35 @@ Void TComPicYuv::createWithoutCUInfo ( const Int picWidth,                 ///<
   m_marginX          = (bUseMargin?maxCUWidth:0) + 16;   // for 16-byte alignment
   m_marginY          = (bUseMargin?maxCUHeight:0) + 16;  // margin for 8-tap filter and infinite padding
   m_bIsBorderExtended = false;
+  m_bLargePageBuffers = s_bLargePagePlanes;
+  m_stride            = xGetAlignedStride( m_picWidth + ( m_marginX << 1 ) );
 
   // assign the picture arrays and set up the ptr to the top left of the original picture
   for(UInt comp=0; comp<getNumberValidComponents(); comp++)
   {
     const ComponentID ch=ComponentID(comp);
-    m_apiPicBuf[comp] = (Pel*)xMalloc( Pel, getStride(ch) * getTotalHeight(ch));
-    m_piPicOrg[comp]  = m_apiPicBuf[comp] + (m_marginY >> getComponentScaleY(ch)) * getStride(ch) + (m_marginX >> getComponentScaleX(ch));
+    const Int originOffset = (m_marginY >> getComponentScaleY(ch)) * getStride(ch) + (m_marginX >> getComponentScaleX(ch));
+    if (m_bLargePageBuffers)
+    {
+      // start the buffer so that the top left sample of the picture is aligned
+      const Int sampleAlignment = BUFFER_ALIGNMENT / Int(sizeof(Pel));
+      const Int leadSamples     = ( sampleAlignment - originOffset % sampleAlignment ) % sampleAlignment;
+      m_apiPicBufAlloc[comp] = (Pel*)allocateLargePageBuffer( sizeof(Pel) * ( leadSamples + getStride(ch) * getTotalHeight(ch) ) );
+      m_apiPicBuf[comp]      = m_apiPicBufAlloc[comp] + leadSamples;
+    }
+    else
+    {
+      m_apiPicBufAlloc[comp] = (Pel*)xMalloc( Pel, getStride(ch) * getTotalHeight(ch));
+      m_apiPicBuf[comp]      = m_apiPicBufAlloc[comp];
+    }
+    m_piPicOrg[comp]  = m_apiPicBuf[comp] + originOffset;
   }
   // initialize pointers for unused components to NULL
   for(UInt comp=getNumberValidComponents();comp<MAX_NUM_COMPONENT; comp++)
   {
-    m_apiPicBuf[comp] = NULL;
-    m_piPicOrg[comp]  = NULL;
+    m_apiPicBuf[comp]      = NULL;
+    m_apiPicBufAlloc[comp] = NULL;
+    m_piPicOrg[comp]       = NULL;
   }
 
   for(Int chan=0; chan<MAX_NUM_CHANNEL_TYPE; chan++)
@@ -128,7 +199,8 @@ Void TComPicYuv::create ( const Int picWidth,                 ///< picture width
 
 {
   createWithoutCUInfo(picWidth, picHeight, chromaFormatIDC, bUseMargin, maxCUWidth, maxCUHeight);
-
+  m_ctuWidth  = maxCUWidth;
+  m_ctuHeight = maxCUHeight;
 
   const Int numCuInWidth  = m_picWidth  / maxCUWidth  + (m_picWidth  % maxCUWidth  != 0);
   const Int numCuInHeight = m_picHeight / maxCUHeight + (m_picHeight % maxCUHeight != 0);
@@ -148,6 +220,133 @@ Void TComPicYuv::create ( const Int picWidth,                 ///< picture width
         m_ctuOffsetInBuffer[chan][cuRow * numCuInWidth + cuCol] = stride * cuRow * ctuHeight + cuCol * ctuWidth;
       }
     }
+  }
+
+  xCreateSubCuOffsets(maxCUWidth, maxCUHeight, maxCUDepth);
+}
+
+Void TComPicYuv::createTileMajor ( const Int picWidth,                               ///< picture width
+                                   const Int picHeight,                              ///< picture height
+                                   const ChromaFormat chromaFormatIDC,               ///< chroma format
+                                   const UInt maxCUWidth,                            ///< CTU width
+                                   const UInt maxCUHeight,                           ///< CTU height
+                                   const UInt maxCUDepth,                            ///< used for generating offsets to CUs.
+                                   const std::vector<Int> &tileColumnWidthsInCtus,   ///< width of each tile column
+                                   const std::vector<Int> &tileRowHeightsInCtus,     ///< height of each tile row
+                                   const Bool bUseMargin)                            ///< if true, then a margin of uiMaxCUWidth+16 and uiMaxCUHeight+16 is created around each tile.
+{
+  destroy();
+
+  m_picWidth          = picWidth;
+  m_picHeight         = picHeight;
+  m_chromaFormatIDC   = chromaFormatIDC;
+  m_marginX           = (bUseMargin?maxCUWidth:0) + 16;
+  m_marginY           = (bUseMargin?maxCUHeight:0) + 16;
+  m_ctuWidth          = maxCUWidth;
+  m_ctuHeight         = maxCUHeight;
+  m_bIsBorderExtended = false;
+  m_bLargePageBuffers = s_bLargePagePlanes;
+  m_bTileMajor        = true;
+
+  // all tiles share the stride of the widest one, made of whole CTUs
+  const Int numCuInWidth  = m_picWidth  / maxCUWidth  + (m_picWidth  % maxCUWidth  != 0);
+  const Int numCuInHeight = m_picHeight / maxCUHeight + (m_picHeight % maxCUHeight != 0);
+  Int maxTileWidthInCtus = 0;
+  Int numCtusInColumns   = 0;
+  Int numCtusInRows      = 0;
+  for (Int col = 0; col < Int(tileColumnWidthsInCtus.size()); col++)
+  {
+    maxTileWidthInCtus = std::max(maxTileWidthInCtus, tileColumnWidthsInCtus[col]);
+    numCtusInColumns  += tileColumnWidthsInCtus[col];
+  }
+  for (Int row = 0; row < Int(tileRowHeightsInCtus.size()); row++)
+  {
+    numCtusInRows += tileRowHeightsInCtus[row];
+  }
+  assert(numCtusInColumns == numCuInWidth && numCtusInRows == numCuInHeight);
+  m_stride = xGetAlignedStride( maxTileWidthInCtus * maxCUWidth + ( m_marginX << 1 ) );
+
+  const Int numTileColumns  = Int(tileColumnWidthsInCtus.size());
+  const Int numTiles        = numTileColumns * Int(tileRowHeightsInCtus.size());
+  const Int sampleAlignment = BUFFER_ALIGNMENT / Int(sizeof(Pel));
+
+  for(Int chan=0; chan<MAX_NUM_CHANNEL_TYPE; chan++)
+  {
+    const ChannelType ch= ChannelType(chan);
+    const Int ctuHeight = maxCUHeight>>getChannelTypeScaleY(ch);
+    const Int ctuWidth  = maxCUWidth>>getChannelTypeScaleX(ch);
+    const Int stride    = getStride(ch);
+    const Int marginX   = m_marginX>>getChannelTypeScaleX(ch);
+    const Int marginY   = m_marginY>>getChannelTypeScaleY(ch);
+
+    // place the tiles one after the other, each starting so that the top left sample of the tile is aligned
+    std::vector<Int> tileOrigin(numTiles);
+    Int bufferSize = 0;
+    for (Int tileIdx = 0; tileIdx < numTiles; tileIdx++)
+    {
+      const Int tileHeight = tileRowHeightsInCtus[tileIdx / numTileColumns] * ctuHeight;
+      const Int origin     = bufferSize + marginY * stride + marginX;
+      tileOrigin[tileIdx]  = ( origin + sampleAlignment - 1 ) / sampleAlignment * sampleAlignment;
+      bufferSize           = tileOrigin[tileIdx] - marginY * stride - marginX + ( tileHeight + ( marginY << 1 ) ) * stride;
+    }
+
+    for(UInt comp=0; comp<getNumberValidComponents(); comp++)
+    {
+      if (toChannelType(ComponentID(comp)) == ch)
+      {
+        if (m_bLargePageBuffers)
+        {
+          m_apiPicBufAlloc[comp] = (Pel*)allocateLargePageBuffer( sizeof(Pel) * bufferSize );
+        }
+        else
+        {
+          m_apiPicBufAlloc[comp] = (Pel*)xMalloc( Pel, bufferSize );
+        }
+        m_apiPicBuf[comp] = m_apiPicBufAlloc[comp];
+        m_piPicOrg[comp]  = m_apiPicBuf[comp] + tileOrigin[0];
+      }
+    }
+
+    // the CTU offsets are relative to the top left sample of the first tile
+    m_ctuOffsetInBuffer[chan] = new Int[numCuInWidth * numCuInHeight];
+    Int tileIdx = 0;
+    Int ctuRow  = 0;
+    for (Int tileRow = 0; tileRow < Int(tileRowHeightsInCtus.size()); tileRow++)
+    {
+      Int ctuCol = 0;
+      for (Int tileCol = 0; tileCol < numTileColumns; tileCol++, tileIdx++)
+      {
+        for (Int cuRow = 0; cuRow < tileRowHeightsInCtus[tileRow]; cuRow++)
+        {
+          for (Int cuCol = 0; cuCol < tileColumnWidthsInCtus[tileCol]; cuCol++)
+          {
+            m_ctuOffsetInBuffer[chan][(ctuRow + cuRow) * numCuInWidth + ctuCol + cuCol] = tileOrigin[tileIdx] - tileOrigin[0] + stride * cuRow * ctuHeight + cuCol * ctuWidth;
+          }
+        }
+        ctuCol += tileColumnWidthsInCtus[tileCol];
+      }
+      ctuRow += tileRowHeightsInCtus[tileRow];
+    }
+  }
+
+  xCreateSubCuOffsets(maxCUWidth, maxCUHeight, maxCUDepth);
+}
+
+Int TComPicYuv::xGetAlignedStride( const Int stride ) const
+{
+  // with large page buffers, pad the rows so that the chroma strides (half the luma stride at most) are aligned too
+  const Int rowAlignment = m_bLargePageBuffers ? ( BUFFER_ALIGNMENT / Int(sizeof(Pel)) ) << 1 : 1;
+  return ( stride + rowAlignment - 1 ) / rowAlignment * rowAlignment;
+}
+
+Void TComPicYuv::xCreateSubCuOffsets( const UInt maxCUWidth, const UInt maxCUHeight, const UInt maxCUDepth )
+{
+  for(Int chan=0; chan<MAX_NUM_CHANNEL_TYPE; chan++)
+  {
+    const ChannelType ch= ChannelType(chan);
+    const Int ctuHeight = maxCUHeight>>getChannelTypeScaleY(ch);
+    const Int ctuWidth  = maxCUWidth>>getChannelTypeScaleX(ch);
+    const Int stride    = getStride(ch);
 
     m_subCuOffsetInBuffer[chan] = new Int[(size_t)1 << (2 * maxCUDepth)];
 
@@ -167,14 +366,34 @@ Void TComPicYuv::create ( const Int picWidth,                 ///< picture width
 
 Void TComPicYuv::destroy()
 {
+  if (m_pcSubPelPlanes)
+  {
+    delete m_pcSubPelPlanes;
+    m_pcSubPelPlanes = NULL;
+  }
+  if (m_piLuma8Buf)
+  {
+    xFree( m_piLuma8Buf );
+    m_piLuma8Buf = NULL;
+  }
+  m_bLuma8Valid = false;
+
   for(Int comp=0; comp<MAX_NUM_COMPONENT; comp++)
   {
-    m_piPicOrg[comp] = NULL;
+    m_piPicOrg[comp]  = NULL;
+    m_apiPicBuf[comp] = NULL;
 
-    if( m_apiPicBuf[comp] )
+    if( m_apiPicBufAlloc[comp] )
     {
-      xFree( m_apiPicBuf[comp] );
-      m_apiPicBuf[comp] = NULL;
+      if( m_bLargePageBuffers )
+      {
+        freeLargePageBuffer( m_apiPicBufAlloc[comp] );
+      }
+      else
+      {
+        xFree( m_apiPicBufAlloc[comp] );
+      }
+      m_apiPicBufAlloc[comp] = NULL;
     }
   }
 
@@ -195,9 +414,44 @@ Void TComPicYuv::destroy()
 
 
 
+Void TComPicYuv::createSubPelPlanes(const UInt maxCUHeight, const Bool bHalfPelOnly, const Int bitDepth)
+{
+  if (m_pcSubPelPlanes == NULL)
+  {
+    m_pcSubPelPlanes = new TComSubPelPlanes;
+  }
+  assert(!m_bTileMajor);
+  m_pcSubPelPlanes->create(this, maxCUHeight, bHalfPelOnly, bitDepth);
+}
+
+
+
+const UChar* TComPicYuv::getLuma8Addr(const Pel* piLuma)
+{
+  assert(!m_bTileMajor);
+  if (!m_bLuma8Valid)
+  {
+    const Int numSamples = getStride(COMPONENT_Y) * getTotalHeight(COMPONENT_Y);
+    if (m_piLuma8Buf == NULL)
+    {
+      m_piLuma8Buf = (UChar*)xMalloc( UChar, numSamples );
+    }
+    const Pel* piSrc = m_apiPicBuf[COMPONENT_Y];
+    for (Int i = 0; i < numSamples; i++)
+    {
+      m_piLuma8Buf[i] = UChar(piSrc[i]);
+    }
+    m_bLuma8Valid = true;
+  }
+  return m_piLuma8Buf + (piLuma - m_apiPicBuf[COMPONENT_Y]);
+}
+
+
+
 Void  TComPicYuv::copyToPic (TComPicYuv*  pcPicYuvDst) const
 {
   assert( m_chromaFormatIDC == pcPicYuvDst->getChromaFormat() );
+  assert( !m_bTileMajor && !pcPicYuvDst->isTileMajor() );
 
   for(Int comp=0; comp<getNumberValidComponents(); comp++)
   {
@@ -226,12 +480,48 @@ Void  TComPicYuv::copyToPic (TComPicYuv*  pcPicYuvDst) const
 }
 
 
+Void TComPicYuv::copyToPicByCtus (TComPicYuv*  pcPicYuvDst) const
+{
+  assert( m_chromaFormatIDC == pcPicYuvDst->getChromaFormat() );
+  assert( m_ctuWidth == pcPicYuvDst->m_ctuWidth && m_ctuHeight == pcPicYuvDst->m_ctuHeight && m_ctuWidth != 0 );
+  assert( m_picWidth == pcPicYuvDst->m_picWidth && m_picHeight == pcPicYuvDst->m_picHeight );
+
+  const Int numCuInWidth  = m_picWidth  / m_ctuWidth  + (m_picWidth  % m_ctuWidth  != 0);
+  const Int numCuInHeight = m_picHeight / m_ctuHeight + (m_picHeight % m_ctuHeight != 0);
+
+  for(Int comp=0; comp<getNumberValidComponents(); comp++)
+  {
+    const ComponentID compId=ComponentID(comp);
+    const Int csx        = getComponentScaleX(compId);
+    const Int csy        = getComponentScaleY(compId);
+    const Int strideSrc  = getStride(compId);
+    const Int strideDest = pcPicYuvDst->getStride(compId);
+
+    for (Int ctuRsAddr = 0; ctuRsAddr < numCuInWidth * numCuInHeight; ctuRsAddr++)
+    {
+      const Int ctuPosX = ( ctuRsAddr % numCuInWidth ) * m_ctuWidth;
+      const Int ctuPosY = ( ctuRsAddr / numCuInWidth ) * m_ctuHeight;
+      const Int width   = std::min( m_ctuWidth,  m_picWidth  - ctuPosX ) >> csx;
+      const Int height  = std::min( m_ctuHeight, m_picHeight - ctuPosY ) >> csy;
+
+      const Pel *pSrc  = getAddr(compId, ctuRsAddr);
+            Pel *pDest = pcPicYuvDst->getAddr(compId, ctuRsAddr);
+      for(Int y=0; y<height; y++, pSrc+=strideSrc, pDest+=strideDest)
+      {
+        ::memcpy(pDest, pSrc, width*sizeof(Pel));
+      }
+    }
+  }
+}
+
+
 Void TComPicYuv::extendPicBorder ()
 {
   if ( m_bIsBorderExtended )
   {
     return;
   }
+  assert( !m_bTileMajor );
 
   for(Int comp=0; comp<getNumberValidComponents(); comp++)
   {
@@ -280,6 +570,7 @@ Void TComPicYuv::extendPicBorder ()
 // NOTE: This function is never called, but may be useful for developers.
 Void TComPicYuv::dump (const std::string &fileName, const BitDepths &bitDepths, const Bool bAppend, const Bool bForceTo8Bit) const
 {
+  assert( !m_bTileMajor );
   FILE *pFile = fopen (fileName.c_str(), bAppend?"ab":"wb");
 
   Bool is16bit=false;
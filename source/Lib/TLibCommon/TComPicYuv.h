@@ -39,6 +39,7 @@
 #define __TCOMPICYUV__
 
 #include <stdio.h>
+#include <vector>
 #include "CommonDef.h"
 #include "TComRom.h"
 #include "TComChromaFormat.h"
@@ -47,6 +48,8 @@
 //! \ingroup TLibCommon
 //! \{
 
+class TComSubPelPlanes;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -61,6 +64,8 @@ private:
   // ------------------------------------------------------------------------------------------------
 
   Pel*  m_apiPicBuf[MAX_NUM_COMPONENT];             ///< Buffer (including margin)
+  Pel*  m_apiPicBufAlloc[MAX_NUM_COMPONENT];        ///< allocated memory, m_apiPicBuf may start further in to align the picture area
+  Bool  m_bLargePageBuffers;                        ///< whether the buffers were allocated with allocateLargePageBuffer()
 
   Pel*  m_piPicOrg[MAX_NUM_COMPONENT];              ///< m_apiPicBufY + m_iMarginLuma*getStride() + m_iMarginLuma
 
@@ -77,9 +82,23 @@ private:
 
   Int   m_marginX;                                  ///< margin of Luma channel (chroma's may be smaller, depending on ratio)
   Int   m_marginY;                                  ///< margin of Luma channel (chroma's may be smaller, depending on ratio)
+  Int   m_stride;                                   ///< stride of the Luma channel (chroma's may be smaller, depending on ratio)
+  Int   m_ctuWidth;                                 ///< width of the CTUs the offsets were generated for, 0 without CU info
+  Int   m_ctuHeight;                                ///< height of the CTUs the offsets were generated for, 0 without CU info
+  Bool  m_bTileMajor;                               ///< whether each tile is stored in its own contiguous block, see createTileMajor()
 
   Bool  m_bIsBorderExtended;
 
+  TComSubPelPlanes* m_pcSubPelPlanes;               ///< luma sub-sample planes of this picture used by the encoder, NULL when not used
+
+  static Bool s_bLargePagePlanes;                   ///< allocation of the buffers of pictures created from now on, see setLargePagePlanes()
+
+  UChar* m_piLuma8Buf;                              ///< 8-bit copy of the luma buffer (including margin) used by the encoder, NULL when not used
+  Bool   m_bLuma8Valid;                             ///< whether m_piLuma8Buf holds the current luma samples
+
+  Int           xGetAlignedStride  (const Int stride) const;
+  Void          xCreateSubCuOffsets(const UInt maxCUWidth, const UInt maxCUHeight, const UInt maxCUDepth);
+
 public:
                TComPicYuv         ();
   virtual     ~TComPicYuv         ();
@@ -103,8 +122,27 @@ public:
                                     const UInt maxCUWidth=0,   ///< used for margin only
                                     const UInt maxCUHeight=0); ///< used for margin only
 
+  /// create a picture where each tile, with its margin, is stored in its own contiguous block of the buffers. The blocks
+  /// are placed one after the other in tile raster order and share one stride, so that getAddr() for a CTU and getStride()
+  /// can be used as for a raster picture. The whole-picture functions (copyToPic, extendPicBorder...) are not available.
+  Void          createTileMajor   (const Int picWidth,
+                                   const Int picHeight,
+                                   const ChromaFormat chromaFormatIDC,
+                                   const UInt maxCUWidth,
+                                   const UInt maxCUHeight,
+                                   const UInt maxCUDepth,
+                                   const std::vector<Int> &tileColumnWidthsInCtus,
+                                   const std::vector<Int> &tileRowHeightsInCtus,
+                                   const Bool bUseMargin);
+
   Void          destroy           ();
 
+  /// when enabled, the buffers of the pictures created afterwards are allocated on 2 MB (huge) pages where they are large
+  /// enough, and their rows and picture areas start on 64-byte boundaries. Pages are not touched when allocated, so with
+  /// the default first-touch policy they are placed on the NUMA node of the thread that first writes the picture.
+  static Void   setLargePagePlanes( const Bool b )  { s_bLargePagePlanes = b; }
+  static Bool   getLargePagePlanes()                { return s_bLargePagePlanes; }
+
   // The following have been removed - Use CHROMA_400 in the above function call.
   //Void  createLuma  ( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uhMaxCUDepth );
   //Void  destroyLuma ();
@@ -116,11 +154,12 @@ public:
   Int           getWidth          (const ComponentID id) const { return  m_picWidth >> getComponentScaleX(id);   }
   Int           getHeight         (const ComponentID id) const { return  m_picHeight >> getComponentScaleY(id);  }
   ChromaFormat  getChromaFormat   ()                     const { return m_chromaFormatIDC; }
+  Bool          isTileMajor       ()                     const { return m_bTileMajor; }
   UInt          getNumberValidComponents() const { return ::getNumberValidComponents(m_chromaFormatIDC); }
 
-  Int           getStride         (const ComponentID id) const { return ((m_picWidth     ) + (m_marginX  <<1)) >> getComponentScaleX(id); }
+  Int           getStride         (const ComponentID id) const { return m_stride >> getComponentScaleX(id); }
 private:
-  Int           getStride         (const ChannelType id) const { return ((m_picWidth     ) + (m_marginX  <<1)) >> getChannelTypeScaleX(id); }
+  Int           getStride         (const ChannelType id) const { return m_stride >> getChannelTypeScaleX(id); }
 public:
   Int           getTotalHeight    (const ComponentID id) const { return ((m_picHeight    ) + (m_marginY  <<1)) >> getComponentScaleY(id); }
 
@@ -160,6 +199,9 @@ public:
   //  Copy function to picture
   Void          copyToPic         ( TComPicYuv*  pcPicYuvDst ) const ;
 
+  //  Copy function to picture with the same CTU size but possibly a different layout, such as a tile-major picture
+  Void          copyToPicByCtus   ( TComPicYuv*  pcPicYuvDst ) const ;
+
   //  Extend function of picture buffer
   Void          extendPicBorder   ();
 
@@ -168,6 +210,14 @@ public:
 
   // Set border extension flag
   Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; }
+
+  //  Sub-sample planes, computed when first used and deleted with the picture buffer
+  Void              createSubPelPlanes(const UInt maxCUHeight, const Bool bHalfPelOnly, const Int bitDepth);
+  TComSubPelPlanes* getSubPelPlanes   ()       { return m_pcSubPelPlanes; }
+
+  //  8-bit copy of the luma buffer for 8-bit content, converted when first used after invalidateLuma8() and deleted with the picture buffer
+  const UChar*      getLuma8Addr      (const Pel* piLuma);  ///< address in the copy of the luma sample at piLuma
+  Void              invalidateLuma8   ()       { m_bLuma8Valid = false; }
 };// END CLASS DEFINITION TComPicYuv
 
 
@@ -39,6 +39,12 @@
 #include "TComPrediction.h"
 #include "TComPic.h"
 #include "TComTU.h"
+#include "TComSubPelPlanes.h"
+
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -66,6 +72,164 @@ const UChar TComPrediction::m_aucIntraFilter[MAX_NUM_CHANNEL_TYPE][MAX_INTRA_FIL
 
 };
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 kernels
+// ====================================================================================================================
+
+// The angular kernels interpolate in 16-bit lanes, which is exact for bit depths up to 10 where
+// (32-deltaFract)*a + deltaFract*b + 16 stays below 2^15. The planar kernel works in 32-bit lanes.
+
+/** angular prediction of a block in the orientation of the main reference (rows along refMain), width a multiple of 4
+ */
+SIMD_TARGET_AVX2 static Void simdPredIntraAngAVX2( const Pel* refMain, Pel* pDst, Int dstStride, Int width, Int height, Int intraPredAngle )
+{
+  for( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const Int  deltaInt   = deltaPos >> 5;
+    const Int  deltaFract = deltaPos & ( 32 - 1 );
+    const Pel* pRM        = refMain + deltaInt + 1;
+
+    if( !( width & 15 ) )
+    {
+      const __m256i mmW0  = _mm256_set1_epi16( 32 - deltaFract );
+      const __m256i mmW1  = _mm256_set1_epi16( deltaFract );
+      const __m256i mmRnd = _mm256_set1_epi16( 16 );
+      for( Int x = 0; x < width; x += 16 )
+      {
+        __m256i mmRes = _mm256_loadu_si256( ( const __m256i* )( pRM + x ) );
+        if( deltaFract )
+        {
+          const __m256i mmNext = _mm256_loadu_si256( ( const __m256i* )( pRM + x + 1 ) );
+          mmRes = _mm256_add_epi16( _mm256_mullo_epi16( mmRes, mmW0 ), _mm256_mullo_epi16( mmNext, mmW1 ) );
+          mmRes = _mm256_srli_epi16( _mm256_add_epi16( mmRes, mmRnd ), 5 );
+        }
+        _mm256_storeu_si256( ( __m256i* )( pDst + x ), mmRes );
+      }
+    }
+    else
+    {
+      const __m128i mmW0  = _mm_set1_epi16( 32 - deltaFract );
+      const __m128i mmW1  = _mm_set1_epi16( deltaFract );
+      const __m128i mmRnd = _mm_set1_epi16( 16 );
+      for( Int x = 0; x < width; x += 8 )
+      {
+        const Bool bHalf = ( width - x ) == 4;
+        __m128i    mmRes = bHalf ? _mm_loadl_epi64( ( const __m128i* )( pRM + x ) ) : _mm_loadu_si128( ( const __m128i* )( pRM + x ) );
+        if( deltaFract )
+        {
+          const __m128i mmNext = bHalf ? _mm_loadl_epi64( ( const __m128i* )( pRM + x + 1 ) ) : _mm_loadu_si128( ( const __m128i* )( pRM + x + 1 ) );
+          mmRes = _mm_add_epi16( _mm_mullo_epi16( mmRes, mmW0 ), _mm_mullo_epi16( mmNext, mmW1 ) );
+          mmRes = _mm_srli_epi16( _mm_add_epi16( mmRes, mmRnd ), 5 );
+        }
+        if( bHalf )
+        {
+          _mm_storel_epi64( ( __m128i* )( pDst + x ), mmRes );
+        }
+        else
+        {
+          _mm_storeu_si128( ( __m128i* )( pDst + x ), mmRes );
+        }
+      }
+    }
+  }
+}
+
+/** writes the transpose of a block whose dimensions are multiples of 8, used to flip the horizontal angular modes
+ */
+SIMD_TARGET_AVX2 static Void simdTransposeBlockAVX2( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int width, Int height )
+{
+  for( Int y = 0; y < height; y += 8 )
+  {
+    for( Int x = 0; x < width; x += 8 )
+    {
+      const Pel* s = pSrc + y * srcStride + x;
+      __m128i r[8], t[8];
+      for( Int k = 0; k < 8; k++ )
+      {
+        r[k] = _mm_loadu_si128( ( const __m128i* )( s + k * srcStride ) );
+      }
+      for( Int k = 0; k < 4; k++ )
+      {
+        t[k]     = _mm_unpacklo_epi16( r[2 * k], r[2 * k + 1] );
+        t[k + 4] = _mm_unpackhi_epi16( r[2 * k], r[2 * k + 1] );
+      }
+      const __m128i u0 = _mm_unpacklo_epi32( t[0], t[1] ), u1 = _mm_unpackhi_epi32( t[0], t[1] );
+      const __m128i u2 = _mm_unpacklo_epi32( t[2], t[3] ), u3 = _mm_unpackhi_epi32( t[2], t[3] );
+      const __m128i u4 = _mm_unpacklo_epi32( t[4], t[5] ), u5 = _mm_unpackhi_epi32( t[4], t[5] );
+      const __m128i u6 = _mm_unpacklo_epi32( t[6], t[7] ), u7 = _mm_unpackhi_epi32( t[6], t[7] );
+      Pel* d = pDst + x * dstStride + y;
+      _mm_storeu_si128( ( __m128i* )( d                 ), _mm_unpacklo_epi64( u0, u2 ) );
+      _mm_storeu_si128( ( __m128i* )( d +     dstStride ), _mm_unpackhi_epi64( u0, u2 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 2 * dstStride ), _mm_unpacklo_epi64( u1, u3 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 3 * dstStride ), _mm_unpackhi_epi64( u1, u3 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 4 * dstStride ), _mm_unpacklo_epi64( u4, u6 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 5 * dstStride ), _mm_unpackhi_epi64( u4, u6 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 6 * dstStride ), _mm_unpacklo_epi64( u5, u7 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 7 * dstStride ), _mm_unpackhi_epi64( u5, u7 ) );
+    }
+  }
+}
+
+/** planar prediction from the prepared intermediate arrays of xPredIntraPlanar, width 4 or a multiple of 8
+ */
+SIMD_TARGET_AVX2 static Void simdPredIntraPlanarAVX2( const Int* leftColumn, const Int* topRow, const Int* bottomRow, const Int* rightColumn
+                                                    , Pel* rpDst, Int dstStride, Int width, Int height, Int shift )
+{
+  const __m128i mmShift = _mm_cvtsi32_si128( shift );
+  if( width == 4 )
+  {
+    const __m128i mmX1   = _mm_setr_epi32( 1, 2, 3, 4 );
+    const __m128i mmBot  = _mm_loadu_si128( ( const __m128i* )bottomRow );
+    __m128i       mmVert = _mm_loadu_si128( ( const __m128i* )topRow );
+    for( Int y = 0; y < height; y++ )
+    {
+      mmVert = _mm_add_epi32( mmVert, mmBot );
+      const __m128i mmHor = _mm_add_epi32( _mm_set1_epi32( leftColumn[y] + width ), _mm_mullo_epi32( mmX1, _mm_set1_epi32( rightColumn[y] ) ) );
+      const __m128i mmRes = _mm_sra_epi32( _mm_add_epi32( mmHor, mmVert ), mmShift );
+      _mm_storel_epi64( ( __m128i* )( rpDst + y * dstStride ), _mm_packs_epi32( mmRes, mmRes ) );
+    }
+    return;
+  }
+
+  for( Int x = 0; x < width; x += 8 )
+  {
+    const __m256i mmX1   = _mm256_setr_epi32( x + 1, x + 2, x + 3, x + 4, x + 5, x + 6, x + 7, x + 8 );
+    const __m256i mmBot  = _mm256_loadu_si256( ( const __m256i* )( bottomRow + x ) );
+    __m256i       mmVert = _mm256_loadu_si256( ( const __m256i* )( topRow + x ) );
+    for( Int y = 0; y < height; y++ )
+    {
+      mmVert = _mm256_add_epi32( mmVert, mmBot );
+      const __m256i mmHor = _mm256_add_epi32( _mm256_set1_epi32( leftColumn[y] + width ), _mm256_mullo_epi32( mmX1, _mm256_set1_epi32( rightColumn[y] ) ) );
+      const __m256i mmRes = _mm256_sra_epi32( _mm256_add_epi32( mmHor, mmVert ), mmShift );
+      _mm_storeu_si128( ( __m128i* )( rpDst + y * dstStride + x ), _mm_packs_epi32( _mm256_castsi256_si128( mmRes ), _mm256_extracti128_si256( mmRes, 1 ) ) );
+    }
+  }
+}
+
+/** DC filtering of the top row (x >= 1) of a luma block, width a multiple of 4
+ */
+SIMD_TARGET_AVX2 static Void simdDCFilterTopRowAVX2( const Pel* pAbove, Pel* pDst, Int width )
+{
+  const __m128i mmTwo = _mm_set1_epi16( 2 );
+  for( Int x = 0; x < width; x += 8 )
+  {
+    const Bool    bHalf = ( width - x ) == 4;
+    const __m128i mmA   = bHalf ? _mm_loadl_epi64( ( const __m128i* )( pAbove + x ) ) : _mm_loadu_si128( ( const __m128i* )( pAbove + x ) );
+    const __m128i mmD   = bHalf ? _mm_loadl_epi64( ( const __m128i* )( pDst + x ) )   : _mm_loadu_si128( ( const __m128i* )( pDst + x ) );
+    const __m128i mmRes = _mm_srai_epi16( _mm_add_epi16( _mm_add_epi16( mmA, mmTwo ), _mm_add_epi16( mmD, _mm_slli_epi16( mmD, 1 ) ) ), 2 );
+    if( bHalf )
+    {
+      _mm_storel_epi64( ( __m128i* )( pDst + x ), mmRes );
+    }
+    else
+    {
+      _mm_storeu_si128( ( __m128i* )( pDst + x ), mmRes );
+    }
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -321,6 +485,10 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
       std::swap(width, height);
     }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    const Bool bUseSIMD = (bitDepth <= 10) && getSIMDLevel() >= SIMD_AVX2;
+#endif
+
     if (intraPredAngle == 0)  // pure vertical or pure horizontal
     {
       for (Int y=0;y<height;y++)
@@ -340,6 +508,13 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
       }
     }
     else
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (bUseSIMD)
+    {
+      simdPredIntraAngAVX2(refMain, pDst, dstStride, width, height, intraPredAngle);
+    }
+    else
+#endif
     {
       Pel *pDsty=pDst;
 
@@ -372,6 +547,13 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     }
 
     // Flip the block if this is the horizontal mode
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (!bIsModeVer && bUseSIMD && !(width&7) && !(height&7))
+    {
+      simdTransposeBlockAVX2(pDst, dstStride, pTrueDst, dstStrideTrue, width, height);
+    }
+    else
+#endif
     if (!bIsModeVer)
     {
       for (Int y=0; y<height; y++)
@@ -660,7 +842,22 @@ Void TComPrediction::xPredInterBlk(const ComponentID compID, TComDataCU *cu, TCo
 
   const ChromaFormat chFmt = cu->getPic()->getChromaFormat();
 
-  if ( yFrac == 0 )
+  // the precomputed planes hold the final samples, as needed for uni-prediction without weighting
+  TComSubPelPlanes* subPelPlanes = isLuma(compID) && !bi ? refPic->getSubPelPlanes() : NULL;
+  if ( subPelPlanes != NULL && ( xFrac | yFrac ) != 0 && subPelPlanes->hasPlane( yFrac, xFrac ) )
+  {
+    const Int topRow = cu->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ partAddr ] ] + ( mv->getVer() >> shiftVer );
+    subPelPlanes->prepareRows( topRow, topRow + cxHeight - 1 );
+
+    const Pel* src = subPelPlanes->getAddr( yFrac, xFrac ) + ( ref - refPic->getAddr( compID ) );
+    for ( UInt row = 0; row < cxHeight; row++ )
+    {
+      ::memcpy( dst, src, cxWidth * sizeof( Pel ) );
+      src += refStride;
+      dst += dstStride;
+    }
+  }
+  else if ( yFrac == 0 )
   {
     m_if.filterHor(compID, ref, refStride, dst,  dstStride, cxWidth, cxHeight, xFrac, !bi, chFmt, bitDepth);
   }
@@ -763,6 +960,14 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
     leftColumn[k]   <<= shift1Dhor;
   }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if ((width == 4 || !(width&7)) && getSIMDLevel() >= SIMD_AVX2)
+  {
+    simdPredIntraPlanarAVX2(leftColumn, topRow, bottomRow, rightColumn, rpDst, dstStride, width, height, shift1Dhor+1);
+    return;
+  }
+#endif
+
   const UInt topRowShift = 0;
 
   // Generate prediction signal
@@ -801,6 +1006,15 @@ Void TComPrediction::xDCPredFiltering( const Pel* pSrc, Int iSrcStride, Pel* pDs
     pDst[0] = (Pel)((pSrc[-iSrcStride] + pSrc[-1] + 2 * pDst[0] + 2) >> 2);
 
     //top row (vertical filter)
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (!(iWidth&3) && getSIMDLevel() >= SIMD_AVX2)
+    {
+      const Pel topLeft = pDst[0];
+      simdDCFilterTopRowAVX2(pSrc - iSrcStride, pDst, iWidth);
+      pDst[0] = topLeft;
+    }
+    else
+#endif
     for ( x = 1; x < iWidth; x++ )
     {
       pDst[x] = (Pel)((pSrc[x - iSrcStride] +  3 * pDst[x] + 2) >> 2);
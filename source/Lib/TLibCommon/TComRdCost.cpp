@@ -45,6 +45,10 @@
 #include <emmintrin.h>
 #include <xmmintrin.h>
 #endif
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -167,6 +171,49 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    m_afpDistortFunc[DF_SSE    ] = TComRdCost::xGetSSEAVX2<0>;
+    m_afpDistortFunc[DF_SSE4   ] = TComRdCost::xGetSSEAVX2<4>;
+    m_afpDistortFunc[DF_SSE8   ] = TComRdCost::xGetSSEAVX2<8>;
+    m_afpDistortFunc[DF_SSE16  ] = TComRdCost::xGetSSEAVX2<16>;
+    m_afpDistortFunc[DF_SSE32  ] = TComRdCost::xGetSSEAVX2<32>;
+    m_afpDistortFunc[DF_SSE64  ] = TComRdCost::xGetSSEAVX2<64>;
+    m_afpDistortFunc[DF_SSE16N ] = TComRdCost::xGetSSEAVX2<0>;
+
+    m_afpDistortFunc[DF_SAD    ] = TComRdCost::xGetSADAVX2<0>;
+    m_afpDistortFunc[DF_SAD4   ] = TComRdCost::xGetSADAVX2<4>;
+    m_afpDistortFunc[DF_SAD8   ] = TComRdCost::xGetSADAVX2<8>;
+    m_afpDistortFunc[DF_SAD16  ] = TComRdCost::xGetSADAVX2<16>;
+    m_afpDistortFunc[DF_SAD32  ] = TComRdCost::xGetSADAVX2<32>;
+    m_afpDistortFunc[DF_SAD64  ] = TComRdCost::xGetSADAVX2<64>;
+
+    m_afpDistortFunc[DF_SADS   ] = TComRdCost::xGetSADAVX2<0>;
+    m_afpDistortFunc[DF_SADS4  ] = TComRdCost::xGetSADAVX2<4>;
+    m_afpDistortFunc[DF_SADS8  ] = TComRdCost::xGetSADAVX2<8>;
+    m_afpDistortFunc[DF_SADS16 ] = TComRdCost::xGetSADAVX2<16>;
+    m_afpDistortFunc[DF_SADS32 ] = TComRdCost::xGetSADAVX2<32>;
+    m_afpDistortFunc[DF_SADS64 ] = TComRdCost::xGetSADAVX2<64>;
+
+    m_afpDistortFunc[DF_SAD12  ] = TComRdCost::xGetSADAVX2<12>;
+    m_afpDistortFunc[DF_SAD24  ] = TComRdCost::xGetSADAVX2<24>;
+    m_afpDistortFunc[DF_SAD48  ] = TComRdCost::xGetSADAVX2<48>;
+
+    m_afpDistortFunc[DF_SADS12 ] = TComRdCost::xGetSADAVX2<12>;
+    m_afpDistortFunc[DF_SADS24 ] = TComRdCost::xGetSADAVX2<24>;
+    m_afpDistortFunc[DF_SADS48 ] = TComRdCost::xGetSADAVX2<48>;
+
+    m_afpDistortFunc[DF_HADS   ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS4  ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS8  ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS16 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS32 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADsAVX2;
+  }
+#endif
+
   m_costMode                   = COST_STANDARD_LOSSY;
 
   m_motionLambda               = 0;
@@ -511,6 +558,383 @@ UInt simdHADs8x8( const Pel * piOrg, const Pel * piCur, Int iStrideOrg, Int iStr
 }
 #endif
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+SIMD_TARGET_AVX2 static inline UInt simdHorizontalSumAVX2( __m256i vSum, __m128i vSum128 )
+{
+  __m128i sum = _mm_add_epi32( _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) ), vSum128 );
+  sum = _mm_add_epi32( sum , _mm_shuffle_epi32( sum , _MM_SHUFFLE( 1 , 0 , 3 , 2 ) ) );
+  sum = _mm_add_epi32( sum , _mm_shuffle_epi32( sum , _MM_SHUFFLE( 2 , 3 , 0 , 1 ) ) );
+  return( (UInt)_mm_cvtsi128_si32( sum ) );
+}
+
+// SAD of iRows rows of iWidth samples (iCols when iWidth is 0). Internal bit-depth must be 10-bit or lower.
+template<Int iWidth>
+SIMD_TARGET_AVX2 static Distortion simdSADAVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur, Int iRows, Int iCols )
+{
+  const Int     iW      = iWidth != 0 ? iWidth : iCols;
+  const __m256i vOne    = _mm256_set1_epi16( 1 );
+  const __m128i vOne128 = _mm_set1_epi16( 1 );
+  __m256i       vSum    = _mm256_setzero_si256();
+  __m128i       vSum128 = _mm_setzero_si128();
+  Distortion    uiTail  = 0;
+
+  if( iW == 4 )
+  {
+    // two rows per register
+    for( ; iRows > 1; iRows -= 2 )
+    {
+      __m128i org = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )piOrg ), _mm_loadl_epi64( ( const __m128i* )( piOrg + iStrideOrg ) ) );
+      __m128i cur = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )piCur ), _mm_loadl_epi64( ( const __m128i* )( piCur + iStrideCur ) ) );
+      vSum128 = _mm_add_epi32( vSum128, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( org, cur ) ), vOne128 ) );
+      piOrg += 2 * iStrideOrg;
+      piCur += 2 * iStrideCur;
+    }
+  }
+
+  for( ; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 16 <= iW; n += 16 )
+    {
+      __m256i org = _mm256_loadu_si256( ( const __m256i* )( piOrg + n ) );
+      __m256i cur = _mm256_loadu_si256( ( const __m256i* )( piCur + n ) );
+      vSum = _mm256_add_epi32( vSum, _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( org, cur ) ), vOne ) );
+    }
+    if( n + 8 <= iW )
+    {
+      __m128i org = _mm_loadu_si128( ( const __m128i* )( piOrg + n ) );
+      __m128i cur = _mm_loadu_si128( ( const __m128i* )( piCur + n ) );
+      vSum128 = _mm_add_epi32( vSum128, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( org, cur ) ), vOne128 ) );
+      n += 8;
+    }
+    if( n + 4 <= iW )
+    {
+      __m128i org = _mm_loadl_epi64( ( const __m128i* )( piOrg + n ) );
+      __m128i cur = _mm_loadl_epi64( ( const __m128i* )( piCur + n ) );
+      vSum128 = _mm_add_epi32( vSum128, _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( org, cur ) ), vOne128 ) );
+      n += 4;
+    }
+    for( ; n < iW; n++ )
+    {
+      uiTail += abs( piOrg[n] - piCur[n] );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return( simdHorizontalSumAVX2( vSum, vSum128 ) + uiTail );
+}
+
+// SADs of iRows rows of iCols samples (a multiple of 4) against four reference positions, reading each original row once.
+// Internal bit-depth must be 10-bit or lower.
+SIMD_TARGET_AVX2 static Void simdSADsX4AVX2( const Pel* piOrg, const Pel* const* piCurs, Int iStrideOrg, Int iStrideCur, Int iRows, Int iCols, Distortion* puiSads )
+{
+  const __m256i vOne       = _mm256_set1_epi16( 1 );
+  const __m128i vOne128    = _mm_set1_epi16( 1 );
+  __m256i       vSum[4]    = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+  __m128i       vSum128[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+  const Pel*    piCur[4]   = { piCurs[0], piCurs[1], piCurs[2], piCurs[3] };
+
+  for( ; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 16 <= iCols; n += 16 )
+    {
+      const __m256i org = _mm256_loadu_si256( ( const __m256i* )( piOrg + n ) );
+      for( Int k = 0; k < 4; k++ )
+      {
+        const __m256i cur = _mm256_loadu_si256( ( const __m256i* )( piCur[k] + n ) );
+        vSum[k] = _mm256_add_epi32( vSum[k], _mm256_madd_epi16( _mm256_abs_epi16( _mm256_sub_epi16( org, cur ) ), vOne ) );
+      }
+    }
+    if( n + 8 <= iCols )
+    {
+      const __m128i org = _mm_loadu_si128( ( const __m128i* )( piOrg + n ) );
+      for( Int k = 0; k < 4; k++ )
+      {
+        const __m128i cur = _mm_loadu_si128( ( const __m128i* )( piCur[k] + n ) );
+        vSum128[k] = _mm_add_epi32( vSum128[k], _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( org, cur ) ), vOne128 ) );
+      }
+      n += 8;
+    }
+    if( n + 4 <= iCols )
+    {
+      const __m128i org = _mm_loadl_epi64( ( const __m128i* )( piOrg + n ) );
+      for( Int k = 0; k < 4; k++ )
+      {
+        const __m128i cur = _mm_loadl_epi64( ( const __m128i* )( piCur[k] + n ) );
+        vSum128[k] = _mm_add_epi32( vSum128[k], _mm_madd_epi16( _mm_abs_epi16( _mm_sub_epi16( org, cur ) ), vOne128 ) );
+      }
+    }
+    piOrg += iStrideOrg;
+    for( Int k = 0; k < 4; k++ )
+    {
+      piCur[k] += iStrideCur;
+    }
+  }
+
+  for( Int k = 0; k < 4; k++ )
+  {
+    puiSads[k] = simdHorizontalSumAVX2( vSum[k], vSum128[k] );
+  }
+}
+
+// as simdSADsX4AVX2, for 8-bit samples and iNumCands reference positions: 32 samples per instruction,
+// summed into 64-bit lanes by the SAD instruction
+template<Int iNumCands>
+SIMD_TARGET_AVX2 static Void simdSADs8AVX2( const UChar* piOrg, const UChar* const* piCurs, Int iStrideOrg, Int iStrideCur, Int iRows, Int iCols, Distortion* puiSads )
+{
+  __m256i       vSum[iNumCands];
+  __m128i       vSum128[iNumCands];
+  const UChar*  piCur[iNumCands];
+  for( Int k = 0; k < iNumCands; k++ )
+  {
+    vSum[k]    = _mm256_setzero_si256();
+    vSum128[k] = _mm_setzero_si128();
+    piCur[k]   = piCurs[k];
+  }
+
+  for( ; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 32 <= iCols; n += 32 )
+    {
+      const __m256i org = _mm256_loadu_si256( ( const __m256i* )( piOrg + n ) );
+      for( Int k = 0; k < iNumCands; k++ )
+      {
+        vSum[k] = _mm256_add_epi64( vSum[k], _mm256_sad_epu8( org, _mm256_loadu_si256( ( const __m256i* )( piCur[k] + n ) ) ) );
+      }
+    }
+    if( n + 16 <= iCols )
+    {
+      const __m128i org = _mm_loadu_si128( ( const __m128i* )( piOrg + n ) );
+      for( Int k = 0; k < iNumCands; k++ )
+      {
+        vSum128[k] = _mm_add_epi64( vSum128[k], _mm_sad_epu8( org, _mm_loadu_si128( ( const __m128i* )( piCur[k] + n ) ) ) );
+      }
+      n += 16;
+    }
+    if( n + 8 <= iCols )
+    {
+      const __m128i org = _mm_loadl_epi64( ( const __m128i* )( piOrg + n ) );
+      for( Int k = 0; k < iNumCands; k++ )
+      {
+        vSum128[k] = _mm_add_epi64( vSum128[k], _mm_sad_epu8( org, _mm_loadl_epi64( ( const __m128i* )( piCur[k] + n ) ) ) );
+      }
+      n += 8;
+    }
+    if( n + 4 <= iCols )
+    {
+      const __m128i org = _mm_loadu_si32( piOrg + n );
+      for( Int k = 0; k < iNumCands; k++ )
+      {
+        vSum128[k] = _mm_add_epi64( vSum128[k], _mm_sad_epu8( org, _mm_loadu_si32( piCur[k] + n ) ) );
+      }
+    }
+    piOrg += iStrideOrg;
+    for( Int k = 0; k < iNumCands; k++ )
+    {
+      piCur[k] += iStrideCur;
+    }
+  }
+
+  for( Int k = 0; k < iNumCands; k++ )
+  {
+    __m128i vSumK = _mm_add_epi64( vSum128[k], _mm_add_epi64( _mm256_castsi256_si128( vSum[k] ), _mm256_extracti128_si256( vSum[k], 1 ) ) );
+    vSumK         = _mm_add_epi64( vSumK, _mm_unpackhi_epi64( vSumK, vSumK ) );
+    puiSads[k]    = Distortion( _mm_cvtsi128_si32( vSumK ) );
+  }
+}
+
+// squared differences of 16-bit lanes, each right-shifted by uiShift, summed in pairs into 32-bit lanes
+SIMD_TARGET_AVX2 static inline __m256i simdSquaredDiffAVX2( __m256i org, __m256i cur, __m128i vShift, Bool bShift )
+{
+  __m256i diff = _mm256_sub_epi16( org, cur );
+  if( !bShift )
+  {
+    return( _mm256_madd_epi16( diff, diff ) );
+  }
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i lo = _mm256_unpacklo_epi16( diff, zero );
+  __m256i hi = _mm256_unpackhi_epi16( diff, zero );
+  return( _mm256_add_epi32( _mm256_srl_epi32( _mm256_madd_epi16( lo, lo ), vShift ), _mm256_srl_epi32( _mm256_madd_epi16( hi, hi ), vShift ) ) );
+}
+
+SIMD_TARGET_AVX2 static inline __m128i simdSquaredDiffAVX2( __m128i org, __m128i cur, __m128i vShift, Bool bShift )
+{
+  __m128i diff = _mm_sub_epi16( org, cur );
+  if( !bShift )
+  {
+    return( _mm_madd_epi16( diff, diff ) );
+  }
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_unpacklo_epi16( diff, zero );
+  __m128i hi = _mm_unpackhi_epi16( diff, zero );
+  return( _mm_add_epi32( _mm_srl_epi32( _mm_madd_epi16( lo, lo ), vShift ), _mm_srl_epi32( _mm_madd_epi16( hi, hi ), vShift ) ) );
+}
+
+// SSE of iRows rows of iWidth samples (iCols when iWidth is 0). The 32-bit lanes wrap like the 32-bit Distortion sum of the C code.
+template<Int iWidth>
+SIMD_TARGET_AVX2 static Distortion simdSSEAVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur, Int iRows, Int iCols, UInt uiShift )
+{
+  const Int     iW      = iWidth != 0 ? iWidth : iCols;
+  const Bool    bShift  = uiShift != 0;
+  const __m128i vShift  = _mm_cvtsi32_si128( uiShift );
+  __m256i       vSum    = _mm256_setzero_si256();
+  __m128i       vSum128 = _mm_setzero_si128();
+  Distortion    uiTail  = 0;
+
+  if( iW == 4 )
+  {
+    for( ; iRows > 1; iRows -= 2 )
+    {
+      __m128i org = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )piOrg ), _mm_loadl_epi64( ( const __m128i* )( piOrg + iStrideOrg ) ) );
+      __m128i cur = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )piCur ), _mm_loadl_epi64( ( const __m128i* )( piCur + iStrideCur ) ) );
+      vSum128 = _mm_add_epi32( vSum128, simdSquaredDiffAVX2( org, cur, vShift, bShift ) );
+      piOrg += 2 * iStrideOrg;
+      piCur += 2 * iStrideCur;
+    }
+  }
+
+  for( ; iRows != 0; iRows-- )
+  {
+    Int n = 0;
+    for( ; n + 16 <= iW; n += 16 )
+    {
+      vSum = _mm256_add_epi32( vSum, simdSquaredDiffAVX2( _mm256_loadu_si256( ( const __m256i* )( piOrg + n ) ), _mm256_loadu_si256( ( const __m256i* )( piCur + n ) ), vShift, bShift ) );
+    }
+    if( n + 8 <= iW )
+    {
+      vSum128 = _mm_add_epi32( vSum128, simdSquaredDiffAVX2( _mm_loadu_si128( ( const __m128i* )( piOrg + n ) ), _mm_loadu_si128( ( const __m128i* )( piCur + n ) ), vShift, bShift ) );
+      n += 8;
+    }
+    if( n + 4 <= iW )
+    {
+      vSum128 = _mm_add_epi32( vSum128, simdSquaredDiffAVX2( _mm_loadl_epi64( ( const __m128i* )( piOrg + n ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + n ) ), vShift, bShift ) );
+      n += 4;
+    }
+    for( ; n < iW; n++ )
+    {
+      Intermediate_Int iTemp = piOrg[n] - piCur[n];
+      uiTail += Distortion( ( iTemp * iTemp ) >> uiShift );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return( simdHorizontalSumAVX2( vSum, vSum128 ) + uiTail );
+}
+
+// first two stages of the 8-point Hadamard butterflies across eight registers of 16-bit lanes
+SIMD_TARGET_AVX2 static inline Void simdHAD8TwoStagesAVX2( __m256i* m )
+{
+  __m256i t[8];
+  t[0] = _mm256_add_epi16( m[0], m[4] ); t[1] = _mm256_add_epi16( m[1], m[5] );
+  t[2] = _mm256_add_epi16( m[2], m[6] ); t[3] = _mm256_add_epi16( m[3], m[7] );
+  t[4] = _mm256_sub_epi16( m[0], m[4] ); t[5] = _mm256_sub_epi16( m[1], m[5] );
+  t[6] = _mm256_sub_epi16( m[2], m[6] ); t[7] = _mm256_sub_epi16( m[3], m[7] );
+  m[0] = _mm256_add_epi16( t[0], t[2] ); m[1] = _mm256_add_epi16( t[1], t[3] );
+  m[2] = _mm256_sub_epi16( t[0], t[2] ); m[3] = _mm256_sub_epi16( t[1], t[3] );
+  m[4] = _mm256_add_epi16( t[4], t[6] ); m[5] = _mm256_add_epi16( t[5], t[7] );
+  m[6] = _mm256_sub_epi16( t[4], t[6] ); m[7] = _mm256_sub_epi16( t[5], t[7] );
+}
+
+// Hadamard SATD of one 8x8 block, or of two horizontally adjacent 8x8 blocks when bPair is set (one per 128-bit lane).
+// The differences are transformed vertically and then, after a transpose, horizontally in 16 bits; the last horizontal
+// stage uses |a+b| + |a-b| = 2*max(|a|,|b|), so the values never exceed 16 bits for 10-bit input.
+SIMD_TARGET_AVX2 static UInt simdHADs8x8AVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur, Bool bPair )
+{
+  __m256i m[8];
+  for( Int k = 0; k < 8; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    if( bPair )
+    {
+      m[k] = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )piOrg ), _mm256_loadu_si256( ( const __m256i* )piCur ) );
+    }
+    else
+    {
+      m[k] = _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )piOrg ), _mm_loadu_si128( ( const __m128i* )piCur ) ), 0 );
+    }
+  }
+
+  // vertical
+  simdHAD8TwoStagesAVX2( m );
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    __m256i t = m[k];
+    m[k]   = _mm256_add_epi16( t, m[k+1] );
+    m[k+1] = _mm256_sub_epi16( t, m[k+1] );
+  }
+
+  // transpose within each 128-bit lane
+  __m256i a[8], b[8];
+  a[0] = _mm256_unpacklo_epi16( m[0], m[1] ); a[1] = _mm256_unpackhi_epi16( m[0], m[1] );
+  a[2] = _mm256_unpacklo_epi16( m[2], m[3] ); a[3] = _mm256_unpackhi_epi16( m[2], m[3] );
+  a[4] = _mm256_unpacklo_epi16( m[4], m[5] ); a[5] = _mm256_unpackhi_epi16( m[4], m[5] );
+  a[6] = _mm256_unpacklo_epi16( m[6], m[7] ); a[7] = _mm256_unpackhi_epi16( m[6], m[7] );
+  b[0] = _mm256_unpacklo_epi32( a[0], a[2] ); b[1] = _mm256_unpackhi_epi32( a[0], a[2] );
+  b[2] = _mm256_unpacklo_epi32( a[1], a[3] ); b[3] = _mm256_unpackhi_epi32( a[1], a[3] );
+  b[4] = _mm256_unpacklo_epi32( a[4], a[6] ); b[5] = _mm256_unpackhi_epi32( a[4], a[6] );
+  b[6] = _mm256_unpacklo_epi32( a[5], a[7] ); b[7] = _mm256_unpackhi_epi32( a[5], a[7] );
+  m[0] = _mm256_unpacklo_epi64( b[0], b[4] ); m[1] = _mm256_unpackhi_epi64( b[0], b[4] );
+  m[2] = _mm256_unpacklo_epi64( b[1], b[5] ); m[3] = _mm256_unpackhi_epi64( b[1], b[5] );
+  m[4] = _mm256_unpacklo_epi64( b[2], b[6] ); m[5] = _mm256_unpackhi_epi64( b[2], b[6] );
+  m[6] = _mm256_unpacklo_epi64( b[3], b[7] ); m[7] = _mm256_unpackhi_epi64( b[3], b[7] );
+
+  // horizontal
+  simdHAD8TwoStagesAVX2( m );
+  __m256i vMax = _mm256_max_epi16( _mm256_abs_epi16( m[0] ), _mm256_abs_epi16( m[1] ) );
+  __m256i vSum = _mm256_madd_epi16( vMax, _mm256_set1_epi16( 1 ) );
+  for( Int k = 2; k < 8; k += 2 )
+  {
+    vMax = _mm256_max_epi16( _mm256_abs_epi16( m[k] ), _mm256_abs_epi16( m[k+1] ) );
+    vSum = _mm256_add_epi32( vSum, _mm256_madd_epi16( vMax, _mm256_set1_epi16( 1 ) ) );
+  }
+
+  // each lane holds half of the SATD of its block, which is rounded on its own as in simdHADs8x8
+  vSum = _mm256_add_epi32( vSum , _mm256_shuffle_epi32( vSum , _MM_SHUFFLE( 1 , 0 , 3 , 2 ) ) );
+  vSum = _mm256_add_epi32( vSum , _mm256_shuffle_epi32( vSum , _MM_SHUFFLE( 2 , 3 , 0 , 1 ) ) );
+  UInt sad = ( ( (UInt)_mm256_extract_epi32( vSum, 0 ) << 1 ) + 2 ) >> 2;
+  if( bPair )
+  {
+    sad += ( ( (UInt)_mm256_extract_epi32( vSum, 4 ) << 1 ) + 2 ) >> 2;
+  }
+  return( sad );
+}
+
+// Hadamard SATD of a 4x4 block, with the rounding of xCalcHADs4x4
+SIMD_TARGET_AVX2 static UInt simdHADs4x4AVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m128i m[4];
+  for( Int k = 0; k < 4; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm_sub_epi16( _mm_loadl_epi64( ( const __m128i* )piOrg ), _mm_loadl_epi64( ( const __m128i* )piCur ) );
+  }
+
+  // vertical
+  __m128i t0 = _mm_add_epi16( m[0], m[2] ), t1 = _mm_add_epi16( m[1], m[3] );
+  __m128i t2 = _mm_sub_epi16( m[0], m[2] ), t3 = _mm_sub_epi16( m[1], m[3] );
+  m[0] = _mm_add_epi16( t0, t1 ); m[1] = _mm_sub_epi16( t0, t1 );
+  m[2] = _mm_add_epi16( t2, t3 ); m[3] = _mm_sub_epi16( t2, t3 );
+
+  // transpose: columns 0 and 1 in the halves of c01, columns 2 and 3 in the halves of c23
+  __m128i c01 = _mm_unpacklo_epi32( _mm_unpacklo_epi16( m[0], m[1] ), _mm_unpacklo_epi16( m[2], m[3] ) );
+  __m128i c23 = _mm_unpackhi_epi32( _mm_unpacklo_epi16( m[0], m[1] ), _mm_unpacklo_epi16( m[2], m[3] ) );
+
+  // horizontal, with the last stage as 2*max(|a|,|b|)
+  __m128i x = _mm_abs_epi16( _mm_add_epi16( c01, c23 ) );
+  __m128i y = _mm_abs_epi16( _mm_sub_epi16( c01, c23 ) );
+  x = _mm_max_epi16( x, _mm_shuffle_epi32( x, _MM_SHUFFLE( 1 , 0 , 3 , 2 ) ) );
+  y = _mm_max_epi16( y, _mm_shuffle_epi32( y, _MM_SHUFFLE( 1 , 0 , 3 , 2 ) ) );
+  __m128i sum = _mm_madd_epi16( _mm_unpacklo_epi64( x, y ), _mm_set1_epi16( 1 ) );
+  sum = _mm_add_epi32( sum , _mm_shuffle_epi32( sum , _MM_SHUFFLE( 1 , 0 , 3 , 2 ) ) );
+  sum = _mm_add_epi32( sum , _mm_shuffle_epi32( sum , _MM_SHUFFLE( 2 , 3 , 0 , 1 ) ) );
+
+  // ( 2 * sum + 1 ) >> 1
+  return( (UInt)_mm_cvtsi128_si32( sum ) );
+}
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // SAD
 // --------------------------------------------------------------------------------------------------------------------
@@ -1823,4 +2247,199 @@ Distortion TComRdCost::xGetHADs( DistParam* pcDtParam )
   return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
 }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2
+// --------------------------------------------------------------------------------------------------------------------
+
+template<Int iWidth>
+Distortion TComRdCost::xGetSSEAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  return simdSSEAVX2<iWidth>( pcDtParam->pOrg, pcDtParam->pCur, pcDtParam->iStrideOrg, pcDtParam->iStrideCur, pcDtParam->iRows, pcDtParam->iCols, uiShift );
+}
+
+template<Int iWidth>
+Distortion TComRdCost::xGetSADAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  if( pcDtParam->bitDepth > 10 )
+  {
+    switch( iWidth )
+    {
+      case  4: return xGetSAD4 ( pcDtParam );
+      case  8: return xGetSAD8 ( pcDtParam );
+      case 12: return xGetSAD12( pcDtParam );
+      case 16: return xGetSAD16( pcDtParam );
+      case 24: return xGetSAD24( pcDtParam );
+      case 32: return xGetSAD32( pcDtParam );
+      case 48: return xGetSAD48( pcDtParam );
+      case 64: return xGetSAD64( pcDtParam );
+      default: return xGetSAD  ( pcDtParam );
+    }
+  }
+
+  // the any-width SAD does not subsample rows
+  const Int  iSubShift = iWidth != 0 ? pcDtParam->iSubShift : 0;
+  Distortion uiSum     = simdSADAVX2<iWidth>( pcDtParam->pOrg, pcDtParam->pCur, pcDtParam->iStrideOrg << iSubShift, pcDtParam->iStrideCur << iSubShift,
+                                              pcDtParam->iRows >> iSubShift, pcDtParam->iCols );
+
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+Distortion TComRdCost::xGetHADsAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight || pcDtParam->bitDepth > 10 )
+  {
+    return xGetHADs( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iRows      = pcDtParam->iRows;
+  const Int  iCols      = pcDtParam->iCols;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStep      = pcDtParam->iStep;
+
+  Int  x, y;
+
+  Distortion uiSum = 0;
+
+  if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<3;
+    Int  iOffsetCur = iStrideCur<<3;
+    for ( y=0; y<iRows; y+= 8 )
+    {
+      for ( x=0; x+16<=iCols; x+= 16 )
+      {
+        uiSum += simdHADs8x8AVX2( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, true );
+      }
+      if( x < iCols )
+      {
+        uiSum += simdHADs8x8AVX2( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, false );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else if( ( iRows % 4 == 0) && (iCols % 4 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<2;
+    Int  iOffsetCur = iStrideCur<<2;
+
+    for ( y=0; y<iRows; y+= 4 )
+    {
+      for ( x=0; x<iCols; x+= 4 )
+      {
+        uiSum += simdHADs4x4AVX2( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else
+  {
+    return xGetHADs( pcDtParam );
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+#endif
+
+Void TComRdCost::getSADs( const DistParam& rcDistParam, const Pel* const* piCurs, Int numCands, Distortion* puiSads )
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  // the widths with their own SAD function, which all honour iSubShift
+  const Int  iCols          = rcDistParam.iCols;
+  const Bool bFixedWidthSAD = iCols == 4 || iCols == 8 || iCols == 12 || iCols == 16 || iCols == 24 || iCols == 32 || iCols == 48 || iCols == 64;
+  if( bFixedWidthSAD && !rcDistParam.bApplyWeight && rcDistParam.bitDepth <= 10 && getSIMDLevel() >= SIMD_AVX2 )
+  {
+    const Int  iSubShift = rcDistParam.iSubShift;
+    const UInt uiShift   = DISTORTION_PRECISION_ADJUSTMENT(rcDistParam.bitDepth-8);
+    for( Int i = 0; i < numCands; i += 4 )
+    {
+      // a last group of fewer than four candidates repeats its last one
+      const Pel* piCurs4[4];
+      Distortion uiSads4[4];
+      for( Int k = 0; k < 4; k++ )
+      {
+        piCurs4[k] = piCurs[std::min( i + k, numCands - 1 )];
+      }
+      simdSADsX4AVX2( rcDistParam.pOrg, piCurs4, rcDistParam.iStrideOrg << iSubShift, rcDistParam.iStrideCur << iSubShift,
+                      rcDistParam.iRows >> iSubShift, iCols, uiSads4 );
+      for( Int k = 0; k < 4 && i + k < numCands; k++ )
+      {
+        puiSads[i + k] = ( uiSads4[k] << iSubShift ) >> uiShift;
+      }
+    }
+    return;
+  }
+#endif
+
+  DistParam cDistParam = rcDistParam;
+  cDistParam.m_maximumDistortionForEarlyExit = std::numeric_limits<Distortion>::max();
+  for( Int i = 0; i < numCands; i++ )
+  {
+    cDistParam.pCur = piCurs[i];
+    puiSads[i]      = cDistParam.DistFunc( &cDistParam );
+  }
+}
+
+Void TComRdCost::getSADs8( const DistParam& rcDistParam, const UChar* piOrg, Int iStrideOrg, const UChar* const* piCurs, Int iStrideCur, Int numCands, Distortion* puiSads )
+{
+  const Int iSubShift = rcDistParam.iSubShift;
+  const Int iRows     = rcDistParam.iRows >> iSubShift;
+  const Int iCols     = rcDistParam.iCols;
+  iStrideOrg <<= iSubShift;
+  iStrideCur <<= iSubShift;
+
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( ( iCols & 3 ) == 0 && getSIMDLevel() >= SIMD_AVX2 )
+  {
+    Int i = 0;
+    for( ; i + 4 <= numCands; i += 4 )
+    {
+      simdSADs8AVX2<4>( piOrg, piCurs + i, iStrideOrg, iStrideCur, iRows, iCols, puiSads + i );
+    }
+    for( ; i < numCands; i++ )
+    {
+      simdSADs8AVX2<1>( piOrg, piCurs + i, iStrideOrg, iStrideCur, iRows, iCols, puiSads + i );
+    }
+    for( i = 0; i < numCands; i++ )
+    {
+      puiSads[i] <<= iSubShift;
+    }
+    return;
+  }
+#endif
+
+  for( Int i = 0; i < numCands; i++ )
+  {
+    const UChar* piO   = piOrg;
+    const UChar* piC   = piCurs[i];
+    Distortion   uiSum = 0;
+    for( Int y = 0; y < iRows; y++ )
+    {
+      for( Int x = 0; x < iCols; x++ )
+      {
+        uiSum += abs( piO[x] - piC[x] );
+      }
+      piO += iStrideOrg;
+      piC += iStrideCur;
+    }
+    puiSads[i] = uiSum << iSubShift;
+  }
+}
+
+
 //! \}
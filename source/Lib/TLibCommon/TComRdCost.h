@@ -204,10 +204,27 @@ private:
 #endif
                                       );
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  // AVX2 versions, selected by init() when the CPU supports AVX2. iWidth 0 is the any-width version.
+  template<Int iWidth>
+  static Distortion xGetSSEAVX2       ( DistParam* pcDtParam );
+  template<Int iWidth>
+  static Distortion xGetSADAVX2       ( DistParam* pcDtParam );
+  static Distortion xGetHADsAVX2      ( DistParam* pcDtParam );
+#endif
+
 public:
 
   Distortion   getDistPart(Int bitDepth, const Pel* piCur, Int iCurStride, const Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc = DF_SSE );
 
+  // SADs of the block set up for SAD in rcDistParam at numCands reference positions piCurs (rcDistParam.pCur is not used),
+  // equal to what rcDistParam.DistFunc returns for each of them without early termination
+  static Void  getSADs( const DistParam& rcDistParam, const Pel* const* piCurs, Int numCands, Distortion* puiSads );
+
+  // as getSADs, for 8-bit copies of the original block and of the reference (internal bit-depth 8 and no weighting),
+  // with the block size and subsampling taken from rcDistParam
+  static Void  getSADs8( const DistParam& rcDistParam, const UChar* piOrg, Int iStrideOrg, const UChar* const* piCurs, Int iStrideCur, Int numCands, Distortion* puiSads );
+
 };// END CLASS DEFINITION TComRdCost
 
 //! \}
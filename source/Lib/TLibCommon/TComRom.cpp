@@ -175,9 +175,16 @@ public:
   }
 };
 
+static UInt g_romUsers = 0; ///< number of codec instances sharing the tables, several encoders may run in one process
+
 // initialize ROM variables
 Void initROM()
 {
+  if ( g_romUsers++ > 0 )
+  {
+    return;
+  }
+
   Int i, c;
 
   // g_aucConvertToBit[ x ]: log2(x/4), if x=4 -> 0, x=8 -> 1, x=16 -> 2, ...
@@ -262,6 +269,11 @@ Void initROM()
 
 Void destroyROM()
 {
+  if ( g_romUsers == 0 || --g_romUsers > 0 )
+  {
+    return;
+  }
+
   for(UInt groupTypeIndex = 0; groupTypeIndex < SCAN_NUMBER_OF_GROUP_TYPES; groupTypeIndex++)
   {
     for (UInt scanOrderIndex = 0; scanOrderIndex < SCAN_NUMBER_OF_TYPES; scanOrderIndex++)
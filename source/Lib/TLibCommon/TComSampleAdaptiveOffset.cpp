@@ -41,6 +41,11 @@
 #include <stdio.h>
 #include <math.h>
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -310,6 +315,161 @@ Void TComSampleAdaptiveOffset::reconstructBlkSAOParams(TComPic* pic, SAOBlkParam
 }
 
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 kernels
+// ====================================================================================================================
+
+// lane masks for the last, partial group of 16 samples of a row: loading at s_tailMask + 16 - n enables n lanes
+static const Short s_tailMask[32] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                       0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 };
+
+/// sgn( cur - a ) + sgn( cur - b ) + 2, i.e. the edge offset class of each sample
+SIMD_TARGET_AVX2 static inline __m256i simdSaoEdgeIdxAVX2( const __m256i &mmCur, const __m256i &mmA, const __m256i &mmB )
+{
+  const __m256i signA = _mm256_sub_epi16( _mm256_cmpgt_epi16( mmA, mmCur ), _mm256_cmpgt_epi16( mmCur, mmA ) );
+  const __m256i signB = _mm256_sub_epi16( _mm256_cmpgt_epi16( mmB, mmCur ), _mm256_cmpgt_epi16( mmCur, mmB ) );
+  return _mm256_add_epi16( _mm256_add_epi16( signA, signB ), _mm256_set1_epi16( 2 ) );
+}
+
+/** applies the edge offset to the samples [startX, endX) of one line. srcA and srcB point to the two neighbours of
+ *  srcLine[0] in the direction of the edge offset class, so the result does not depend on the sign line buffers.
+ */
+SIMD_TARGET_AVX2 static Void simdSaoEdgeLineAVX2( const Pel* srcLine, const Pel* srcA, const Pel* srcB, Pel* resLine, Int startX, Int endX,
+                                                  const __m256i &mmOffset, const __m256i &mmMax )
+{
+  for( Int x = startX; x < endX; x += 16 )
+  {
+    const __m256i mmCur   = _mm256_loadu_si256( ( const __m256i* )( srcLine + x ) );
+    const __m256i mmIdx   = simdSaoEdgeIdxAVX2( mmCur, _mm256_loadu_si256( ( const __m256i* )( srcA + x ) ), _mm256_loadu_si256( ( const __m256i* )( srcB + x ) ) );
+    // look up the 16-bit offsets with a byte shuffle: lane i reads bytes 2*idx and 2*idx+1 of the offset table
+    const __m256i mmShuf  = _mm256_add_epi16( _mm256_mullo_epi16( mmIdx, _mm256_set1_epi16( 0x0202 ) ), _mm256_set1_epi16( 0x0100 ) );
+    __m256i       mmRes   = _mm256_add_epi16( mmCur, _mm256_shuffle_epi8( mmOffset, mmShuf ) );
+    mmRes = _mm256_min_epi16( _mm256_max_epi16( mmRes, _mm256_setzero_si256() ), mmMax );
+    if( endX - x < 16 )
+    {
+      const __m256i mmValid = _mm256_loadu_si256( ( const __m256i* )( s_tailMask + 16 - ( endX - x ) ) );
+      mmRes = _mm256_blendv_epi8( _mm256_loadu_si256( ( const __m256i* )( resLine + x ) ), mmRes, mmValid );
+    }
+    _mm256_storeu_si256( ( __m256i* )( resLine + x ), mmRes );
+  }
+}
+
+/** AVX2 version of TComSampleAdaptiveOffset::offsetBlock for bit depths up to 10; the same samples are modified
+ */
+SIMD_TARGET_AVX2 static Void simdOffsetBlockAVX2( const Int channelBitDepth, Int typeIdx, const Int* offset
+                                                , const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height
+                                                , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail )
+{
+  const __m256i mmMax = _mm256_set1_epi16( ( 1 << channelBitDepth ) - 1 );
+
+  if( typeIdx == SAO_TYPE_BO )
+  {
+    const Int     shiftBits = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
+    const __m128i mmShift   = _mm_cvtsi32_si128( shiftBits );
+    __m256i mmBand[NUM_SAO_BO_CLASSES], mmBandOffset[NUM_SAO_BO_CLASSES];
+    Int     numBands = 0;
+    for( Int band = 0; band < NUM_SAO_BO_CLASSES; band++ )
+    {
+      if( offset[band] != 0 )
+      {
+        mmBand[numBands]       = _mm256_set1_epi16( band );
+        mmBandOffset[numBands] = _mm256_set1_epi16( offset[band] );
+        numBands++;
+      }
+    }
+    for( Int y = 0; y < height; y++ )
+    {
+      for( Int x = 0; x < width; x += 16 )
+      {
+        const __m256i mmCur  = _mm256_loadu_si256( ( const __m256i* )( srcBlk + x ) );
+        const __m256i mmBIdx = _mm256_sra_epi16( mmCur, mmShift );
+        __m256i       mmRes  = mmCur;
+        for( Int n = 0; n < numBands; n++ )
+        {
+          mmRes = _mm256_add_epi16( mmRes, _mm256_and_si256( _mm256_cmpeq_epi16( mmBIdx, mmBand[n] ), mmBandOffset[n] ) );
+        }
+        mmRes = _mm256_min_epi16( _mm256_max_epi16( mmRes, _mm256_setzero_si256() ), mmMax );
+        if( width - x < 16 )
+        {
+          const __m256i mmValid = _mm256_loadu_si256( ( const __m256i* )( s_tailMask + 16 - ( width - x ) ) );
+          mmRes = _mm256_blendv_epi8( _mm256_loadu_si256( ( const __m256i* )( resBlk + x ) ), mmRes, mmValid );
+        }
+        _mm256_storeu_si256( ( __m256i* )( resBlk + x ), mmRes );
+      }
+      srcBlk += srcStride;
+      resBlk += resStride;
+    }
+    return;
+  }
+
+  const __m256i mmOffset = _mm256_broadcastsi128_si256( _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 ) );
+  const Int     startX   = isLeftAvail  ? 0 : 1;
+  const Int     endX     = isRightAvail ? width : ( width - 1 );
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+    {
+      for( Int y = 0; y < height; y++ )
+      {
+        simdSaoEdgeLineAVX2( srcBlk, srcBlk - 1, srcBlk + 1, resBlk, startX, endX, mmOffset, mmMax );
+        srcBlk += srcStride;
+        resBlk += resStride;
+      }
+    }
+    break;
+  case SAO_TYPE_EO_90:
+    {
+      const Int startY = isAboveAvail ? 0 : 1;
+      const Int endY   = isBelowAvail ? height : ( height - 1 );
+      for( Int y = startY; y < endY; y++ )
+      {
+        const Pel* srcLine = srcBlk + y * srcStride;
+        simdSaoEdgeLineAVX2( srcLine, srcLine - srcStride, srcLine + srcStride, resBlk + y * resStride, 0, width, mmOffset, mmMax );
+      }
+    }
+    break;
+  case SAO_TYPE_EO_135:
+  case SAO_TYPE_EO_45:
+    {
+      // the neighbours are above-left/below-right for 135 degrees and above-right/below-left for 45 degrees
+      const Int dirX = ( typeIdx == SAO_TYPE_EO_135 ) ? 1 : -1;
+      Int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
+      if( typeIdx == SAO_TYPE_EO_135 )
+      {
+        firstLineStartX = isAboveLeftAvail  ? 0 : 1;
+        firstLineEndX   = isAboveAvail      ? endX : 1;
+        lastLineStartX  = isBelowAvail      ? startX : ( width - 1 );
+        lastLineEndX    = isBelowRightAvail ? width : ( width - 1 );
+      }
+      else
+      {
+        firstLineStartX = isAboveAvail      ? startX : ( width - 1 );
+        firstLineEndX   = isAboveRightAvail ? width : ( width - 1 );
+        lastLineStartX  = isBelowLeftAvail  ? 0 : 1;
+        lastLineEndX    = isBelowAvail      ? endX : 1;
+      }
+
+      for( Int y = 0; y < height; y++ )
+      {
+        const Int  lineStartX = ( y == 0 ) ? firstLineStartX : ( ( y == height - 1 ) ? lastLineStartX : startX );
+        const Int  lineEndX   = ( y == 0 ) ? firstLineEndX   : ( ( y == height - 1 ) ? lastLineEndX   : endX );
+        const Pel* srcLine    = srcBlk + y * srcStride;
+        simdSaoEdgeLineAVX2( srcLine, srcLine - srcStride - dirX, srcLine + srcStride + dirX, resBlk + y * resStride, lineStartX, lineEndX, mmOffset, mmMax );
+      }
+    }
+    break;
+  default:
+    {
+      printf("Not a supported SAO types\n");
+      assert(0);
+      exit(-1);
+    }
+  }
+}
+#endif
+
 Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset
                                           , Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
                                           , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
@@ -333,6 +493,15 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
     m_signLineBuf2 = new SChar[m_lineBufWidth+1];
   }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (channelBitDepth <= 10 && getSIMDLevel() >= SIMD_AVX2)
+  {
+    simdOffsetBlockAVX2(channelBitDepth, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                        , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail);
+    return;
+  }
+#endif
+
   const Int maxSampleValueIncl = (1<< channelBitDepth )-1;
 
   Int x,y, startX, startY, endX, endY, edgeType;
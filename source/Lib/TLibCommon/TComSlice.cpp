@@ -107,6 +107,7 @@ TComSlice::TComSlice()
 , m_LFCrossSliceBoundaryFlag      ( false )
 , m_enableTMVPFlag                ( true )
 , m_encCABACTableIdx              (I_SLICE)
+, m_picOrderCnt                   ( 0 )
 {
   for(UInt i=0; i<NUM_REF_PIC_LIST_01; i++)
   {
@@ -345,6 +346,10 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
       pcRefPic->setIsLongTerm(0);
+#if REDUCED_ENCODER_MEMORY
+      // a compressed picture is only restored below if it stays in the truncated lists
+      if (!pcRefPic->isReconstructionCompressed())
+#endif
       pcRefPic->getPicYuvRec()->extendPicBorder();
       RefPicSetStCurr0[NumPicStCurr0] = pcRefPic;
       NumPicStCurr0++;
@@ -358,6 +363,9 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
       pcRefPic->setIsLongTerm(0);
+#if REDUCED_ENCODER_MEMORY
+      if (!pcRefPic->isReconstructionCompressed())
+#endif
       pcRefPic->getPicYuvRec()->extendPicBorder();
       RefPicSetStCurr1[NumPicStCurr1] = pcRefPic;
       NumPicStCurr1++;
@@ -371,6 +379,9 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetLongTermRefPic(rcListPic, m_pRPS->getPOC(i), m_pRPS->getCheckLTMSBPresent(i));
       pcRefPic->setIsLongTerm(1);
+#if REDUCED_ENCODER_MEMORY
+      if (!pcRefPic->isReconstructionCompressed())
+#endif
       pcRefPic->getPicYuvRec()->extendPicBorder();
       RefPicSetLtCurr[NumPicLtCurr] = pcRefPic;
       NumPicLtCurr++;
@@ -464,6 +475,16 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
       m_bIsUsedAsLongTerm[REF_PIC_LIST_1][rIdx] = ( cIdx >= NumPicStCurr0 + NumPicStCurr1 );
     }
   }
+
+#if REDUCED_ENCODER_MEMORY
+  for (UInt list = 0; list < NUM_REF_PIC_LIST_01; list++)
+  {
+    for (Int rIdx = 0; rIdx < m_aiNumRefIdx[list]; rIdx++)
+    {
+      m_apcRefPicList[list][rIdx]->decompressReconstruction();
+    }
+  }
+#endif
 }
 
 Int TComSlice::getNumRpsCurrTempList() const
@@ -0,0 +1,190 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSubPelPlanes.cpp
+    \brief    luma sub-sample planes of a reference picture
+*/
+
+#include <cstdlib>
+#include <assert.h>
+#include "TComSubPelPlanes.h"
+#include "TComPicYuv.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+TComSubPelPlanes::TComSubPelPlanes()
+: m_pcPicYuv      ( NULL )
+, m_bHalfPelOnly  ( false )
+, m_bitDepth      ( 0 )
+, m_bandHeight    ( 0 )
+, m_numBands      ( 0 )
+, m_areaMarginX   ( 0 )
+, m_areaMarginY   ( 0 )
+, m_pIntermediate ( NULL )
+{
+  for( Int fracY = 0; fracY < 4; fracY++ )
+  {
+    for( Int fracX = 0; fracX < 4; fracX++ )
+    {
+      m_apiPlaneBuf[fracY][fracX] = NULL;
+      m_apiPlaneOrg[fracY][fracX] = NULL;
+    }
+  }
+}
+
+TComSubPelPlanes::~TComSubPelPlanes()
+{
+  destroy();
+}
+
+Void TComSubPelPlanes::create( const TComPicYuv* pcPicYuv, const UInt bandHeight, const Bool bHalfPelOnly, const Int bitDepth )
+{
+  destroy();
+
+  m_pcPicYuv     = pcPicYuv;
+  m_bHalfPelOnly = bHalfPelOnly;
+  m_bitDepth     = bitDepth;
+  m_bandHeight   = bandHeight;
+  m_numBands     = ( pcPicYuv->getHeight( COMPONENT_Y ) + bandHeight - 1 ) / bandHeight;
+
+  // the interpolation filters read up to 4 samples beyond each computed position, which must stay inside the margin.
+  // Motion vectors are clipped so that a block never starts more than one CTU and 8 samples outside the picture,
+  // which leaves it within the computed area.
+  m_areaMarginX  = pcPicYuv->getMarginX( COMPONENT_Y ) - ( NTAPS_LUMA >> 1 );
+  m_areaMarginY  = pcPicYuv->getMarginY( COMPONENT_Y ) - ( NTAPS_LUMA >> 1 );
+  m_bandValid.assign( m_numBands, false );
+
+  m_apiPlaneOrg[0][0] = pcPicYuv->getAddr( COMPONENT_Y );
+}
+
+Void TComSubPelPlanes::destroy()
+{
+  for( Int fracY = 0; fracY < 4; fracY++ )
+  {
+    for( Int fracX = 0; fracX < 4; fracX++ )
+    {
+      if( m_apiPlaneBuf[fracY][fracX] )
+      {
+        xFree( m_apiPlaneBuf[fracY][fracX] );
+        m_apiPlaneBuf[fracY][fracX] = NULL;
+      }
+      m_apiPlaneOrg[fracY][fracX] = NULL;
+    }
+  }
+  if( m_pIntermediate )
+  {
+    xFree( m_pIntermediate );
+    m_pIntermediate = NULL;
+  }
+  m_bandValid.clear();
+  m_pcPicYuv = NULL;
+}
+
+Void TComSubPelPlanes::reset()
+{
+  m_bandValid.assign( m_numBands, false );
+}
+
+Int TComSubPelPlanes::getStride() const
+{
+  return m_pcPicYuv->getStride( COMPONENT_Y );
+}
+
+Void TComSubPelPlanes::xAllocate()
+{
+  const Int stride      = m_pcPicYuv->getStride( COMPONENT_Y );
+  const Int planeSize   = stride * m_pcPicYuv->getTotalHeight( COMPONENT_Y );
+  const Int planeOffset = m_pcPicYuv->getMarginY( COMPONENT_Y ) * stride + m_pcPicYuv->getMarginX( COMPONENT_Y );
+
+  for( Int fracY = 0; fracY < 4; fracY++ )
+  {
+    for( Int fracX = 0; fracX < 4; fracX++ )
+    {
+      if( ( fracY | fracX ) != 0 && hasPlane( fracY, fracX ) )
+      {
+        m_apiPlaneBuf[fracY][fracX] = (Pel*)xMalloc( Pel, planeSize );
+        m_apiPlaneOrg[fracY][fracX] = m_apiPlaneBuf[fracY][fracX] + planeOffset;
+      }
+    }
+  }
+
+  const Int areaWidth   = m_pcPicYuv->getWidth( COMPONENT_Y ) + 2 * m_areaMarginX;
+  const Int maxBandRows = m_bandHeight + 2 * m_areaMarginY;
+  m_pIntermediate = (Pel*)xMalloc( Pel, areaWidth * ( maxBandRows + NTAPS_LUMA - 1 ) );
+}
+
+/** computes all planes for the rows of one band. The first and the last band also cover the margin above and below
+ *  the picture. Each position is filtered horizontally into the intermediate buffer and then vertically, as in the
+ *  motion compensation, so the samples are identical to those of the block based interpolation.
+ */
+Void TComSubPelPlanes::xComputeBand( Int band )
+{
+  if( m_pIntermediate == NULL )
+  {
+    xAllocate();
+  }
+
+  const Int picHeight    = m_pcPicYuv->getHeight( COMPONENT_Y );
+  const Int stride       = m_pcPicYuv->getStride( COMPONENT_Y );
+  const Int yTop         = band == 0              ? -m_areaMarginY            : band * m_bandHeight;
+  const Int yBottom      = band == m_numBands - 1 ? picHeight + m_areaMarginY : ( band + 1 ) * m_bandHeight;
+  const Int rows         = yBottom - yTop;
+  const Int areaWidth    = m_pcPicYuv->getWidth( COMPONENT_Y ) + 2 * m_areaMarginX;
+  const Int areaOffset   = yTop * stride - m_areaMarginX;
+  const Int planeOffset  = m_pcPicYuv->getMarginY( COMPONENT_Y ) * stride + m_pcPicYuv->getMarginX( COMPONENT_Y );
+  const Int halfTaps     = NTAPS_LUMA >> 1;
+  const Int fracStep     = m_bHalfPelOnly ? 2 : 1;
+  const ChromaFormat fmt = m_pcPicYuv->getChromaFormat();
+
+  Pel* src = const_cast<Pel*>( m_pcPicYuv->getAddr( COMPONENT_Y ) ) + areaOffset;
+
+  for( Int fracX = 0; fracX < 4; fracX += fracStep )
+  {
+    m_if.filterHor( COMPONENT_Y, src - ( halfTaps - 1 ) * stride, stride, m_pIntermediate, areaWidth, areaWidth, rows + NTAPS_LUMA - 1, fracX, false, fmt, m_bitDepth );
+
+    for( Int fracY = 0; fracY < 4; fracY += fracStep )
+    {
+      if( ( fracY | fracX ) == 0 )
+      {
+        continue;
+      }
+      Pel* dst = m_apiPlaneBuf[fracY][fracX] + planeOffset + areaOffset;
+      m_if.filterVer( COMPONENT_Y, m_pIntermediate + ( halfTaps - 1 ) * areaWidth, areaWidth, dst, stride, areaWidth, rows, fracY, false, true, fmt, m_bitDepth );
+    }
+  }
+
+  m_bandValid[band] = true;
+}
+
+//! \}
@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSubPelPlanes.h
+    \brief    luma sub-sample planes of a reference picture (header)
+*/
+
+#ifndef __TCOMSUBPELPLANES__
+#define __TCOMSUBPELPLANES__
+
+#include <vector>
+#include "CommonDef.h"
+#include "TComInterpolationFilter.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+class TComPicYuv;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** Luma samples of a reference picture at the 15 fractional positions (or only at the 3 half-sample positions),
+ *  interpolated with the same filters as the motion compensation and computed band by band when first needed.
+ *  Each plane has the layout of the luma plane of the reference picture, so that an offset into the picture
+ *  addresses the same position in every plane. The plane at (0, 0) is the reference picture itself.
+ */
+class TComSubPelPlanes
+{
+private:
+  const TComPicYuv*     m_pcPicYuv;                     ///< reference picture the planes are derived from
+  Bool                  m_bHalfPelOnly;                 ///< only the planes at (0,2), (2,0) and (2,2) are kept
+  Int                   m_bitDepth;
+  Int                   m_bandHeight;                   ///< height of a band, normally the CTU height
+  Int                   m_numBands;
+  Int                   m_areaMarginX;                  ///< samples computed to the left and right of the picture
+  Int                   m_areaMarginY;                  ///< samples computed above and below the picture
+  std::vector<Bool>     m_bandValid;
+
+  Pel*                  m_apiPlaneBuf[4][4];            ///< buffers (including margin), allocated when first needed
+  const Pel*            m_apiPlaneOrg[4][4];            ///< top left sample of the picture area in each plane
+  Pel*                  m_pIntermediate;                ///< horizontally filtered rows of one band
+
+  TComInterpolationFilter m_if;
+
+  Void  xAllocate();
+  Void  xComputeBand( Int band );
+
+public:
+  TComSubPelPlanes();
+  ~TComSubPelPlanes();
+
+  Void  create      ( const TComPicYuv* pcPicYuv, const UInt bandHeight, const Bool bHalfPelOnly, const Int bitDepth );
+  Void  destroy     ();
+
+  /// marks all bands as out of date, to be called when the picture is reconstructed again
+  Void  reset       ();
+
+  /// makes sure that all planes are up to date for the luma rows yTop to yBottom (inclusive, may lie in the margin)
+  Void  prepareRows ( const Int yTop, const Int yBottom )
+  {
+    const Int firstBand = xGetBand( yTop );
+    const Int lastBand  = xGetBand( yBottom );
+    for( Int band = firstBand; band <= lastBand; band++ )
+    {
+      if( !m_bandValid[band] )
+      {
+        xComputeBand( band );
+      }
+    }
+  }
+
+  Bool        isHalfPelOnly ()                                const { return m_bHalfPelOnly; }
+  Bool        hasPlane      ( const Int fracY, const Int fracX ) const { return !m_bHalfPelOnly || ( ( fracY | fracX ) & 1 ) == 0; }
+  Int         getStride     ()                                const;
+
+  /// top left sample of the picture area in the plane at vertical fraction fracY and horizontal fraction fracX (in quarter samples)
+  const Pel*  getAddr       ( const Int fracY, const Int fracX ) const { return m_apiPlaneOrg[fracY][fracX]; }
+
+private:
+  Int   xGetBand    ( const Int y ) const { return y < 0 ? 0 : std::min( y / m_bandHeight, m_numBands - 1 ); }
+};
+
+//! \}
+
+#endif // __TCOMSUBPELPLANES__
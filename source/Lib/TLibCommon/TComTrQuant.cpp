@@ -45,6 +45,11 @@
 #include "TComTU.h"
 #include "Debug.h"
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
+
 typedef struct
 {
   Int    iNNZbeforePos0;
@@ -130,7 +135,7 @@ TComTrQuant::TComTrQuant()
 
   // allocate bit estimation class  (for RDOQ)
   m_pcEstBitsSbac = new estBitsSbacStruct;
-  initScalingList();
+  m_pcScalingListTables = NULL;
 }
 
 TComTrQuant::~TComTrQuant()
@@ -147,7 +152,7 @@ TComTrQuant::~TComTrQuant()
   {
     delete m_pcEstBitsSbac;
   }
-  destroyScalingList();
+  TComScalingListTables::release(m_pcScalingListTables);
 }
 
 #if ADAPTIVE_QP_SELECTION
@@ -847,6 +852,381 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
   }
 }
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// The AVX2 transforms process eight lines at once, one per 32-bit lane, with the same 32-bit arithmetic as the
+// partial butterflies above, so they are bit-exact with them. Lines that are not present (line == 4) are zero.
+
+template<Int N> static inline const TMatrixCoeff* simdTransformMatrix( Int direction );
+template<> inline const TMatrixCoeff* simdTransformMatrix< 4>( Int direction ) { return &g_aiT4 [direction][0][0]; }
+template<> inline const TMatrixCoeff* simdTransformMatrix< 8>( Int direction ) { return &g_aiT8 [direction][0][0]; }
+template<> inline const TMatrixCoeff* simdTransformMatrix<16>( Int direction ) { return &g_aiT16[direction][0][0]; }
+template<> inline const TMatrixCoeff* simdTransformMatrix<32>( Int direction ) { return &g_aiT32[direction][0][0]; }
+
+SIMD_TARGET_AVX2 static inline Void simdTranspose8x8x32AVX2( __m256i* r )
+{
+  __m256i t[8], u[8];
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    t[k]   = _mm256_unpacklo_epi32( r[k], r[k+1] );
+    t[k+1] = _mm256_unpackhi_epi32( r[k], r[k+1] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    u[k]   = _mm256_unpacklo_epi64( t[k],   t[k+2] );
+    u[k+1] = _mm256_unpackhi_epi64( t[k],   t[k+2] );
+    u[k+2] = _mm256_unpacklo_epi64( t[k+1], t[k+3] );
+    u[k+3] = _mm256_unpackhi_epi64( t[k+1], t[k+3] );
+  }
+  for( Int k = 0; k < 4; k++ )
+  {
+    r[k]   = _mm256_permute2x128_si256( u[k], u[k+4], 0x20 );
+    r[k+4] = _mm256_permute2x128_si256( u[k], u[k+4], 0x31 );
+  }
+}
+
+// transposes the 4x4 blocks in both 128-bit lanes
+SIMD_TARGET_AVX2 static inline Void simdTranspose4x4x32AVX2( __m256i* r )
+{
+  __m256i t0 = _mm256_unpacklo_epi32( r[0], r[1] );
+  __m256i t1 = _mm256_unpackhi_epi32( r[0], r[1] );
+  __m256i t2 = _mm256_unpacklo_epi32( r[2], r[3] );
+  __m256i t3 = _mm256_unpackhi_epi32( r[2], r[3] );
+  r[0] = _mm256_unpacklo_epi64( t0, t2 );
+  r[1] = _mm256_unpackhi_epi64( t0, t2 );
+  r[2] = _mm256_unpacklo_epi64( t1, t3 );
+  r[3] = _mm256_unpackhi_epi64( t1, t3 );
+}
+
+SIMD_TARGET_AVX2 static inline __m256i simdLoadLinesAVX2( const TCoeff* src, Int numLines )
+{
+  if( numLines == 8 )
+  {
+    return _mm256_loadu_si256( ( const __m256i* )src );
+  }
+  return _mm256_inserti128_si256( _mm256_setzero_si256(), _mm_loadu_si128( ( const __m128i* )src ), 0 );
+}
+
+SIMD_TARGET_AVX2 static inline Void simdStoreLinesAVX2( TCoeff* dst, __m256i v, Int numLines )
+{
+  if( numLines == 8 )
+  {
+    _mm256_storeu_si256( ( __m256i* )dst, v );
+  }
+  else
+  {
+    _mm_storeu_si128( ( __m128i* )dst, _mm256_castsi256_si128( v ) );
+  }
+}
+
+// reads numLines rows of N coefficients and returns the N columns, one line per lane
+template<Int N>
+SIMD_TARGET_AVX2 static inline Void simdLoadColumnsAVX2( const TCoeff* src, Int numLines, __m256i* col )
+{
+  if( N == 4 )
+  {
+    for( Int k = 0; k < 4; k++ )
+    {
+      __m128i lo = _mm_loadu_si128( ( const __m128i* )( src + k * 4 ) );
+      __m128i hi = numLines == 8 ? _mm_loadu_si128( ( const __m128i* )( src + ( k + 4 ) * 4 ) ) : _mm_setzero_si128();
+      col[k] = _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 );
+    }
+    simdTranspose4x4x32AVX2( col );
+  }
+  else
+  {
+    for( Int b = 0; b < N; b += 8 )
+    {
+      for( Int k = 0; k < 8; k++ )
+      {
+        col[b+k] = k < numLines ? _mm256_loadu_si256( ( const __m256i* )( src + k * N + b ) ) : _mm256_setzero_si256();
+      }
+      simdTranspose8x8x32AVX2( col + b );
+    }
+  }
+}
+
+// inverse of simdLoadColumnsAVX2: writes numLines rows of N coefficients from N column vectors
+template<Int N>
+SIMD_TARGET_AVX2 static inline Void simdStoreColumnsAVX2( TCoeff* dst, Int numLines, __m256i* col )
+{
+  if( N == 4 )
+  {
+    simdTranspose4x4x32AVX2( col );
+    for( Int k = 0; k < 4; k++ )
+    {
+      _mm_storeu_si128( ( __m128i* )( dst + k * 4 ), _mm256_castsi256_si128( col[k] ) );
+      if( numLines == 8 )
+      {
+        _mm_storeu_si128( ( __m128i* )( dst + ( k + 4 ) * 4 ), _mm256_extracti128_si256( col[k], 1 ) );
+      }
+    }
+  }
+  else
+  {
+    for( Int b = 0; b < N; b += 8 )
+    {
+      simdTranspose8x8x32AVX2( col + b );
+      for( Int k = 0; k < numLines; k++ )
+      {
+        _mm256_storeu_si256( ( __m256i* )( dst + k * N + b ), col[b+k] );
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 static inline __m256i simdMultiplyAddAVX2( __m256i acc, TMatrixCoeff c, __m256i v )
+{
+  return _mm256_add_epi32( acc, _mm256_mullo_epi32( _mm256_set1_epi32( c ), v ) );
+}
+
+/** forward 1D transform of size N, equivalent to partialButterfly4/8/16/32
+ */
+template<Int N>
+SIMD_TARGET_AVX2 static Void simdPartialButterflyAVX2( const TCoeff* src, TCoeff* dst, Int shift, Int line )
+{
+  const TMatrixCoeff* T      = simdTransformMatrix<N>( TRANSFORM_FORWARD );
+  const __m256i       vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+
+  for( Int j = 0; j < line; j += 8 )
+  {
+    const Int numLines = std::min( 8, line - j );
+    __m256i v[N], E[N/2], O[N/2];
+    simdLoadColumnsAVX2<N>( src + j * N, numLines, v );
+
+    // split into even and odd parts; the odd parts of each level give the rows N/M * (2i+1)
+    for( Int M = N; M >= 4; M >>= 1 )
+    {
+      const Int step = N / M;
+      for( Int k = 0; k < M / 2; k++ )
+      {
+        E[k] = _mm256_add_epi32( v[k], v[M-1-k] );
+        O[k] = _mm256_sub_epi32( v[k], v[M-1-k] );
+      }
+      for( Int i = 0; i < M / 2; i++ )
+      {
+        const Int row = step * ( 2 * i + 1 );
+        __m256i acc = vAdd;
+        for( Int k = 0; k < M / 2; k++ )
+        {
+          acc = simdMultiplyAddAVX2( acc, T[row * N + k], O[k] );
+        }
+        simdStoreLinesAVX2( dst + row * line + j, _mm256_sra_epi32( acc, vShift ), numLines );
+      }
+      for( Int k = 0; k < M / 2; k++ )
+      {
+        v[k] = E[k];
+      }
+    }
+    for( Int row = 0; row < N; row += N / 2 )
+    {
+      __m256i acc = simdMultiplyAddAVX2( simdMultiplyAddAVX2( vAdd, T[row * N], v[0] ), T[row * N + 1], v[1] );
+      simdStoreLinesAVX2( dst + row * line + j, _mm256_sra_epi32( acc, vShift ), numLines );
+    }
+  }
+}
+
+/** inverse 1D transform of size N, equivalent to partialButterflyInverse4/8/16/32
+ */
+template<Int N>
+SIMD_TARGET_AVX2 static Void simdPartialButterflyInverseAVX2( const TCoeff* src, TCoeff* dst, Int shift, Int line, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const TMatrixCoeff* T      = simdTransformMatrix<N>( TRANSFORM_INVERSE );
+  const __m256i       vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i       vShift = _mm_cvtsi32_si128( shift );
+  const __m256i       vMin   = _mm256_set1_epi32( outputMinimum );
+  const __m256i       vMax   = _mm256_set1_epi32( outputMaximum );
+
+  for( Int j = 0; j < line; j += 8 )
+  {
+    const Int numLines = std::min( 8, line - j );
+    __m256i s[N], V[N], W[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      s[k] = simdLoadLinesAVX2( src + k * line + j, numLines );
+    }
+
+    // even part of rows 0 and N/2, then combine with the odd part of each level
+    for( Int k = 0; k < 2; k++ )
+    {
+      V[k] = simdMultiplyAddAVX2( _mm256_mullo_epi32( _mm256_set1_epi32( T[k] ), s[0] ), T[( N / 2 ) * N + k], s[N/2] );
+    }
+    for( Int M = 4; M <= N; M <<= 1 )
+    {
+      const Int step = N / M;
+      for( Int k = 0; k < M / 2; k++ )
+      {
+        __m256i odd = _mm256_setzero_si256();
+        for( Int i = 0; i < M / 2; i++ )
+        {
+          const Int row = step * ( 2 * i + 1 );
+          odd = simdMultiplyAddAVX2( odd, T[row * N + k], s[row] );
+        }
+        W[k]       = _mm256_add_epi32( V[k], odd );
+        W[M-1-k]   = _mm256_sub_epi32( V[k], odd );
+      }
+      for( Int k = 0; k < M; k++ )
+      {
+        V[k] = W[k];
+      }
+    }
+
+    for( Int k = 0; k < N; k++ )
+    {
+      V[k] = _mm256_min_epi32( vMax, _mm256_max_epi32( vMin, _mm256_sra_epi32( _mm256_add_epi32( V[k], vAdd ), vShift ) ) );
+    }
+    simdStoreColumnsAVX2<N>( dst + j * N, numLines, V );
+  }
+}
+
+/** 4x4 forward DST, equivalent to fastForwardDst
+ */
+SIMD_TARGET_AVX2 static Void simdForwardDstAVX2( const TCoeff* block, TCoeff* coeff, Int shift )
+{
+  const __m256i vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+  __m256i c[4];
+  simdLoadColumnsAVX2<4>( block, 4, c );
+
+  for( Int row = 0; row < 4; row++ )
+  {
+    __m256i acc = vAdd;
+    for( Int column = 0; column < 4; column++ )
+    {
+      acc = simdMultiplyAddAVX2( acc, g_as_DST_MAT_4[TRANSFORM_FORWARD][row][column], c[column] );
+    }
+    simdStoreLinesAVX2( coeff + row * 4, _mm256_sra_epi32( acc, vShift ), 4 );
+  }
+}
+
+/** 4x4 inverse DST, equivalent to fastInverseDst
+ */
+SIMD_TARGET_AVX2 static Void simdInverseDstAVX2( const TCoeff* tmp, TCoeff* block, Int shift, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const __m256i vAdd   = _mm256_set1_epi32( ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0 );
+  const __m128i vShift = _mm_cvtsi32_si128( shift );
+  const __m256i vMin   = _mm256_set1_epi32( outputMinimum );
+  const __m256i vMax   = _mm256_set1_epi32( outputMaximum );
+  __m256i c[4], result[4];
+  for( Int row = 0; row < 4; row++ )
+  {
+    c[row] = simdLoadLinesAVX2( tmp + row * 4, 4 );
+  }
+
+  for( Int column = 0; column < 4; column++ )
+  {
+    __m256i acc = vAdd;
+    for( Int row = 0; row < 4; row++ )
+    {
+      acc = simdMultiplyAddAVX2( acc, g_as_DST_MAT_4[TRANSFORM_INVERSE][row][column], c[row] );
+    }
+    result[column] = _mm256_min_epi32( vMax, _mm256_max_epi32( vMin, _mm256_sra_epi32( acc, vShift ) ) );
+  }
+  simdStoreColumnsAVX2<4>( block, 4, result );
+}
+
+SIMD_TARGET_AVX2 static Void simdTrMxNAVX2( TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, Int shift_1st, Int shift_2nd )
+{
+  TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
+
+  switch (iWidth)
+  {
+    case 4:
+      {
+        if ((iHeight == 4) && useDST)    // Check for DCT or DST
+        {
+          simdForwardDstAVX2( block, tmp, shift_1st );
+        }
+        else
+        {
+          simdPartialButterflyAVX2<4>( block, tmp, shift_1st, iHeight );
+        }
+      }
+      break;
+
+    case 8:     simdPartialButterflyAVX2< 8>( block, tmp, shift_1st, iHeight );  break;
+    case 16:    simdPartialButterflyAVX2<16>( block, tmp, shift_1st, iHeight );  break;
+    case 32:    simdPartialButterflyAVX2<32>( block, tmp, shift_1st, iHeight );  break;
+    default:
+      assert(0); exit (1); break;
+  }
+
+  switch (iHeight)
+  {
+    case 4:
+      {
+        if ((iWidth == 4) && useDST)    // Check for DCT or DST
+        {
+          simdForwardDstAVX2( tmp, coeff, shift_2nd );
+        }
+        else
+        {
+          simdPartialButterflyAVX2<4>( tmp, coeff, shift_2nd, iWidth );
+        }
+      }
+      break;
+
+    case 8:     simdPartialButterflyAVX2< 8>( tmp, coeff, shift_2nd, iWidth );  break;
+    case 16:    simdPartialButterflyAVX2<16>( tmp, coeff, shift_2nd, iWidth );  break;
+    case 32:    simdPartialButterflyAVX2<32>( tmp, coeff, shift_2nd, iWidth );  break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+
+SIMD_TARGET_AVX2 static Void simdITrMxNAVX2( TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, Int shift_1st, Int shift_2nd, const TCoeff clipMinimum, const TCoeff clipMaximum )
+{
+  TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
+
+  switch (iHeight)
+  {
+    case 4:
+      {
+        if ((iWidth == 4) && useDST)    // Check for DCT or DST
+        {
+          simdInverseDstAVX2( coeff, tmp, shift_1st, clipMinimum, clipMaximum );
+        }
+        else
+        {
+          simdPartialButterflyInverseAVX2<4>( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum );
+        }
+      }
+      break;
+
+    case  8: simdPartialButterflyInverseAVX2< 8>( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum ); break;
+    case 16: simdPartialButterflyInverseAVX2<16>( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum ); break;
+    case 32: simdPartialButterflyInverseAVX2<32>( coeff, tmp, shift_1st, iWidth, clipMinimum, clipMaximum ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+
+  const TCoeff pelMinimum = std::numeric_limits<Pel>::min();
+  const TCoeff pelMaximum = std::numeric_limits<Pel>::max();
+
+  switch (iWidth)
+  {
+    case 4:
+      {
+        if ((iHeight == 4) && useDST)    // Check for DCT or DST
+        {
+          simdInverseDstAVX2( tmp, block, shift_2nd, pelMinimum, pelMaximum );
+        }
+        else
+        {
+          simdPartialButterflyInverseAVX2<4>( tmp, block, shift_2nd, iHeight, pelMinimum, pelMaximum );
+        }
+      }
+      break;
+
+    case  8: simdPartialButterflyInverseAVX2< 8>( tmp, block, shift_2nd, iHeight, pelMinimum, pelMaximum ); break;
+    case 16: simdPartialButterflyInverseAVX2<16>( tmp, block, shift_2nd, iHeight, pelMinimum, pelMaximum ); break;
+    case 32: simdPartialButterflyInverseAVX2<32>( tmp, block, shift_2nd, iHeight, pelMinimum, pelMaximum ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+#endif
+
 /** MxN forward transform (2D)
 *  \param bitDepth              [in]  bit depth
 *  \param block                 [in]  residual block
@@ -867,6 +1247,14 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
   assert(shift_1st >= 0);
   assert(shift_2nd >= 0);
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdTrMxNAVX2( block, coeff, iWidth, iHeight, useDST, shift_1st, shift_2nd );
+    return;
+  }
+#endif
+
   TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
 
   switch (iWidth)
@@ -936,6 +1324,14 @@ Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
   assert(shift_1st >= 0);
   assert(shift_2nd >= 0);
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdITrMxNAVX2( coeff, block, iWidth, iHeight, useDST, shift_1st, shift_2nd, clipMinimum, clipMaximum );
+    return;
+  }
+#endif
+
   TCoeff tmp[MAX_TU_SIZE * MAX_TU_SIZE];
 
   switch (iHeight)
@@ -987,6 +1383,171 @@ Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight
 }
 
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+/** AVX2 equivalent of the non-RDOQ quantisation loop in xQuant, four coefficients at a time in 64-bit lanes
+ *  \returns the sum of the quantised magnitudes
+ */
+SIMD_TARGET_AVX2 static TCoeff simdQuantAVX2( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, TCoeff* piArlCCoef, const Int numSamples,
+                                              const Int* piQuantCoeff, const Int defaultQuantisationCoefficient,
+                                              const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC,
+                                              const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum )
+{
+  const __m256i vAdd      = _mm256_set1_epi64x( iAdd );
+  const __m256i vAddC     = _mm256_set1_epi64x( iAddC );
+  const __m128i vQBits    = _mm_cvtsi32_si128( iQBits );
+  const __m128i vQBitsC   = _mm_cvtsi32_si128( iQBitsC );
+  const __m128i vQBits8   = _mm_cvtsi32_si128( iQBits - 8 );
+  const __m128i vMin      = _mm_set1_epi32( entropyCodingMinimum );
+  const __m128i vMax      = _mm_set1_epi32( entropyCodingMaximum );
+  const __m128i vQuant    = _mm_set1_epi32( defaultQuantisationCoefficient );
+  const __m256i vLow32    = _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 );
+  __m128i       vAbsSum   = _mm_setzero_si128();
+
+  for( Int n = 0; n < numSamples; n += 4 )
+  {
+    const __m128i level    = _mm_loadu_si128( ( const __m128i* )( piCoef + n ) );
+    const __m128i quant    = piQuantCoeff ? _mm_loadu_si128( ( const __m128i* )( piQuantCoeff + n ) ) : vQuant;
+    const __m256i tmpLevel = _mm256_mul_epu32( _mm256_cvtepu32_epi64( _mm_abs_epi32( level ) ), _mm256_cvtepu32_epi64( quant ) );
+
+    if( piArlCCoef )
+    {
+      const __m256i arl = _mm256_srl_epi64( _mm256_add_epi64( tmpLevel, vAddC ), vQBitsC );
+      _mm_storeu_si128( ( __m128i* )( piArlCCoef + n ), _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( arl, vLow32 ) ) );
+    }
+
+    const __m256i magnitude64 = _mm256_srl_epi64( _mm256_add_epi64( tmpLevel, vAdd ), vQBits );
+    const __m128i magnitude   = _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( magnitude64, vLow32 ) );
+
+    // (quantisedMagnitude << iQBits) is evaluated as a TCoeff before being widened; only the low 32 bits of the
+    // shifted difference are kept, so a logical shift gives the same result as the arithmetic one
+    const __m256i rounded = _mm256_cvtepi32_epi64( _mm_sll_epi32( magnitude, vQBits ) );
+    const __m256i delta   = _mm256_srl_epi64( _mm256_sub_epi64( tmpLevel, rounded ), vQBits8 );
+    _mm_storeu_si128( ( __m128i* )( deltaU + n ), _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( delta, vLow32 ) ) );
+
+    vAbsSum = _mm_add_epi32( vAbsSum, magnitude );
+    const __m128i coefficient = _mm_sign_epi32( magnitude, level );
+    _mm_storeu_si128( ( __m128i* )( piQCoef + n ), _mm_min_epi32( vMax, _mm_max_epi32( vMin, coefficient ) ) );
+  }
+
+  vAbsSum = _mm_add_epi32( vAbsSum, _mm_shuffle_epi32( vAbsSum, 0x4e ) );
+  vAbsSum = _mm_add_epi32( vAbsSum, _mm_shuffle_epi32( vAbsSum, 0xb1 ) );
+  return _mm_cvtsi128_si32( vAbsSum );
+}
+
+/** AVX2 equivalent of the dequantisation loops in xDeQuant; piDequantCoef is NULL when the flat scale is used
+ */
+SIMD_TARGET_AVX2 static Void simdDeQuantAVX2( const TCoeff* piQCoef, TCoeff* piCoef, const Int numSamples,
+                                              const Int* piDequantCoef, const Int scale, const Int rightShift,
+                                              const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum,
+                                              const TCoeff transformMinimum, const TCoeff transformMaximum )
+{
+  const __m256i vInputMin     = _mm256_set1_epi32( inputMinimum );
+  const __m256i vInputMax     = _mm256_set1_epi32( inputMaximum );
+  const __m256i vTransformMin = _mm256_set1_epi32( transformMinimum );
+  const __m256i vTransformMax = _mm256_set1_epi32( transformMaximum );
+  const __m256i vScale        = _mm256_set1_epi32( scale );
+  const __m256i vAdd          = _mm256_set1_epi32( ( rightShift > 0 ) ? ( 1 << ( rightShift - 1 ) ) : 0 );
+  const __m128i vShift        = _mm_cvtsi32_si128( ( rightShift > 0 ) ? rightShift : -rightShift );
+
+  for( Int n = 0; n < numSamples; n += 8 )
+  {
+    const __m256i clipQCoef = _mm256_min_epi32( vInputMax, _mm256_max_epi32( vInputMin, _mm256_loadu_si256( ( const __m256i* )( piQCoef + n ) ) ) );
+    const __m256i factor    = piDequantCoef ? _mm256_loadu_si256( ( const __m256i* )( piDequantCoef + n ) ) : vScale;
+    const __m256i product   = _mm256_mullo_epi32( clipQCoef, factor );
+    const __m256i iCoeffQ   = ( rightShift > 0 ) ? _mm256_sra_epi32( _mm256_add_epi32( product, vAdd ), vShift ) : _mm256_sll_epi32( product, vShift );
+
+    _mm256_storeu_si256( ( __m256i* )( piCoef + n ), _mm256_min_epi32( vTransformMax, _mm256_max_epi32( vTransformMin, iCoeffQ ) ) );
+  }
+}
+#endif
+
+/** quantisation loop of xQuant without RDOQ
+ *  \param piArlCCoef   adaptive reconstruction levels, not written when NULL
+ *  \param piQuantCoeff scaling list, defaultQuantisationCoefficient is used for all coefficients when NULL
+ *  \returns the sum of the quantised magnitudes
+ */
+TCoeff TComTrQuant::xQuantBlock( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, TCoeff* piArlCCoef, const Int numSamples,
+                                 const Int* piQuantCoeff, const Int defaultQuantisationCoefficient,
+                                 const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC,
+                                 const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum )
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    return simdQuantAVX2( piCoef, piQCoef, deltaU, piArlCCoef, numSamples, piQuantCoeff, defaultQuantisationCoefficient,
+                          iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum );
+  }
+#endif
+
+  const Int qBits8 = iQBits - 8;
+  TCoeff    absSum = 0;
+
+  for( Int uiBlockPos = 0; uiBlockPos < numSamples; uiBlockPos++ )
+  {
+    const TCoeff iLevel   = piCoef[uiBlockPos];
+    const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+
+    const Int64  tmpLevel = (Int64)abs(iLevel) * (piQuantCoeff ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
+
+    if( piArlCCoef )
+    {
+      piArlCCoef[uiBlockPos] = (TCoeff)((tmpLevel + iAddC ) >> iQBitsC);
+    }
+
+    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
+    deltaU[uiBlockPos] = (TCoeff)((tmpLevel - (quantisedMagnitude<<iQBits) )>> qBits8);
+
+    absSum += quantisedMagnitude;
+    const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+    piQCoef[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
+  } // for n
+
+  return absSum;
+}
+
+/** dequantisation loop of xDeQuant
+ *  \param piDequantCoef scaling list, scale is used for all coefficients when NULL
+ */
+Void TComTrQuant::xDeQuantBlock( const TCoeff* piQCoef, TCoeff* piCoef, const Int numSamples,
+                                 const Int* piDequantCoef, const Int scale, const Int rightShift,
+                                 const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum,
+                                 const TCoeff transformMinimum, const TCoeff transformMaximum )
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDLevel() >= SIMD_AVX2 )
+  {
+    simdDeQuantAVX2( piQCoef, piCoef, numSamples, piDequantCoef, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+    return;
+  }
+#endif
+
+  if (rightShift > 0)
+  {
+    const Intermediate_Int iAdd = 1 << (rightShift - 1);
+
+    for( Int n = 0; n < numSamples; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * (piDequantCoef ? piDequantCoef[n] : scale)) + iAdd ) >> rightShift;
+
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
+    }
+  }
+  else
+  {
+    const Int leftShift = -rightShift;
+
+    for( Int n = 0; n < numSamples; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (piDequantCoef ? piDequantCoef[n] : scale)) << leftShift;
+
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
+    }
+  }
+}
+
 // To minimize the distortion only. No rate is considered.
 Void TComTrQuant::signBitHidingHDQ( TCoeff* pQCoef, TCoeff* pCoef, TCoeff* deltaU, const TUEntropyCodingParameters &codingParameters, const Int maxLog2TrDynamicRange )
 {
@@ -1180,7 +1741,7 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
 
     Int scalingListType = getScalingListType(pcCU->getPredictionMode(uiAbsPartIdx), compID);
     assert(scalingListType < SCALING_LIST_NUM);
-    Int *piQuantCoeff = getQuantCoeff(scalingListType, cQP.rem, uiLog2TrSize-2);
+    const Int *piQuantCoeff = getQuantCoeff(scalingListType, cQP.rem, uiLog2TrSize-2);
 
     const Bool enableScalingLists             = getUseScalingList(uiWidth, uiHeight, (pcCU->getTransformSkip(uiAbsPartIdx, compID) != 0));
     const Int  defaultQuantisationCoefficient = g_quantScales[cQP.rem];
@@ -1213,30 +1774,17 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
 #endif
 
     const Int iAdd   = (pcCU->getSlice()->getSliceType()==I_SLICE ? 171 : 85) << (iQBits-9);
-    const Int qBits8 = iQBits - 8;
-
-    for( Int uiBlockPos = 0; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
-    {
-      const TCoeff iLevel   = piCoef[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
-
-      const Int64  tmpLevel = (Int64)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
 
 #if ADAPTIVE_QP_SELECTION
-      if( m_bUseAdaptQpSelect )
-      {
-        piArlCCoef[uiBlockPos] = (TCoeff)((tmpLevel + iAddC ) >> iQBitsC);
-      }
+    TCoeff* piArlDst = m_bUseAdaptQpSelect ? piArlCCoef : NULL;
+#else
+    TCoeff* piArlDst = NULL;
+    const Int iQBitsC = 0;
+    const Int iAddC   = 0;
 #endif
-
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel - (quantisedMagnitude<<iQBits) )>> qBits8);
-
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
-
-      piQCoef[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
+    uiAbsSum += xQuantBlock( piCoef, piQCoef, deltaU, piArlDst, uiWidth*uiHeight,
+                             enableScalingLists ? piQuantCoeff : NULL, defaultQuantisationCoefficient,
+                             iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum );
 
     if( pcCU->getSlice()->getPPS()->getSignDataHidingEnabledFlag() )
     {
@@ -1267,7 +1815,7 @@ Bool TComTrQuant::xNeedRDOQ( TComTU &rTu, TCoeff * pSrc, const ComponentID compI
 
   Int scalingListType = getScalingListType(pcCU->getPredictionMode(uiAbsPartIdx), compID);
   assert(scalingListType < SCALING_LIST_NUM);
-  Int *piQuantCoeff = getQuantCoeff(scalingListType, cQP.rem, uiLog2TrSize-2);
+  const Int *piQuantCoeff = getQuantCoeff(scalingListType, cQP.rem, uiLog2TrSize-2);
 
   const Bool enableScalingLists             = getUseScalingList(uiWidth, uiHeight, (pcCU->getTransformSkip(uiAbsPartIdx, compID) != 0));
   const Int  defaultQuantisationCoefficient = g_quantScales[cQP.rem];
@@ -1357,32 +1905,9 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
-
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const Int leftShift = -rightShift;
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
+    const Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    xDeQuantBlock( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -1396,30 +1921,7 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const Int leftShift = -rightShift;
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    xDeQuantBlock( piQCoef, piCoef, numSamplesInBlock, NULL, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
 }
 
@@ -3044,160 +3546,282 @@ UInt TComTrQuant::getSigCoeffGroupCtxInc  (const UInt*  uiSigCoeffGroupFlag,
 
 /** set quantized matrix coefficient for encode
  * \param scalingList            quantized matrix address
- * \param format                 chroma format
  * \param maxLog2TrDynamicRange
  * \param bitDepths              reference to bit depth array for all channels
  */
 Void TComTrQuant::setScalingList(TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths)
 {
-  const Int minimumQp = 0;
-  const Int maximumQp = SCALING_LIST_REM_NUM;
+  const TComScalingListTables *pPrevTables = m_pcScalingListTables;
+  m_pcScalingListTables = TComScalingListTables::acquire(TComScalingListTables::TABLES_ENC_DEC, scalingList, maxLog2TrDynamicRange, &bitDepths);
+  TComScalingListTables::release(pPrevTables);
+}
+
+/** set quantized matrix coefficient for decode
+ * \param scalingList quantized matrix address
+ */
+Void TComTrQuant::setScalingListDec(const TComScalingList &scalingList)
+{
+  const TComScalingListTables *pPrevTables = m_pcScalingListTables;
+  m_pcScalingListTables = TComScalingListTables::acquire(TComScalingListTables::TABLES_DEC, &scalingList, NULL, NULL);
+  TComScalingListTables::release(pPrevTables);
+}
+
+/** set flat matrix value to quantized coefficient
+ */
+Void TComTrQuant::setFlatScalingList(const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths)
+{
+  const TComScalingListTables *pPrevTables = m_pcScalingListTables;
+  m_pcScalingListTables = TComScalingListTables::acquire(TComScalingListTables::TABLES_FLAT, NULL, maxLog2TrDynamicRange, &bitDepths);
+  TComScalingListTables::release(pPrevTables);
+}
+
+// ====================================================================================================================
+// TComScalingListTables class member functions
+// ====================================================================================================================
+
+std::vector<TComScalingListTables*> TComScalingListTables::s_activeTables;
+std::mutex                          TComScalingListTables::s_activeTablesMutex;
+
+/** find the tables of a scaling list configuration, or build them if no TComTrQuant currently references them.
+ *  The list of active tables is guarded, so that TComTrQuant instances may be configured from several threads.
+ * \param mode                   which tables are required
+ * \param scalingList            quantized matrix address (NULL for flat tables)
+ * \param maxLog2TrDynamicRange  (NULL for decoder-only tables)
+ * \param bitDepths              reference to bit depth array for all channels (NULL for decoder-only tables)
+ */
+const TComScalingListTables* TComScalingListTables::acquire(const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths)
+{
+  std::lock_guard<std::mutex> lock(s_activeTablesMutex);
+
+  for(UInt i = 0; i < s_activeTables.size(); i++)
+  {
+    if(s_activeTables[i]->xMatches(mode, scalingList, maxLog2TrDynamicRange, bitDepths))
+    {
+      s_activeTables[i]->m_refCount++;
+      return s_activeTables[i];
+    }
+  }
+
+  TComScalingListTables *pTables = new TComScalingListTables(mode, scalingList, maxLog2TrDynamicRange, bitDepths);
+  s_activeTables.push_back(pTables);
+  return pTables;
+}
+
+Void TComScalingListTables::release(const TComScalingListTables *pTables)
+{
+  if(pTables == NULL)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(s_activeTablesMutex);
 
-  for(UInt size = 0; size < SCALING_LIST_SIZE_NUM; size++)
+  for(UInt i = 0; i < s_activeTables.size(); i++)
   {
-    for(UInt list = 0; list < SCALING_LIST_NUM; list++)
+    if(s_activeTables[i] == pTables)
     {
-      for(Int qp = minimumQp; qp < maximumQp; qp++)
+      if(--s_activeTables[i]->m_refCount == 0)
       {
-        xSetScalingListEnc(scalingList,list,size,qp);
-        xSetScalingListDec(*scalingList,list,size,qp);
-        setErrScaleCoeff(list,size,qp,maxLog2TrDynamicRange, bitDepths);
+        delete s_activeTables[i];
+        s_activeTables.erase(s_activeTables.begin() + i);
       }
+      return;
     }
   }
+  assert(0);
 }
-/** set quantized matrix coefficient for decode
- * \param scalingList quantized matrix address
- * \param format      chroma format
- */
-Void TComTrQuant::setScalingListDec(const TComScalingList &scalingList)
+
+TComScalingListTables::TComScalingListTables(const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths)
+: m_mode(mode)
+, m_refCount(1)
 {
-  const Int minimumQp = 0;
-  const Int maximumQp = SCALING_LIST_REM_NUM;
+  assert((mode == TABLES_FLAT) || (scalingList != NULL));
+  assert((mode == TABLES_DEC)  || ((maxLog2TrDynamicRange != NULL) && (bitDepths != NULL)));
 
-  for(UInt size = 0; size < SCALING_LIST_SIZE_NUM; size++)
+  if(scalingList != NULL)
+  {
+    m_scalingList = *scalingList;
+  }
+  for(UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+  {
+    m_maxLog2TrDynamicRange[ch] = (maxLog2TrDynamicRange != NULL) ? maxLog2TrDynamicRange[ch] : 0;
+    m_bitDepths.recon[ch]       = (bitDepths != NULL)             ? bitDepths->recon[ch]       : 0;
+  }
+
+  UInt uiNumCoeffs = 0;
+  for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
+  {
+    uiNumCoeffs += g_scalingListSize[sizeId] * SCALING_LIST_NUM * SCALING_LIST_REM_NUM;
+  }
+  m_quantCoefBuf   = new Int    [uiNumCoeffs];
+  m_dequantCoefBuf = new Int    [uiNumCoeffs];
+  m_errScaleBuf    = new Double [uiNumCoeffs];
+  memset(m_quantCoefBuf,   0, sizeof(Int)    * uiNumCoeffs);
+  memset(m_errScaleBuf,    0, sizeof(Double) * uiNumCoeffs);
+  memset(m_errScaleNoScalingList, 0, sizeof(m_errScaleNoScalingList));
+
+  UInt uiOffset = 0;
+  for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
   {
-    for(UInt list = 0; list < SCALING_LIST_NUM; list++)
+    for(UInt listId = 0; listId < SCALING_LIST_NUM; listId++)
     {
-      for(Int qp = minimumQp; qp < maximumQp; qp++)
+      for(UInt qp = 0; qp < SCALING_LIST_REM_NUM; qp++)
       {
-        xSetScalingListDec(scalingList,list,size,qp);
+        m_quantCoef   [sizeId][listId][qp] = m_quantCoefBuf   + uiOffset;
+        m_dequantCoef [sizeId][listId][qp] = m_dequantCoefBuf + uiOffset;
+        m_errScale    [sizeId][listId][qp] = m_errScaleBuf    + uiOffset;
+        uiOffset += g_scalingListSize[sizeId];
+
+        switch(m_mode)
+        {
+          case TABLES_FLAT:
+            xSetFlatScalingList(listId, sizeId, qp);
+            xSetErrScaleCoeff(listId, sizeId, qp);
+            break;
+          case TABLES_ENC_DEC:
+            xSetScalingListEnc(listId, sizeId, qp);
+            xSetScalingListDec(listId, sizeId, qp);
+            xSetErrScaleCoeff(listId, sizeId, qp);
+            break;
+          case TABLES_DEC:
+          default:
+            xSetScalingListDec(listId, sizeId, qp);
+            break;
+        }
       }
     }
   }
 }
+
+TComScalingListTables::~TComScalingListTables()
+{
+  delete [] m_quantCoefBuf;
+  delete [] m_dequantCoefBuf;
+  delete [] m_errScaleBuf;
+}
+
+Bool TComScalingListTables::xMatches(const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths) const
+{
+  if(mode != m_mode)
+  {
+    return false;
+  }
+
+  if(mode != TABLES_DEC)
+  {
+    for(UInt ch = 0; ch < MAX_NUM_CHANNEL_TYPE; ch++)
+    {
+      if((maxLog2TrDynamicRange[ch] != m_maxLog2TrDynamicRange[ch]) || (bitDepths->recon[ch] != m_bitDepths.recon[ch]))
+      {
+        return false;
+      }
+    }
+  }
+
+  if(mode != TABLES_FLAT)
+  {
+    for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
+    {
+      const UInt uiNumCoeffs = min<Int>(MAX_MATRIX_COEF_NUM, (Int)g_scalingListSize[sizeId]);
+      for(UInt listId = 0; listId < SCALING_LIST_NUM; listId++)
+      {
+        if((scalingList->getScalingListDC(sizeId, listId) != m_scalingList.getScalingListDC(sizeId, listId)) ||
+           (memcmp(scalingList->getScalingListAddress(sizeId, listId), m_scalingList.getScalingListAddress(sizeId, listId), sizeof(Int) * uiNumCoeffs) != 0))
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 /** set error scale coefficients
  * \param list                   list ID
  * \param size                   
  * \param qp                     quantization parameter
- * \param maxLog2TrDynamicRange
- * \param bitDepths              reference to bit depth array for all channels
  */
-Void TComTrQuant::setErrScaleCoeff(UInt list, UInt size, Int qp, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths)
+Void TComScalingListTables::xSetErrScaleCoeff(UInt list, UInt size, Int qp)
 {
   const UInt uiLog2TrSize = g_aucConvertToBit[ g_scalingListSizeX[size] ] + 2;
   const ChannelType channelType = ((list == 0) || (list == MAX_NUM_COMPONENT)) ? CHANNEL_TYPE_LUMA : CHANNEL_TYPE_CHROMA;
 
-  const Int channelBitDepth    = bitDepths.recon[channelType];
-  const Int iTransformShift = getTransformShift(channelBitDepth, uiLog2TrSize, maxLog2TrDynamicRange[channelType]);  // Represents scaling through forward transform
+  const Int channelBitDepth    = m_bitDepths.recon[channelType];
+  const Int iTransformShift = getTransformShift(channelBitDepth, uiLog2TrSize, m_maxLog2TrDynamicRange[channelType]);  // Represents scaling through forward transform
 
   UInt i,uiMaxNumCoeff = g_scalingListSize[size];
-  Int *piQuantcoeff;
+  const Int *piQuantcoeff;
   Double *pdErrScale;
-  piQuantcoeff   = getQuantCoeff(list, qp,size);
-  pdErrScale     = getErrScaleCoeff(list, size, qp);
+  piQuantcoeff   = m_quantCoef[size][list][qp];
+  pdErrScale     = m_errScale [size][list][qp];
 
   Double dErrScale = (Double)(1<<SCALE_BITS);                                // Compensate for scaling of bitcount in Lagrange cost function
   dErrScale = dErrScale*pow(2.0,(-2.0*iTransformShift));                     // Compensate for scaling through forward transform
 
   for(i=0;i<uiMaxNumCoeff;i++)
   {
-    pdErrScale[i] =  dErrScale / piQuantcoeff[i] / piQuantcoeff[i] / (1 << DISTORTION_PRECISION_ADJUSTMENT(2 * (bitDepths.recon[channelType] - 8)));
+    pdErrScale[i] =  dErrScale / piQuantcoeff[i] / piQuantcoeff[i] / (1 << DISTORTION_PRECISION_ADJUSTMENT(2 * (m_bitDepths.recon[channelType] - 8)));
   }
 
-  getErrScaleCoeffNoScalingList(list, size, qp) = dErrScale / g_quantScales[qp] / g_quantScales[qp] / (1 << DISTORTION_PRECISION_ADJUSTMENT(2 * (bitDepths.recon[channelType] - 8)));
+  m_errScaleNoScalingList[size][list][qp] = dErrScale / g_quantScales[qp] / g_quantScales[qp] / (1 << DISTORTION_PRECISION_ADJUSTMENT(2 * (m_bitDepths.recon[channelType] - 8)));
 }
 
 /** set quantized matrix coefficient for encode
- * \param scalingList quantized matrix address
  * \param listId List index
  * \param sizeId size index
  * \param qp Quantization parameter
- * \param format chroma format
  */
-Void TComTrQuant::xSetScalingListEnc(TComScalingList *scalingList, UInt listId, UInt sizeId, Int qp)
+Void TComScalingListTables::xSetScalingListEnc(UInt listId, UInt sizeId, Int qp)
 {
   UInt width  = g_scalingListSizeX[sizeId];
   UInt height = g_scalingListSizeX[sizeId];
   UInt ratio  = g_scalingListSizeX[sizeId]/min(MAX_MATRIX_SIZE_NUM,(Int)g_scalingListSizeX[sizeId]);
   Int *quantcoeff;
-  Int *coeff  = scalingList->getScalingListAddress(sizeId,listId);
-  quantcoeff  = getQuantCoeff(listId, qp, sizeId);
+  const Int *coeff  = m_scalingList.getScalingListAddress(sizeId,listId);
+  quantcoeff  = m_quantCoef[sizeId][listId][qp];
 
   Int quantScales = g_quantScales[qp];
 
-  processScalingListEnc(coeff,
-                        quantcoeff,
-                        (quantScales << LOG2_SCALING_LIST_NEUTRAL_VALUE),
-                        height, width, ratio,
-                        min(MAX_MATRIX_SIZE_NUM, (Int)g_scalingListSizeX[sizeId]),
-                        scalingList->getScalingListDC(sizeId,listId));
+  xProcessScalingListEnc(coeff,
+                         quantcoeff,
+                         (quantScales << LOG2_SCALING_LIST_NEUTRAL_VALUE),
+                         height, width, ratio,
+                         min(MAX_MATRIX_SIZE_NUM, (Int)g_scalingListSizeX[sizeId]),
+                         m_scalingList.getScalingListDC(sizeId,listId));
 }
 
 /** set quantized matrix coefficient for decode
- * \param scalingList quantaized matrix address
  * \param listId List index
  * \param sizeId size index
  * \param qp Quantization parameter
- * \param format chroma format
  */
-Void TComTrQuant::xSetScalingListDec(const TComScalingList &scalingList, UInt listId, UInt sizeId, Int qp)
+Void TComScalingListTables::xSetScalingListDec(UInt listId, UInt sizeId, Int qp)
 {
   UInt width  = g_scalingListSizeX[sizeId];
   UInt height = g_scalingListSizeX[sizeId];
   UInt ratio  = g_scalingListSizeX[sizeId]/min(MAX_MATRIX_SIZE_NUM,(Int)g_scalingListSizeX[sizeId]);
   Int *dequantcoeff;
-  const Int *coeff  = scalingList.getScalingListAddress(sizeId,listId);
+  const Int *coeff  = m_scalingList.getScalingListAddress(sizeId,listId);
 
-  dequantcoeff = getDequantCoeff(listId, qp, sizeId);
+  dequantcoeff = m_dequantCoef[sizeId][listId][qp];
 
   Int invQuantScale = g_invQuantScales[qp];
 
-  processScalingListDec(coeff,
-                        dequantcoeff,
-                        invQuantScale,
-                        height, width, ratio,
-                        min(MAX_MATRIX_SIZE_NUM, (Int)g_scalingListSizeX[sizeId]),
-                        scalingList.getScalingListDC(sizeId,listId));
-}
-
-/** set flat matrix value to quantized coefficient
- */
-Void TComTrQuant::setFlatScalingList(const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths)
-{
-  const Int minimumQp = 0;
-  const Int maximumQp = SCALING_LIST_REM_NUM;
-
-  for(UInt size = 0; size < SCALING_LIST_SIZE_NUM; size++)
-  {
-    for(UInt list = 0; list < SCALING_LIST_NUM; list++)
-    {
-      for(Int qp = minimumQp; qp < maximumQp; qp++)
-      {
-        xsetFlatScalingList(list,size,qp);
-        setErrScaleCoeff(list,size,qp,maxLog2TrDynamicRange, bitDepths);
-      }
-    }
-  }
+  xProcessScalingListDec(coeff,
+                         dequantcoeff,
+                         invQuantScale,
+                         height, width, ratio,
+                         min(MAX_MATRIX_SIZE_NUM, (Int)g_scalingListSizeX[sizeId]),
+                         m_scalingList.getScalingListDC(sizeId,listId));
 }
 
 /** set flat matrix value to quantized coefficient
  * \param list List ID
  * \param size size index
  * \param qp Quantization parameter
- * \param format chroma format
  */
-Void TComTrQuant::xsetFlatScalingList(UInt list, UInt size, Int qp)
+Void TComScalingListTables::xSetFlatScalingList(UInt list, UInt size, Int qp)
 {
   UInt i,num = g_scalingListSize[size];
   Int *quantcoeff;
@@ -3206,8 +3830,8 @@ Void TComTrQuant::xsetFlatScalingList(UInt list, UInt size, Int qp)
   Int quantScales    = g_quantScales   [qp];
   Int invQuantScales = g_invQuantScales[qp] << 4;
 
-  quantcoeff   = getQuantCoeff(list, qp, size);
-  dequantcoeff = getDequantCoeff(list, qp, size);
+  quantcoeff   = m_quantCoef  [size][list][qp];
+  dequantcoeff = m_dequantCoef[size][list][qp];
 
   for(i=0;i<num;i++)
   {
@@ -3226,7 +3850,7 @@ Void TComTrQuant::xsetFlatScalingList(UInt list, UInt size, Int qp)
  * \param sizuNum matrix size
  * \param dc dc parameter
  */
-Void TComTrQuant::processScalingListEnc( Int *coeff, Int *quantcoeff, Int quantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc)
+Void TComScalingListTables::xProcessScalingListEnc( const Int *coeff, Int *quantcoeff, Int quantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc)
 {
   for(UInt j=0;j<height;j++)
   {
@@ -3252,7 +3876,7 @@ Void TComTrQuant::processScalingListEnc( Int *coeff, Int *quantcoeff, Int quantS
  * \param sizuNum matrix size
  * \param dc dc parameter
  */
-Void TComTrQuant::processScalingListDec( const Int *coeff, Int *dequantcoeff, Int invQuantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc)
+Void TComScalingListTables::xProcessScalingListDec( const Int *coeff, Int *dequantcoeff, Int invQuantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc)
 {
   for(UInt j=0;j<height;j++)
   {
@@ -3268,51 +3892,6 @@ Void TComTrQuant::processScalingListDec( const Int *coeff, Int *dequantcoeff, In
   }
 }
 
-/** initialization process of scaling list array
- */
-Void TComTrQuant::initScalingList()
-{
-  for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
-  {
-    for(UInt qp = 0; qp < SCALING_LIST_REM_NUM; qp++)
-    {
-      for(UInt listId = 0; listId < SCALING_LIST_NUM; listId++)
-      {
-        m_quantCoef   [sizeId][listId][qp] = new Int    [g_scalingListSize[sizeId]];
-        m_dequantCoef [sizeId][listId][qp] = new Int    [g_scalingListSize[sizeId]];
-        m_errScale    [sizeId][listId][qp] = new Double [g_scalingListSize[sizeId]];
-      } // listID loop
-    }
-  }
-}
-
-/** destroy quantization matrix array
- */
-Void TComTrQuant::destroyScalingList()
-{
-  for(UInt sizeId = 0; sizeId < SCALING_LIST_SIZE_NUM; sizeId++)
-  {
-    for(UInt listId = 0; listId < SCALING_LIST_NUM; listId++)
-    {
-      for(UInt qp = 0; qp < SCALING_LIST_REM_NUM; qp++)
-      {
-        if(m_quantCoef[sizeId][listId][qp])
-        {
-          delete [] m_quantCoef[sizeId][listId][qp];
-        }
-        if(m_dequantCoef[sizeId][listId][qp])
-        {
-          delete [] m_dequantCoef[sizeId][listId][qp];
-        }
-        if(m_errScale[sizeId][listId][qp])
-        {
-          delete [] m_errScale[sizeId][listId][qp];
-        }
-      }
-    }
-  }
-}
-
 Void TComTrQuant::transformSkipQuantOneSample(TComTU &rTu, const ComponentID compID, const TCoeff resiDiff, TCoeff* pcCoeff, const UInt uiPos, const QpParam &cQP, const Bool bUseHalfRoundingPoint)
 {
         TComDataCU    *pcCU                           = rTu.getCU();
@@ -3410,7 +3989,7 @@ Void TComTrQuant::invTrSkipDeQuantOneSample( TComTU &rTu, ComponentID compID, TC
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
+    const Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
     if(rightShift > 0)
     {
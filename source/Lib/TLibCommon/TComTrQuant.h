@@ -38,6 +38,8 @@
 #ifndef __TCOMTRQUANT__
 #define __TCOMTRQUANT__
 
+#include <mutex>
+
 #include "CommonDef.h"
 #include "TComYuv.h"
 #include "TComDataCU.h"
@@ -94,6 +96,58 @@ struct QpParam
 }; // END STRUCT DEFINITION QpParam
 
 
+/// quantisation, dequantisation and error scale tables of one scaling list configuration
+/// (immutable once built, and shared by all TComTrQuant instances that use the same configuration)
+class TComScalingListTables
+{
+public:
+  enum TableMode
+  {
+    TABLES_FLAT    = 0,                    ///< flat scaling, quantisation + dequantisation + error scale
+    TABLES_ENC_DEC = 1,                    ///< scaling list, quantisation + dequantisation + error scale
+    TABLES_DEC     = 2                     ///< scaling list, dequantisation only
+  };
+
+  /// get (and reference) the tables of a configuration, building them if no instance uses them yet
+  static const TComScalingListTables* acquire( const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths );
+  /// drop a reference obtained by acquire(); the tables are freed with the last reference
+  static Void                         release( const TComScalingListTables *pTables );
+
+  const Double* getErrScaleCoeff              ( UInt list, UInt size, Int qp ) const { return m_errScale             [size][list][qp]; }
+  Double        getErrScaleCoeffNoScalingList ( UInt list, UInt size, Int qp ) const { return m_errScaleNoScalingList[size][list][qp]; }
+  const Int*    getQuantCoeff                 ( UInt list, Int qp, UInt size ) const { return m_quantCoef            [size][list][qp]; }
+  const Int*    getDequantCoeff               ( UInt list, Int qp, UInt size ) const { return m_dequantCoef          [size][list][qp]; }
+
+private:
+  TComScalingListTables( const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths );
+  ~TComScalingListTables();
+
+  Bool xMatches              ( const TableMode mode, const TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths *bitDepths ) const;
+  Void xSetFlatScalingList   ( UInt list, UInt size, Int qp );
+  Void xSetScalingListEnc    ( UInt list, UInt size, Int qp );
+  Void xSetScalingListDec    ( UInt list, UInt size, Int qp );
+  Void xSetErrScaleCoeff     ( UInt list, UInt size, Int qp );
+  static Void xProcessScalingListEnc( const Int *coeff, Int *quantcoeff, Int quantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc );
+  static Void xProcessScalingListDec( const Int *coeff, Int *dequantcoeff, Int invQuantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc );
+
+  TableMode        m_mode;
+  TComScalingList  m_scalingList;                                                                          ///< copy of the source list (unused for flat tables)
+  Int              m_maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE];
+  BitDepths        m_bitDepths;
+  UInt             m_refCount;
+
+  Int             *m_quantCoefBuf;                                                                         ///< single allocation holding all quantisation tables
+  Int             *m_dequantCoefBuf;                                                                       ///< single allocation holding all dequantisation tables
+  Double          *m_errScaleBuf;                                                                          ///< single allocation holding all error scale tables
+  Int             *m_quantCoef            [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
+  Int             *m_dequantCoef          [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of dequantization matrix coefficient 4x4
+  Double          *m_errScale             [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
+  Double           m_errScaleNoScalingList[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
+
+  static std::vector<TComScalingListTables*> s_activeTables;                                               ///< tables currently referenced by at least one TComTrQuant
+  static std::mutex                          s_activeTablesMutex;                                          ///< guards s_activeTables and the reference counts
+};
+
 /// transform and quantization class
 class TComTrQuant
 {
@@ -170,23 +224,15 @@ public:
                                        const UInt   widthInGroups,
                                        const UInt   heightInGroups);
 
-  Void initScalingList                      ();
-  Void destroyScalingList                   ();
-  Void setErrScaleCoeff    ( UInt list, UInt size, Int qp, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths );
-  Double* getErrScaleCoeff              ( UInt list, UInt size, Int qp ) { return m_errScale             [size][list][qp]; };  //!< get Error Scale Coefficent
-  Double& getErrScaleCoeffNoScalingList ( UInt list, UInt size, Int qp ) { return m_errScaleNoScalingList[size][list][qp]; };  //!< get Error Scale Coefficent
-  Int* getQuantCoeff                    ( UInt list, Int qp, UInt size ) { return m_quantCoef            [size][list][qp]; };  //!< get Quant Coefficent
-  Int* getDequantCoeff                  ( UInt list, Int qp, UInt size ) { return m_dequantCoef          [size][list][qp]; };  //!< get DeQuant Coefficent
+  const Double* getErrScaleCoeff              ( UInt list, UInt size, Int qp ) const { return m_pcScalingListTables->getErrScaleCoeff(list, size, qp);              };  //!< get Error Scale Coefficent
+  Double        getErrScaleCoeffNoScalingList ( UInt list, UInt size, Int qp ) const { return m_pcScalingListTables->getErrScaleCoeffNoScalingList(list, size, qp); };  //!< get Error Scale Coefficent
+  const Int*    getQuantCoeff                 ( UInt list, Int qp, UInt size ) const { return m_pcScalingListTables->getQuantCoeff(list, qp, size);                 };  //!< get Quant Coefficent
+  const Int*    getDequantCoeff               ( UInt list, Int qp, UInt size ) const { return m_pcScalingListTables->getDequantCoeff(list, qp, size);               };  //!< get DeQuant Coefficent
   Void setUseScalingList   ( Bool bUseScalingList){ m_scalingListEnabledFlag = bUseScalingList; };
   Bool getUseScalingList   (const UInt width, const UInt height, const Bool isTransformSkip){ return m_scalingListEnabledFlag && (!isTransformSkip || ((width == 4) && (height == 4))); };
   Void setFlatScalingList  (const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths);
-  Void xsetFlatScalingList ( UInt list, UInt size, Int qp);
-  Void xSetScalingListEnc  ( TComScalingList *scalingList, UInt list, UInt size, Int qp);
-  Void xSetScalingListDec  ( const TComScalingList &scalingList, UInt list, UInt size, Int qp);
   Void setScalingList      ( TComScalingList *scalingList, const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths);
   Void setScalingListDec   ( const TComScalingList &scalingList);
-  Void processScalingListEnc( Int *coeff, Int *quantcoeff, Int quantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc);
-  Void processScalingListDec( const Int *coeff, Int *dequantcoeff, Int invQuantScales, UInt height, UInt width, UInt ratio, Int sizuNum, UInt dc);
 #if ADAPTIVE_QP_SELECTION
   Void    initSliceQpDelta() ;
   Void    storeSliceQpNext(TComSlice* pcSlice);
@@ -224,15 +270,25 @@ protected:
 
   Bool     m_scalingListEnabledFlag;
 
-  Int      *m_quantCoef            [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
-  Int      *m_dequantCoef          [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of dequantization matrix coefficient 4x4
-  Double   *m_errScale             [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
-  Double    m_errScaleNoScalingList[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
+  const TComScalingListTables *m_pcScalingListTables;   ///< shared tables of the current scaling list configuration
 
-private:
   // forward Transform
   Void xT   ( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
 
+  // inverse transform
+  Void xIT    ( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
+
+  // quantisation and dequantisation of a block of coefficients, shared by xQuant and xDeQuant
+  static TCoeff xQuantBlock  ( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* deltaU, TCoeff* piArlCCoef, const Int numSamples,
+                               const Int* piQuantCoeff, const Int defaultQuantisationCoefficient,
+                               const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC,
+                               const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum );
+  static Void   xDeQuantBlock( const TCoeff* piQCoef, TCoeff* piCoef, const Int numSamples,
+                               const Int* piDequantCoef, const Int scale, const Int rightShift,
+                               const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum,
+                               const TCoeff transformMinimum, const TCoeff transformMaximum );
+
+private:
   // skipping Transform
   Void xTransformSkip ( Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, TComTU &rTu, const ComponentID component );
 
@@ -309,9 +365,6 @@ __inline UInt              xGetCodedLevel  ( Double&          rd64CodedCost,
                  const ComponentID   compID,
                  const QpParam      &cQP );
 
-  // inverse transform
-  Void xIT    ( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
-
   // inverse skipping transform
   Void xITransformSkip ( TCoeff* plCoef, Pel* pResidual, UInt uiStride, TComTU &rTu, const ComponentID component );
 
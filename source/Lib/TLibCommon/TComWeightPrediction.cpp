@@ -42,6 +42,11 @@
 #include "TComInterpolationFilter.h"
 #include "TComWeightPrediction.h"
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
+
 
 static inline Pel weightBidir( Int w0, Pel P0, Int w1, Pel P1, Int round, Int shift, Int offset, Int clipBD)
 {
@@ -65,6 +70,78 @@ static inline Pel noWeightOffsetUnidir( Pel P0, Int round, Int shift, Int clipBD
 }
 
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+/** AVX2 version of weightBidir over a block, for widths that are a multiple of 4.
+ *  The constant part ( w0 + w1 ) * IF_INTERNAL_OFFS + round + ( offset << ( shift - 1 ) ) is folded into one addition.
+ */
+SIMD_TARGET_AVX2 static Void simdWeightBidirAVX2( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                                                  Int w0, Int w1, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m256i mmWeight = _mm256_unpacklo_epi16( _mm256_set1_epi16( w0 ), _mm256_set1_epi16( w1 ) );
+  const __m256i mmAdd    = _mm256_set1_epi32( ( w0 + w1 ) * IF_INTERNAL_OFFS + round + ( offset << ( shift - 1 ) ) );
+  const __m128i mmShift  = _mm_cvtsi32_si128( shift );
+  const __m256i mmMin    = _mm256_setzero_si256();
+  const __m256i mmMax    = _mm256_set1_epi16( ( 1 << clipBD ) - 1 );
+
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 16 <= iWidth; x += 16 )
+    {
+      const __m256i mmSrc0 = _mm256_loadu_si256( ( const __m256i* )( pSrc0 + x ) );
+      const __m256i mmSrc1 = _mm256_loadu_si256( ( const __m256i* )( pSrc1 + x ) );
+      const __m256i sumLo  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( mmSrc0, mmSrc1 ), mmWeight ), mmAdd ), mmShift );
+      const __m256i sumHi  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( mmSrc0, mmSrc1 ), mmWeight ), mmAdd ), mmShift );
+      _mm256_storeu_si256( ( __m256i* )( pDst + x ), _mm256_min_epi16( mmMax, _mm256_max_epi16( mmMin, _mm256_packs_epi32( sumLo, sumHi ) ) ) );
+    }
+    for ( ; x < iWidth; x += 4 )
+    {
+      const __m128i mmSrc0 = _mm_loadl_epi64( ( const __m128i* )( pSrc0 + x ) );
+      const __m128i mmSrc1 = _mm_loadl_epi64( ( const __m128i* )( pSrc1 + x ) );
+      const __m128i sum    = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( mmSrc0, mmSrc1 ), _mm256_castsi256_si128( mmWeight ) ), _mm256_castsi256_si128( mmAdd ) ), mmShift );
+      _mm_storel_epi64( ( __m128i* )( pDst + x ), _mm_min_epi16( _mm256_castsi256_si128( mmMax ), _mm_max_epi16( _mm256_castsi256_si128( mmMin ), _mm_packs_epi32( sum, sum ) ) ) );
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+
+/** AVX2 version of weightUnidir over a block, for widths that are a multiple of 4.
+ *  noWeightUnidir and noWeightOffsetUnidir are the cases w0 = 1 and w0 = 1, offset = 0.
+ */
+SIMD_TARGET_AVX2 static Void simdWeightUnidirAVX2( const Pel* pSrc0, Int iSrc0Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                                                   Int w0, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m256i mmWeight = _mm256_set1_epi32( w0 );
+  const __m256i mmAdd    = _mm256_set1_epi32( w0 * IF_INTERNAL_OFFS + round );
+  const __m256i mmOffset = _mm256_set1_epi32( offset );
+  const __m128i mmShift  = _mm_cvtsi32_si128( shift );
+  const __m256i mmMin    = _mm256_setzero_si256();
+  const __m256i mmMax    = _mm256_set1_epi16( ( 1 << clipBD ) - 1 );
+
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 8 <= iWidth; x += 8 )
+    {
+      const __m256i mmSrc0 = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( pSrc0 + x ) ) );
+      const __m256i sum    = _mm256_add_epi32( _mm256_sra_epi32( _mm256_add_epi32( _mm256_mullo_epi32( mmSrc0, mmWeight ), mmAdd ), mmShift ), mmOffset );
+      const __m128i packed = _mm_packs_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) );
+      _mm_storeu_si128( ( __m128i* )( pDst + x ), _mm_min_epi16( _mm256_castsi256_si128( mmMax ), _mm_max_epi16( _mm256_castsi256_si128( mmMin ), packed ) ) );
+    }
+    if ( x < iWidth )
+    {
+      const __m128i mmSrc0 = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( pSrc0 + x ) ) );
+      const __m128i sum    = _mm_add_epi32( _mm_sra_epi32( _mm_add_epi32( _mm_mullo_epi32( mmSrc0, _mm256_castsi256_si128( mmWeight ) ), _mm256_castsi256_si128( mmAdd ) ), mmShift ), _mm256_castsi256_si128( mmOffset ) );
+      _mm_storel_epi64( ( __m128i* )( pDst + x ), _mm_min_epi16( _mm256_castsi256_si128( mmMax ), _mm_max_epi16( _mm256_castsi256_si128( mmMin ), _mm_packs_epi32( sum, sum ) ) ) );
+    }
+    pSrc0 += iSrc0Stride;
+    pDst  += iDstStride;
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -116,6 +193,14 @@ Void TComWeightPrediction::addWeightBi( const TComYuv              *pcYuvSrc0,
     const UInt iSrc1Stride = pcYuvSrc1->getStride(compID);
     const UInt iDstStride  = rpcYuvDst->getStride(compID);
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if ( !(iWidth&3) && getSIMDLevel() >= SIMD_AVX2 )
+    {
+      simdWeightBidirAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, round, shift, offset, clipBD );
+      continue;
+    }
+#endif
+
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
       // do it in batches of 4 (partial unroll)
@@ -171,6 +256,21 @@ Void TComWeightPrediction::addWeightUni( const TComYuv        *const pcYuvSrc0,
     const Int  iHeight     = uiHeight>>csy;
     const Int  iWidth      = uiWidth>>csx;
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if ( !(iWidth&3) && getSIMDLevel() >= SIMD_AVX2 )
+    {
+      if (w0 != 1 << wp0[compID].shift)
+      {
+        simdWeightUnidirAVX2( pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, w0, (shift > 0) ? (1<<(shift-1)) : 0, shift, offset, clipBD );
+      }
+      else
+      {
+        simdWeightUnidirAVX2( pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, 1, (shiftNum > 0) ? (1<<(shiftNum-1)) : 0, shiftNum, offset, clipBD );
+      }
+      continue;
+    }
+#endif
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const Int  round       = (shift > 0) ? (1<<(shift-1)) : 0;
@@ -45,6 +45,11 @@
 #include "TComYuv.h"
 #include "TComInterpolationFilter.h"
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCPUFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -351,6 +356,42 @@ Void TComYuv::subtract( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, cons
 
 
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+/// AVX2 version of the bi-prediction average in TComYuv::addAvg, for widths that are a multiple of 4
+SIMD_TARGET_AVX2 static Void simdAddAvgAVX2( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride,
+                                             Int iWidth, Int iHeight, Int offset, Int shiftNum, Int clipbd )
+{
+  const __m256i mmOne    = _mm256_set1_epi16( 1 );
+  const __m256i mmOffset = _mm256_set1_epi32( offset );
+  const __m128i mmShift  = _mm_cvtsi32_si128( shiftNum );
+  const __m256i mmMin    = _mm256_setzero_si256();
+  const __m256i mmMax    = _mm256_set1_epi16( ( 1 << clipbd ) - 1 );
+
+  for ( Int y = 0; y < iHeight; y++ )
+  {
+    Int x = 0;
+    for ( ; x + 16 <= iWidth; x += 16 )
+    {
+      const __m256i mmSrc0 = _mm256_loadu_si256( ( const __m256i* )( pSrc0 + x ) );
+      const __m256i mmSrc1 = _mm256_loadu_si256( ( const __m256i* )( pSrc1 + x ) );
+      const __m256i sumLo  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( mmSrc0, mmSrc1 ), mmOne ), mmOffset ), mmShift );
+      const __m256i sumHi  = _mm256_sra_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( mmSrc0, mmSrc1 ), mmOne ), mmOffset ), mmShift );
+      _mm256_storeu_si256( ( __m256i* )( pDst + x ), _mm256_min_epi16( mmMax, _mm256_max_epi16( mmMin, _mm256_packs_epi32( sumLo, sumHi ) ) ) );
+    }
+    for ( ; x < iWidth; x += 4 )
+    {
+      const __m128i mmSrc0 = _mm_loadl_epi64( ( const __m128i* )( pSrc0 + x ) );
+      const __m128i mmSrc1 = _mm_loadl_epi64( ( const __m128i* )( pSrc1 + x ) );
+      const __m128i sum    = _mm_sra_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( mmSrc0, mmSrc1 ), _mm256_castsi256_si128( mmOne ) ), _mm256_castsi256_si128( mmOffset ) ), mmShift );
+      _mm_storel_epi64( ( __m128i* )( pDst + x ), _mm_min_epi16( _mm256_castsi256_si128( mmMax ), _mm_max_epi16( _mm256_castsi256_si128( mmMin ), _mm_packs_epi32( sum, sum ) ) ) );
+    }
+    pSrc0 += iSrc0Stride;
+    pSrc1 += iSrc1Stride;
+    pDst  += iDstStride;
+  }
+}
+#endif
+
 Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const UInt iPartUnitIdx, const UInt uiWidth, const UInt uiHeight, const BitDepths &clipBitDepths )
 {
   for(Int comp=0; comp<getNumberValidComponents(); comp++)
@@ -375,6 +416,12 @@ Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
       assert(0);
       exit(-1);
     }
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    else if (!(iWidth&2) && getSIMDLevel() >= SIMD_AVX2)
+    {
+      simdAddAvgAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, offset, shiftNum, clipbd );
+    }
+#endif
     else if (iWidth&2)
     {
       for ( Int y = 0; y < iHeight; y++ )
@@ -140,6 +140,12 @@
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            0 ///< enable vector coding for distortion calculations   0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #endif
 
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (defined __GNUC__ || defined _MSC_VER)
+#define VECTOR_CODING__AVX2_DISPATCH                      1 ///< 1 (default if SSE possible) compile AVX2 kernels next to the SSE2 ones and select them at run time when the CPU supports AVX2. Should not affect RD costs/decisions.
+#else
+#define VECTOR_CODING__AVX2_DISPATCH                      0 ///< 0 (default if SSE not possible) do not compile AVX2 kernels.
+#endif
+
 // ====================================================================================================================
 // Derived macros
 // ====================================================================================================================
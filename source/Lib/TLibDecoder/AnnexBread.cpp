@@ -40,7 +40,9 @@
 #include <stdint.h>
 #include <cassert>
 #include <vector>
+#include <string.h>
 #include "AnnexBread.h"
+#include "TLibCommon/TComByteScan.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -50,6 +52,54 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+Bool InputByteStream::xRefill(std::size_t n)
+{
+  // move the unconsumed bytes to the front and read ahead as much as fits
+  const std::size_t numLeft = m_BufferEnd - m_BufferPos;
+  memmove(&m_Buffer[0], &m_Buffer[0] + m_BufferPos, numLeft);
+  m_BufferPos = 0;
+  m_BufferEnd = numLeft;
+  while (m_BufferEnd < n)
+  {
+    const std::streamsize numRead = m_Input.rdbuf()->sgetn(reinterpret_cast<TChar*>(&m_Buffer[0]) + m_BufferEnd, std::streamsize(m_Buffer.size() - m_BufferEnd));
+    if (numRead <= 0)
+    {
+      return false;
+    }
+    m_BufferEnd += std::size_t(numRead);
+  }
+  return true;
+}
+
+std::size_t InputByteStream::readBytesUntilStartCode(vector<uint8_t>& out)
+{
+  std::size_t numBytes = 0;
+  while (xFill(3))
+  {
+    // a start code straddling the end of the buffer is found after the next refill, which keeps the last two bytes
+    const std::size_t pos    = findStartCodePrefix(&m_Buffer[0], m_BufferPos, m_BufferEnd);
+    const std::size_t endPos = (pos < m_BufferEnd) ? pos : m_BufferEnd - 2;
+    out.insert(out.end(), m_Buffer.begin() + m_BufferPos, m_Buffer.begin() + endPos);
+    numBytes        += endPos - m_BufferPos;
+    m_NumPeekedBytes = (m_NumPeekedBytes > endPos - m_BufferPos) ? m_NumPeekedBytes - (endPos - m_BufferPos) : 0;
+    m_BufferPos      = endPos;
+    if (pos < m_BufferEnd)
+    {
+      break;
+    }
+  }
+  return numBytes;
+}
+
+Void InputByteStream::releaseReadAhead()
+{
+  const std::size_t numUnpeeked = m_BufferEnd - m_BufferPos - m_NumPeekedBytes;
+  if (numUnpeeked > 0 && m_Input.rdbuf()->pubseekoff(-std::streamoff(numUnpeeked), std::ios_base::cur, std::ios_base::in) != std::streampos(std::streamoff(-1)))
+  {
+    m_BufferEnd -= numUnpeeked;
+  }
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
@@ -133,6 +183,10 @@ _byteStreamNALUnit(
   /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  const UInt numBytesBeforeStartCode = UInt(bs.readBytesUntilStartCode(nalUnit));
+  bodyStats.bits += 8*numBytesBeforeStartCode; bodyStats.count += numBytesBeforeStartCode;
+#else
+  bs.readBytesUntilStartCode(nalUnit);
 #endif
   while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
   {
@@ -193,6 +247,7 @@ byteStreamNALUnit(
   {
     eof = true;
   }
+  bs.releaseReadAhead();
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
@@ -44,6 +44,7 @@
 #include <stdint.h>
 #include <istream>
 #include <vector>
+#include <algorithm>
 
 #include "TLibCommon/CommonDef.h"
 
@@ -58,13 +59,18 @@ public:
    * istream.
    *
    * NB, it isn't safe to access istream while in use by a
-   * InputByteStream.
+   * InputByteStream.  Bytes are read ahead in blocks through the
+   * stream buffer; the state of istream is only changed when an
+   * attempt is made to read past its end, and releaseReadAhead()
+   * restores the position a byte-by-byte reader would have.
    *
    * Side-effects: the exception mask of istream is set to eofbit
    */
   InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
+  : m_Buffer(BUFFER_SIZE)
+  , m_BufferPos(0)
+  , m_BufferEnd(0)
+  , m_NumPeekedBytes(0)
   , m_Input(istream)
   {
     istream.exceptions(std::istream::eofbit | std::istream::badbit);
@@ -76,8 +82,9 @@ public:
    */
   Void reset()
   {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
+    m_BufferPos      = 0;
+    m_BufferEnd      = 0;
+    m_NumPeekedBytes = 0;
   }
 
   /**
@@ -87,25 +94,20 @@ public:
   Bool eofBeforeNBytes(UInt n)
   {
     assert(n <= 4);
-    if (m_NumFutureBytes >= n)
+    if (xFill(n))
     {
+      m_NumPeekedBytes = std::max<std::size_t>(m_NumPeekedBytes, n);
       return false;
     }
-
-    n -= m_NumFutureBytes;
+    m_NumPeekedBytes = m_BufferEnd - m_BufferPos;
     try
     {
-      for (UInt i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
+      xSetEof();
     }
     catch (...)
     {
-      return true;
     }
-    return false;
+    return true;
   }
 
   /**
@@ -123,7 +125,12 @@ public:
   uint32_t peekBytes(UInt n)
   {
     eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
+    uint32_t val = 0;
+    for (UInt i = 0; i < n; i++)
+    {
+      val = (val << 8) | (m_BufferPos + i < m_BufferEnd ? m_Buffer[m_BufferPos + i] : 0);
+    }
+    return val;
   }
 
   /**
@@ -134,15 +141,15 @@ public:
    */
   uint8_t readByte()
   {
-    if (!m_NumFutureBytes)
+    if (!xFill(1))
     {
-      uint8_t byte = m_Input.get();
-      return byte;
+      xSetEof();
     }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
+    if (m_NumPeekedBytes)
+    {
+      m_NumPeekedBytes--;
+    }
+    return m_Buffer[m_BufferPos++];
   }
 
   /**
@@ -160,14 +167,58 @@ public:
     return val;
   }
 
+  /**
+   * consume the bytes up to the next byte-aligned three-byte sequence
+   * 0x000000, 0x000001 or 0x000002 and append them to out.  Stops
+   * with fewer than three bytes left before EOF, which are not
+   * consumed.
+   *
+   * Returns: the number of bytes appended.
+   */
+  std::size_t readBytesUntilStartCode(std::vector<uint8_t>& out);
+
+  /**
+   * return the bytes that were read ahead but not yet peeked to the
+   * input stream, so that its position is the one of a reader that
+   * fetches one byte at a time (as used by callers that tellg() and
+   * seekg() around NAL units).  Has no effect if the input can not
+   * seek.
+   */
+  Void releaseReadAhead();
+
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt GetNumBufferedBytes() const { return m_NumFutureBytes; }
+  UInt GetNumBufferedBytes() const { return UInt(m_NumPeekedBytes); }
 #endif
 
 private:
-  UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
-  std::istream& m_Input; /* Input stream to read from */
+  static const std::size_t BUFFER_SIZE = 1 << 12;
+
+  /**
+   * makes at least n bytes available in the buffer, reading ahead
+   * from the stream buffer.  Returns false if EOF comes first.
+   */
+  Bool xFill(std::size_t n)
+  {
+    if (m_BufferEnd - m_BufferPos >= n)
+    {
+      return true;
+    }
+    return xRefill(n);
+  }
+
+  Bool xRefill(std::size_t n);
+
+  /// marks the input as having been read past its end, which throws std::ios_base::failure
+  Void xSetEof()
+  {
+    m_Input.setstate(std::istream::eofbit | std::istream::failbit);
+  }
+
+  std::vector<uint8_t> m_Buffer;         /* bytes that have been read ahead */
+  std::size_t          m_BufferPos;      /* position of the next byte to consume in m_Buffer */
+  std::size_t          m_BufferEnd;      /* number of valid bytes in m_Buffer */
+  std::size_t          m_NumPeekedBytes; /* number of bytes from m_BufferPos that have been peeked */
+  std::istream&        m_Input;          /* Input stream to read from */
 };
 
 /**
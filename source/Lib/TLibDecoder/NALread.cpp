@@ -40,10 +40,12 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
 #include "TLibCommon/TComBitStream.h"
+#include "TLibCommon/TComByteScan.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -57,33 +59,48 @@ using namespace std;
 //! \{
 static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  const std::size_t size     = nalUnitBuf.size();
+  uint8_t          *buf      = size ? &nalUnitBuf[0] : NULL;
+  std::size_t       readPos  = 0;
+  std::size_t       writePos = 0;
+  Bool              endsWithEmulationPrevention = false;
 
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  while (readPos < size)
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    // an emulation_prevention_three_byte can only follow a pair of zero bytes, so copy everything up to the next pair
+    const std::size_t pairPos = findZeroBytePair(buf, readPos, size);
+    const std::size_t copyEnd = std::min(pairPos + 2, size);
+    memmove(buf + writePos, buf + readPos, copyEnd - readPos);
+    writePos += copyEnd - readPos;
+    readPos   = copyEnd;
+    if (readPos >= size)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      break;
+    }
+
+    if (buf[readPos] == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation( UInt(readPos) );
+      readPos++;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
+      if (readPos == size)
       {
+        endsWithEmulationPrevention = true;
         break;
       }
-      assert(*it_read <= 0x03);
+      assert(buf[readPos] <= 0x03);
+    }
+    else
+    {
+      assert(buf[readPos] > 0x03);
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
   }
-  assert(zeroCount == 0);
+  assert(writePos == 0 || buf[writePos-1] != 0x00 || endsWithEmulationPrevention);
+
+  vector<uint8_t>::iterator it_write = nalUnitBuf.begin() + writePos;
 
   if (isVclNalUnit)
   {
@@ -0,0 +1,397 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncAnalysisData.cpp
+    \brief    store of CU decisions and motion shared between encodes of the same source
+*/
+
+#include <algorithm>
+
+#include "TEncAnalysisData.h"
+#include "TLibCommon/TComDataCU.h"
+#include "TLibCommon/TComPic.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const TChar  ANALYSIS_FILE_MAGIC[4]  = { 'H', 'M', 'A', 'D' };
+static const UChar ANALYSIS_FILE_VERSION   = 1;
+
+/// write an unsigned value of numBytes bytes, least significant byte first
+static Void writeValue( std::ostream& os, UInt value, UInt numBytes )
+{
+  for ( UInt i = 0; i < numBytes; i++ )
+  {
+    os.put( TChar( ( value >> ( 8 * i ) ) & 0xff ) );
+  }
+}
+
+/// read an unsigned value of numBytes bytes, least significant byte first
+static UInt readValue( std::istream& is, UInt numBytes )
+{
+  UInt value = 0;
+  for ( UInt i = 0; i < numBytes; i++ )
+  {
+    value |= UInt( UChar( is.get() ) ) << ( 8 * i );
+  }
+  return value;
+}
+
+TEncAnalysisData::TEncAnalysisData()
+: m_bFileWriteMode  ( false )
+, m_uiNumCtus       ( 0 )
+, m_uiNumPartitions ( 0 )
+{
+}
+
+TEncAnalysisData::~TEncAnalysisData()
+{
+  closeFile();
+}
+
+/** Open an analysis file
+ * \param fileName          name of the analysis file
+ * \param bWriteMode        true to write the decisions of this encode, false to read those of an earlier encode
+ * \param uiPicWidth        picture width in luma samples
+ * \param uiPicHeight       picture height in luma samples
+ * \param uiMaxCUWidth      CTU width
+ * \param uiMaxCUHeight     CTU height
+ * \param uiMaxTotalCUDepth depth of the minimum partition in a CTU
+ * \returns false if the file cannot be opened, or when reading, if it was written for another geometry
+ */
+Bool TEncAnalysisData::openFile( const std::string& fileName, Bool bWriteMode, UInt uiPicWidth, UInt uiPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxTotalCUDepth )
+{
+  m_bFileWriteMode  = bWriteMode;
+  m_uiNumCtus       = ( ( uiPicWidth + uiMaxCUWidth - 1 ) / uiMaxCUWidth ) * ( ( uiPicHeight + uiMaxCUHeight - 1 ) / uiMaxCUHeight );
+  m_uiNumPartitions = 1 << ( uiMaxTotalCUDepth << 1 );
+
+  m_file.open( fileName.c_str(), std::ios::binary | ( bWriteMode ? std::ios::out : std::ios::in ) );
+  if ( !m_file.is_open() )
+  {
+    return false;
+  }
+
+  if ( bWriteMode )
+  {
+    m_file.write( ANALYSIS_FILE_MAGIC, sizeof( ANALYSIS_FILE_MAGIC ) );
+    writeValue( m_file, ANALYSIS_FILE_VERSION, 1 );
+    writeValue( m_file, uiPicWidth,        4 );
+    writeValue( m_file, uiPicHeight,       4 );
+    writeValue( m_file, uiMaxCUWidth,      2 );
+    writeValue( m_file, uiMaxCUHeight,     2 );
+    writeValue( m_file, uiMaxTotalCUDepth, 1 );
+    return m_file.good();
+  }
+
+  TChar magic[sizeof( ANALYSIS_FILE_MAGIC )];
+  m_file.read( magic, sizeof( magic ) );
+  const Bool bValid = m_file.good() && std::equal( magic, magic + sizeof( magic ), ANALYSIS_FILE_MAGIC )
+                   && readValue( m_file, 1 ) == ANALYSIS_FILE_VERSION
+                   && readValue( m_file, 4 ) == uiPicWidth
+                   && readValue( m_file, 4 ) == uiPicHeight
+                   && readValue( m_file, 2 ) == uiMaxCUWidth
+                   && readValue( m_file, 2 ) == uiMaxCUHeight
+                   && readValue( m_file, 1 ) == uiMaxTotalCUDepth
+                   && m_file.good();
+  if ( !bValid )
+  {
+    m_file.close();
+  }
+  return bValid;
+}
+
+Void TEncAnalysisData::closeFile()
+{
+  if ( m_file.is_open() )
+  {
+    m_file.close();
+  }
+}
+
+/** Append the stored decisions of a picture to the analysis file, if one is open for writing.
+ * Each CTU is written as runs of minimum partitions with identical decisions.
+ */
+Void TEncAnalysisData::writePicture( Int poc )
+{
+  if ( !m_file.is_open() || !m_bFileWriteMode )
+  {
+    return;
+  }
+
+  static const std::vector<TEncAnalysisCtu> noCtus;
+  std::map<Int, std::vector<TEncAnalysisCtu> >::const_iterator it = m_pictures.find( poc );
+  const std::vector<TEncAnalysisCtu>& ctus = it == m_pictures.end() ? noCtus : it->second;
+
+  writeValue( m_file, UInt( poc ), 4 );
+  writeValue( m_file, m_uiNumCtus, 4 );
+  for ( UInt ctuRsAddr = 0; ctuRsAddr < m_uiNumCtus; ctuRsAddr++ )
+  {
+    if ( ctuRsAddr >= ctus.size() || ctus[ctuRsAddr].depth.size() != m_uiNumPartitions )
+    {
+      writeValue( m_file, 0, 2 );
+      continue;
+    }
+
+    const TEncAnalysisCtu& ctu = ctus[ctuRsAddr];
+    std::vector<UInt> runStarts;
+    for ( UInt ui = 0; ui < m_uiNumPartitions; ui++ )
+    {
+      Bool bSame = ui > 0 && ctu.depth[ui] == ctu.depth[ui-1] && ctu.partSize[ui] == ctu.partSize[ui-1] && ctu.predMode[ui] == ctu.predMode[ui-1];
+      for ( UInt list = 0; list < NUM_REF_PIC_LIST_01 && bSame; list++ )
+      {
+        bSame = ctu.refIdx[list][ui] == ctu.refIdx[list][ui-1] && ctu.mv[list][ui] == ctu.mv[list][ui-1];
+      }
+      if ( !bSame )
+      {
+        runStarts.push_back( ui );
+      }
+    }
+
+    writeValue( m_file, UInt( runStarts.size() ), 2 );
+    for ( UInt run = 0; run < runStarts.size(); run++ )
+    {
+      const UInt ui     = runStarts[run];
+      const UInt runEnd = run + 1 < runStarts.size() ? runStarts[run+1] : m_uiNumPartitions;
+      writeValue( m_file, runEnd - ui,                 2 );
+      writeValue( m_file, ctu.depth[ui],               1 );
+      writeValue( m_file, UChar( ctu.partSize[ui] ),   1 );
+      writeValue( m_file, UChar( ctu.predMode[ui] ),   1 );
+      for ( UInt list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+      {
+        writeValue( m_file, UChar( ctu.refIdx[list][ui] ),            1 );
+        writeValue( m_file, UShort( ctu.mv[list][ui].getHor() ),      2 );
+        writeValue( m_file, UShort( ctu.mv[list][ui].getVer() ),      2 );
+      }
+    }
+  }
+}
+
+/** Read the next picture of the analysis file
+ * \returns false if the file is corrupt
+ */
+Bool TEncAnalysisData::xReadPicture()
+{
+  const Int  poc     = Int( readValue( m_file, 4 ) );
+  const UInt numCtus = readValue( m_file, 4 );
+  if ( !m_file.good() || numCtus != m_uiNumCtus )
+  {
+    return false;
+  }
+
+  std::vector<TEncAnalysisCtu>& ctus = m_pictures[poc];
+  ctus.assign( numCtus, TEncAnalysisCtu() );
+  for ( UInt ctuRsAddr = 0; ctuRsAddr < numCtus; ctuRsAddr++ )
+  {
+    const UInt numRuns = readValue( m_file, 2 );
+    if ( numRuns == 0 )
+    {
+      continue;
+    }
+
+    TEncAnalysisCtu& ctu = ctus[ctuRsAddr];
+    for ( UInt run = 0; run < numRuns; run++ )
+    {
+      const UInt  runLength = readValue( m_file, 2 );
+      const UChar depth     = UChar( readValue( m_file, 1 ) );
+      const SChar partSize  = SChar( readValue( m_file, 1 ) );
+      const SChar predMode  = SChar( readValue( m_file, 1 ) );
+      if ( !m_file.good() || ctu.depth.size() + runLength > m_uiNumPartitions )
+      {
+        m_pictures.erase( poc );
+        return false;
+      }
+      ctu.depth.insert   ( ctu.depth.end(),    runLength, depth );
+      ctu.partSize.insert( ctu.partSize.end(), runLength, partSize );
+      ctu.predMode.insert( ctu.predMode.end(), runLength, predMode );
+      for ( UInt list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+      {
+        const SChar refIdx = SChar( readValue( m_file, 1 ) );
+        const Short mvHor  = Short( readValue( m_file, 2 ) );
+        const Short mvVer  = Short( readValue( m_file, 2 ) );
+        ctu.refIdx[list].insert( ctu.refIdx[list].end(), runLength, refIdx );
+        ctu.mv[list].insert    ( ctu.mv[list].end(),     runLength, TComMv( mvHor, mvVer ) );
+      }
+    }
+    if ( ctu.depth.size() != m_uiNumPartitions )
+    {
+      m_pictures.erase( poc );
+      return false;
+    }
+  }
+  return m_file.good();
+}
+
+/** Load the decisions of a picture from the analysis file, if one is open for reading.
+ * The pictures of the file are expected in the coding order of this encode: when the next picture of the file is not
+ * the requested one, it is left in the file and the picture is encoded without analysis data.
+ * \returns true if decisions for the picture are available
+ */
+Bool TEncAnalysisData::readPicture( Int poc )
+{
+  if ( m_pictures.find( poc ) != m_pictures.end() )
+  {
+    return true;
+  }
+  if ( !m_file.is_open() || m_bFileWriteMode || m_file.peek() == EOF )
+  {
+    return false;
+  }
+
+  const std::streampos pictureStart = m_file.tellg();
+  if ( Int( readValue( m_file, 4 ) ) != poc )
+  {
+    m_file.seekg( pictureStart );
+    return false;
+  }
+  m_file.seekg( pictureStart );
+
+  if ( !xReadPicture() )
+  {
+    fprintf( stderr, "Warning: analysis file is corrupt at POC %d, encoding without it from here on\n", poc );
+    closeFile();
+    return false;
+  }
+  return true;
+}
+
+/** Record the final decisions of a CTU once it has been compressed
+ * \param pCtu pointer of the compressed CTU
+ */
+Void TEncAnalysisData::storeCtu( const TComDataCU* pCtu )
+{
+  const TComPic* pcPic      = pCtu->getPic();
+  const UInt     numCtus    = pcPic->getNumberOfCtusInFrame();
+  const UInt     numParts   = pcPic->getNumPartitionsInCtu();
+
+  std::vector<TEncAnalysisCtu>& ctus = m_pictures[pCtu->getSlice()->getPOC()];
+  if ( ctus.size() != numCtus )
+  {
+    ctus.resize( numCtus );
+  }
+
+  TEncAnalysisCtu& ctu = ctus[pCtu->getCtuRsAddr()];
+  ctu.depth.resize   ( numParts );
+  ctu.partSize.resize( numParts );
+  ctu.predMode.resize( numParts );
+  for ( UInt ui = 0; ui < numParts; ui++ )
+  {
+    ctu.depth[ui]    = pCtu->getDepth( ui );
+    ctu.partSize[ui] = SChar( pCtu->getPartitionSize( ui ) );
+    ctu.predMode[ui] = SChar( pCtu->getPredictionMode( ui ) );
+  }
+
+  for ( UInt list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    const TComCUMvField* pcMvField = pCtu->getCUMvField( RefPicList( list ) );
+    ctu.mv[list].resize( numParts );
+    ctu.refIdx[list].resize( numParts );
+    for ( UInt ui = 0; ui < numParts; ui++ )
+    {
+      ctu.mv[list][ui]     = pcMvField->getMv( ui );
+      ctu.refIdx[list][ui] = SChar( pcMvField->getRefIdx( ui ) );
+    }
+  }
+}
+
+/** Drop all stored pictures
+ */
+Void TEncAnalysisData::clear()
+{
+  m_pictures.clear();
+}
+
+/** Get the stored decisions of a CTU
+ * \returns NULL if the CTU has not been stored
+ */
+const TEncAnalysisCtu* TEncAnalysisData::getCtu( Int poc, UInt ctuRsAddr ) const
+{
+  std::map<Int, std::vector<TEncAnalysisCtu> >::const_iterator it = m_pictures.find( poc );
+  if ( it == m_pictures.end() || ctuRsAddr >= it->second.size() || it->second[ctuRsAddr].depth.empty() )
+  {
+    return NULL;
+  }
+  return &it->second[ctuRsAddr];
+}
+
+/** Get the range of CU depths chosen by the reference encode within the area of a CU
+ * \param pcCU          CU being compressed
+ * \param ruiMinDepth   smallest depth found in the area
+ * \param ruiMaxDepth   largest depth found in the area
+ * \returns false if there is no stored data for the CU
+ */
+Bool TEncAnalysisData::getDepthRange( TComDataCU* pcCU, UInt& ruiMinDepth, UInt& ruiMaxDepth ) const
+{
+  const TEncAnalysisCtu* pCtu = getCtu( pcCU->getSlice()->getPOC(), pcCU->getCtuRsAddr() );
+  if ( pCtu == NULL )
+  {
+    return false;
+  }
+
+  const UInt uiStart = pcCU->getZorderIdxInCtu();
+  const UInt uiEnd   = uiStart + pcCU->getTotalNumPart();
+  ruiMinDepth = MAX_UINT;
+  ruiMaxDepth = 0;
+  for ( UInt ui = uiStart; ui < uiEnd; ui++ )
+  {
+    ruiMinDepth = std::min<UInt>( ruiMinDepth, pCtu->depth[ui] );
+    ruiMaxDepth = std::max<UInt>( ruiMaxDepth, pCtu->depth[ui] );
+  }
+  return true;
+}
+
+/** Get the motion vector the reference encode used at the top-left of a prediction unit
+ * \param pcCU          CU being searched
+ * \param uiPartAddr    address of the prediction unit relative to the CU
+ * \param eRefPicList   reference picture list
+ * \param iRefIdx       reference index
+ * \param rcMv          returned motion vector in quarter-sample units
+ * \returns false if the reference encode did not predict that area from the same reference picture
+ */
+Bool TEncAnalysisData::getMv( TComDataCU* pcCU, UInt uiPartAddr, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv ) const
+{
+  const TEncAnalysisCtu* pCtu = getCtu( pcCU->getSlice()->getPOC(), pcCU->getCtuRsAddr() );
+  if ( pCtu == NULL )
+  {
+    return false;
+  }
+
+  const UInt uiAbsPartIdx = pcCU->getZorderIdxInCtu() + uiPartAddr;
+  if ( pCtu->predMode[uiAbsPartIdx] != MODE_INTER || pCtu->refIdx[eRefPicList][uiAbsPartIdx] != iRefIdx )
+  {
+    return false;
+  }
+  rcMv = pCtu->mv[eRefPicList][uiAbsPartIdx];
+  return true;
+}
+
+//! \}
@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncAnalysisData.h
+    \brief    store of CU decisions and motion shared between encodes of the same source (header)
+*/
+
+#ifndef __TENCANALYSISDATA__
+#define __TENCANALYSISDATA__
+
+#include <map>
+#include <vector>
+#include <fstream>
+#include <string>
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComMv.h"
+
+class TComDataCU;
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const UInt ANALYSIS_DEPTH_MARGIN        = 0; ///< CU depths tested beyond the depth range chosen by the reference encode
+static const Int  ANALYSIS_REFINE_SEARCH_RANGE = 8; ///< integer search range around a motion vector of the reference encode
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// final decisions of one CTU, one entry per minimum partition in z-scan order
+struct TEncAnalysisCtu
+{
+  std::vector<UChar>  depth;
+  std::vector<SChar>  partSize;
+  std::vector<SChar>  predMode;
+  std::vector<TComMv> mv[NUM_REF_PIC_LIST_01];
+  std::vector<SChar>  refIdx[NUM_REF_PIC_LIST_01];
+};
+
+/// CU decisions and motion vectors of a reference encode, used to narrow the search of other encodes of the same source.
+/// The decisions can also be written to an analysis file, picture by picture in coding order, and read back by a later
+/// encode of the same source with the same geometry and coding structure.
+class TEncAnalysisData
+{
+private:
+  std::map<Int, std::vector<TEncAnalysisCtu> > m_pictures;   ///< CTUs of each picture, keyed by POC
+
+  std::fstream m_file;                                       ///< analysis file
+  Bool         m_bFileWriteMode;                             ///< true: pictures are written to the file, false: read from it
+  UInt         m_uiNumCtus;                                  ///< number of CTUs in a picture of the analysis file
+  UInt         m_uiNumPartitions;                            ///< number of minimum partitions in a CTU of the analysis file
+
+  Bool  xReadPicture  ();
+
+public:
+  TEncAnalysisData();
+  virtual ~TEncAnalysisData();
+
+  Bool  openFile      ( const std::string& fileName, Bool bWriteMode, UInt uiPicWidth, UInt uiPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxTotalCUDepth );
+  Void  closeFile     ();
+  Void  writePicture  ( Int poc );
+  Bool  readPicture   ( Int poc );
+
+  Void  storeCtu      ( const TComDataCU* pCtu );
+  Void  clear         ();
+
+  const TEncAnalysisCtu* getCtu( Int poc, UInt ctuRsAddr ) const;
+  Bool  getDepthRange ( TComDataCU* pcCU, UInt& ruiMinDepth, UInt& ruiMaxDepth ) const;
+  Bool  getMv         ( TComDataCU* pcCU, UInt uiPartAddr, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv ) const;
+};
+
+//! \}
+
+#endif // __TENCANALYSISDATA__
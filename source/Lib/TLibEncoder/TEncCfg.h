@@ -46,6 +46,8 @@
 #include "TLibCommon/TComSlice.h"
 #include <assert.h>
 
+class TEncAnalysisData;
+
 struct GOPEntry
 {
   Int m_POC;
@@ -201,6 +203,12 @@ protected:
   MESearchMethod m_motionEstimationSearchMethod;
   Int       m_iSearchRange;                     //  0:Full frame
   Int       m_bipredSearchRange;
+  Int       m_subPelPlanes;                     //  0:off 1:half-sample planes 2:all sub-sample planes
+  Bool      m_bHierarchicalME;
+  Int       m_hierarchicalMERange;              //  full search range of the coarse search at quarter resolution
+  Int       m_hierarchicalMERefineRange;        //  search range of the TZ search around its best start point
+  Bool      m_bLuma8BitME;                      //  integer motion search SADs on 8-bit copies of the luma samples
+  Bool      m_bCompressedReferences;            //  keep the reference pictures a picture does not predict from compressed
   Bool      m_bClipForBiPredMeEnabled;
   Bool      m_bFastMEAssumingSmootherMVEnabled;
   Int       m_minSearchWindow;
@@ -281,6 +289,7 @@ protected:
   Int       m_iNumRowsMinus1;
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
+  Bool      m_bTileMajorSource;                 //  keep a copy of the source picture with each tile in its own contiguous block
 
   Bool      m_entropyCodingSyncEnabledFlag;
 
@@ -372,6 +381,7 @@ protected:
   Int       m_RCKeepHierarchicalBit;
   Bool      m_RCLCULevelRC;
   Bool      m_RCUseLCUSeparateModel;
+  Bool      m_RCTileLevelRC;
   Int       m_RCInitialQP;
   Bool      m_RCForceIntraQP;
   Bool      m_RCCpbSaturationEnabled;
@@ -427,10 +437,22 @@ protected:
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
 
+  TEncAnalysisData*       m_analysisSave;                     ///< receives the CU decisions of this encode (not owned)
+  TEncAnalysisData*       m_analysisLoad;                     ///< CU decisions of a reference encode used to narrow the search (not owned)
+
 public:
   TEncCfg()
-  : m_tileColumnWidth()
+  : m_subPelPlanes(0)
+  , m_bHierarchicalME(false)
+  , m_hierarchicalMERange(32)
+  , m_hierarchicalMERefineRange(16)
+  , m_bLuma8BitME(false)
+  , m_bCompressedReferences(false)
+  , m_tileColumnWidth()
   , m_tileRowHeight()
+  , m_bTileMajorSource(false)
+  , m_analysisSave(NULL)
+  , m_analysisLoad(NULL)
   {
     m_PCMBitDepth[CHANNEL_TYPE_LUMA]=8;
     m_PCMBitDepth[CHANNEL_TYPE_CHROMA]=8;
@@ -521,6 +543,12 @@ public:
   Void      setMotionEstimationSearchMethod ( MESearchMethod e ) { m_motionEstimationSearchMethod = e; }
   Void      setSearchRange                  ( Int   i )      { m_iSearchRange = i; }
   Void      setBipredSearchRange            ( Int   i )      { m_bipredSearchRange = i; }
+  Void      setSubPelPlanes                 ( Int   i )      { m_subPelPlanes = i; }
+  Void      setHierarchicalME               ( Bool  b )      { m_bHierarchicalME = b; }
+  Void      setHierarchicalMERange          ( Int   i )      { m_hierarchicalMERange = i; }
+  Void      setHierarchicalMERefineRange    ( Int   i )      { m_hierarchicalMERefineRange = i; }
+  Void      setLuma8BitME                   ( Bool  b )      { m_bLuma8BitME = b; }
+  Void      setCompressedReferences         ( Bool  b )      { m_bCompressedReferences = b; }
   Void      setClipForBiPredMeEnabled       ( Bool  b )      { m_bClipForBiPredMeEnabled = b; }
   Void      setFastMEAssumingSmootherMVEnabled ( Bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   Void      setMinSearchWindow              ( Int   i )      { m_minSearchWindow = i; }
@@ -618,6 +646,12 @@ public:
   Bool      getDisableIntraPUsInInterSlices    () const { return m_bDisableIntraPUsInInterSlices; }
   MESearchMethod getMotionEstimationSearchMethod ( ) const { return m_motionEstimationSearchMethod; }
   Int       getSearchRange                     () const { return m_iSearchRange; }
+  Int       getSubPelPlanes                    () const { return m_subPelPlanes; }
+  Bool      getHierarchicalME                  () const { return m_bHierarchicalME; }
+  Int       getHierarchicalMERange             () const { return m_hierarchicalMERange; }
+  Int       getHierarchicalMERefineRange       () const { return m_hierarchicalMERefineRange; }
+  Bool      getLuma8BitME                      () const { return m_bLuma8BitME; }
+  Bool      getCompressedReferences            () const { return m_bCompressedReferences; }
   Bool      getClipForBiPredMeEnabled          () const { return m_bClipForBiPredMeEnabled; }
   Bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
@@ -746,6 +780,8 @@ public:
   Int   getNumRowsMinus1               ()                            { return m_iNumRowsMinus1; }
   Void  setRowHeight ( const std::vector<Int>& rowHeight)            { m_tileRowHeight = rowHeight; }
   UInt  getRowHeight                   ( UInt rowIdx )               { return m_tileRowHeight[rowIdx]; }
+  Void  setTileMajorSource             ( Bool b )                    { m_bTileMajorSource = b; }
+  Bool  getTileMajorSource             () const                      { return m_bTileMajorSource; }
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
@@ -923,6 +959,8 @@ public:
   Void         setLCULevelRC          ( Bool b )                     { m_RCLCULevelRC = b; }
   Bool         getUseLCUSeparateModel ()                             { return m_RCUseLCUSeparateModel; }
   Void         setUseLCUSeparateModel ( Bool b )                     { m_RCUseLCUSeparateModel = b;    }
+  Bool         getTileLevelRC         ()                             { return m_RCTileLevelRC;         }
+  Void         setTileLevelRC         ( Bool b )                     { m_RCTileLevelRC = b;            }
   Int          getInitialQP           ()                             { return m_RCInitialQP;           }
   Void         setInitialQP           ( Int QP )                     { m_RCInitialQP = QP;             }
   Bool         getForceIntraQP        ()                             { return m_RCForceIntraQP;        }
@@ -1058,6 +1096,11 @@ public:
 
   Void      setSummaryVerboseness(UInt v)                            { m_summaryVerboseness = v; }
   UInt      getSummaryVerboseness( ) const                           { return m_summaryVerboseness; }
+
+  Void      setAnalysisSave(TEncAnalysisData* p)                     { m_analysisSave = p; }
+  TEncAnalysisData* getAnalysisSave() const                          { return m_analysisSave; }
+  Void      setAnalysisLoad(TEncAnalysisData* p)                     { m_analysisLoad = p; }
+  TEncAnalysisData* getAnalysisLoad() const                          { return m_analysisLoad; }
 };
 
 //! \}
@@ -446,7 +446,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   const UInt fastDeltaQPCuMaxSize    = Clip3(sps.getMaxCUHeight()>>sps.getLog2DiffMaxMinCodingBlockSize(), sps.getMaxCUHeight(), 32u);
 
   // get Original YUV data from picture
-  m_ppcOrigYuv[uiDepth]->copyFromPicYuv( pcPic->getPicYuvOrg(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu() );
+  m_ppcOrigYuv[uiDepth]->copyFromPicYuv( pcPic->getPicYuvOrgForCtuAccess(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu() );
 
   // variable for Cbf fast mode PU decision
   Bool    doNotBlockPu = true;
@@ -512,7 +512,17 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
   const Bool bBoundary = !( uiRPelX < sps.getPicWidthInLumaSamples() && uiBPelY < sps.getPicHeightInLumaSamples() );
 
-  if ( !bBoundary )
+  // restrict the tested depths to a window around the depths chosen by a reference encode of the same source
+  Bool bTestNonSplit = true;
+  Bool bTestSplit    = true;
+  UInt uiRefMinDepth, uiRefMaxDepth;
+  if ( !bBoundary && m_pcEncCfg->getAnalysisLoad() != NULL && m_pcEncCfg->getAnalysisLoad()->getDepthRange( rpcBestCU, uiRefMinDepth, uiRefMaxDepth ) )
+  {
+    bTestNonSplit = uiDepth + ANALYSIS_DEPTH_MARGIN >= uiRefMinDepth;
+    bTestSplit    = uiDepth < uiRefMaxDepth + ANALYSIS_DEPTH_MARGIN;
+  }
+
+  if ( !bBoundary && bTestNonSplit )
   {
     for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
     {
@@ -837,7 +847,10 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
     iMaxQP = iMinQP; // If all TUs are forced into using transquant bypass, do not loop here.
   }
 
-  const Bool bSubBranch = bBoundary || !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getTotalCost()!=MAX_DOUBLE && rpcBestCU->isSkipped(0) );
+  const Bool bSubBranch = bBoundary || ( bTestSplit && !( m_pcEncCfg->getUseEarlyCU() && rpcBestCU->getTotalCost()!=MAX_DOUBLE && rpcBestCU->isSkipped(0) ) );
+
+  // whether the best CU is the split tested last, whose sub-CUs have each copied their data to the picture already
+  Bool bBestSplitInPic = false;
 
   if( bSubBranch && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() && (!getFastDeltaQp() || uiWidth > fastDeltaQPCuMaxSize || bBoundary))
   {
@@ -981,16 +994,25 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         }
       }
 
+      const TComDataCU* pcSplitCU = rpcTempCU;
       xCheckBestMode( rpcBestCU, rpcTempCU, uiDepth DEBUG_STRING_PASS_INTO(sDebug) DEBUG_STRING_PASS_INTO(sTempDebug) DEBUG_STRING_PASS_INTO(false) ); // RD compare current larger prediction
                                                                                                                                                        // with sub partitioned prediction.
+      bBestSplitInPic = rpcBestCU == pcSplitCU;
     }
   }
 
   DEBUG_STRING_APPEND(sDebug_, sDebug);
 
-  rpcBestCU->copyToPic(uiDepth);                                                     // Copy Best data to Picture for next partition prediction.
+  if ( bBestSplitInPic )
+  {
+    rpcBestCU->copyQPToPic();                                                        // Sub-CU data and Yuv are already in the picture.
+  }
+  else
+  {
+    rpcBestCU->copyToPic(uiDepth);                                                   // Copy Best data to Picture for next partition prediction.
 
-  xCopyYuv2Pic( rpcBestCU->getPic(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu(), uiDepth, uiDepth );   // Copy Yuv data to picture Yuv
+    xCopyYuv2Pic( rpcBestCU->getPic(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu(), uiDepth, uiDepth );   // Copy Yuv data to picture Yuv
+  }
   if (bBoundary)
   {
     return;
@@ -1269,8 +1291,8 @@ Int  TEncCu::updateCtuDataISlice(TComDataCU* pCtu, Int width, Int height)
   Int  xBl, yBl;
   const Int iBlkSize = 8;
 
-  Pel* pOrgInit   = pCtu->getPic()->getPicYuvOrg()->getAddr(COMPONENT_Y, pCtu->getCtuRsAddr(), 0);
-  Int  iStrideOrig = pCtu->getPic()->getPicYuvOrg()->getStride(COMPONENT_Y);
+  Pel* pOrgInit   = pCtu->getPic()->getPicYuvOrgForCtuAccess()->getAddr(COMPONENT_Y, pCtu->getCtuRsAddr(), 0);
+  Int  iStrideOrig = pCtu->getPic()->getPicYuvOrgForCtuAccess()->getStride(COMPONENT_Y);
   Pel  *pOrg;
 
   Int iSumHad = 0;
@@ -1196,6 +1196,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     pcPic->prepareForReconstruction();
 
 #endif
+    // sub-sample planes and the 8-bit luma kept with the reconstruction buffer were computed from the picture previously held in it
+    if (pcPic->getPicYuvRec()->getSubPelPlanes() != NULL)
+    {
+      pcPic->getPicYuvRec()->getSubPelPlanes()->reset();
+    }
+    pcPic->getPicYuvRec()->invalidateLuma8();
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
@@ -1353,6 +1359,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
     //  Set reference list
     pcSlice->setRefPicList ( rcListPic );
+#if REDUCED_ENCODER_MEMORY
+    if (m_pcCfg->getCompressedReferences())
+    {
+      xCompressUnusedReferences( rcListPic, pcSlice );
+    }
+#endif
 
     //  Slice info. refinement
     if ( (pcSlice->getSliceType() == B_SLICE) && (pcSlice->getNumRefIdx(REF_PIC_LIST_1) == 0) )
@@ -1539,6 +1551,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         }
 
         list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+        if ( m_pcCfg->getTileLevelRC() )
+        {
+          m_pcRateCtrl->initRCTileTargetBits();
+        }
         m_pcRateCtrl->getRCPic()->getLCUInitTargetBits();
         lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
         sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
@@ -1546,6 +1562,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       else    // normal case
       {
         list<TEncRCPic*> listPreviousPicture = m_pcRateCtrl->getPicList();
+        if ( m_pcCfg->getTileLevelRC() )
+        {
+          m_pcRateCtrl->initRCTileTargetBits();
+        }
         lambda  = m_pcRateCtrl->getRCPic()->estimatePicLambda( listPreviousPicture, pcSlice->getSliceType());
         sliceQP = m_pcRateCtrl->getRCPic()->estimatePicQP( lambda, listPreviousPicture );
       }
@@ -1564,6 +1584,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
     std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
 
+    // decisions of an earlier encode of the same source, when they are read from an analysis file
+    if ( m_pcCfg->getAnalysisLoad() != NULL )
+    {
+      m_pcCfg->getAnalysisLoad()->readPicture( pocCurr );
+    }
+
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
       const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
@@ -1607,6 +1633,11 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
     }
 
+    if ( m_pcCfg->getAnalysisSave() != NULL )
+    {
+      m_pcCfg->getAnalysisSave()->writePicture( pocCurr );
+    }
+
     duData.clear();
     pcSlice = pcPic->getSlice(0);
 
@@ -1880,6 +1911,19 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         m_pcRateCtrl->updateCpbState(actualTotalBits);
         printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
       }
+      if ( m_pcCfg->getTileLevelRC() )
+      {
+        m_pcRateCtrl->updateTileCpbState();
+        if (m_pcRateCtrl->getCpbSaturationEnabled())
+        {
+          printf(" [tile CPB");
+          for (Int tileIdx = 0; tileIdx < m_pcRateCtrl->getRCSeq()->getNumberOfTile(); tileIdx++)
+          {
+            printf(" %d", m_pcRateCtrl->getTileCpbState(tileIdx));
+          }
+          printf("]");
+        }
+      }
     }
 
     xCreatePictureTimingSEI(m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
@@ -2079,6 +2123,36 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   return;
 }
 
+#if REDUCED_ENCODER_MEMORY
+/** keep compressed the reconstructions of the pictures held for reference that the slice does not predict from.
+ *  TComSlice::setRefPicList() restores them when a later slice predicts from them again.
+ */
+Void TEncGOP::xCompressUnusedReferences( TComList<TComPic*>& rcListPic, const TComSlice* pcSlice )
+{
+  for (TComList<TComPic*>::iterator iterPic = rcListPic.begin(); iterPic != rcListPic.end(); iterPic++)
+  {
+    TComPic* pcRefPic = *iterPic;
+    if (pcRefPic == pcSlice->getPic() || !pcRefPic->getReconMark() || !pcRefPic->getSlice(0)->isReferenced() || pcRefPic->isReconstructionCompressed())
+    {
+      continue;
+    }
+
+    Bool bInRefPicList = false;
+    for (Int list = 0; list < NUM_REF_PIC_LIST_01 && !bInRefPicList; list++)
+    {
+      for (Int refIdx = 0; refIdx < pcSlice->getNumRefIdx(RefPicList(list)) && !bInRefPicList; refIdx++)
+      {
+        bInRefPicList = pcSlice->getRefPic(RefPicList(list), refIdx) == pcRefPic;
+      }
+    }
+    if (!bInRefPicList)
+    {
+      pcRefPic->compressReconstruction();
+    }
+  }
+}
+#endif
+
 UInt64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1, const BitDepths &bitDepths)
 {
   UInt64  uiTotalDiff = 0;
@@ -2168,6 +2242,9 @@ Void TEncGOP::xCalculateAddPSNRs( const Bool isField, const Bool isFieldTopField
         iterPic ++;
       }
       TComPic* correspondingFieldPic = *(iterPic);
+#if REDUCED_ENCODER_MEMORY
+      correspondingFieldPic->decompressReconstruction();
+#endif
 
       if( (pcPic->isTopField() && isFieldTopFieldFirst) || (!pcPic->isTopField() && !isFieldTopFieldFirst))
       {
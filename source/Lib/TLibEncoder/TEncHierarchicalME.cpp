@@ -0,0 +1,379 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncHierarchicalME.cpp
+    \brief    coarse motion search on downsampled pictures
+*/
+
+#include <limits>
+#include <stdlib.h>
+
+#include "TEncHierarchicalME.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComDataCU.h"
+#include "TLibCommon/TComRom.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const Int HME_MAX_BATCH = 64;  ///< candidates of one row whose SADs are computed together
+
+// ====================================================================================================================
+// Local functions
+// ====================================================================================================================
+
+/// 2x2 averaging of the luma of pcSrc into pcDst, which has half its width and height (rounded up)
+static Void downsampleLuma( const TComPicYuv* pcSrc, TComPicYuv* pcDst )
+{
+  const Int  iSrcWidth  = pcSrc->getWidth ( COMPONENT_Y );
+  const Int  iSrcHeight = pcSrc->getHeight( COMPONENT_Y );
+  const Int  iSrcStride = pcSrc->getStride( COMPONENT_Y );
+  const Int  iDstWidth  = pcDst->getWidth ( COMPONENT_Y );
+  const Int  iDstHeight = pcDst->getHeight( COMPONENT_Y );
+  const Int  iDstStride = pcDst->getStride( COMPONENT_Y );
+  const Pel* piSrc      = pcSrc->getAddr  ( COMPONENT_Y );
+  Pel*       piDst      = pcDst->getAddr  ( COMPONENT_Y );
+
+  for( Int y = 0; y < iDstHeight; y++ )
+  {
+    const Pel* piRow0 = piSrc + ( 2 * y ) * iSrcStride;
+    const Pel* piRow1 = piSrc + std::min( 2 * y + 1, iSrcHeight - 1 ) * iSrcStride;
+    for( Int x = 0; x < iDstWidth; x++ )
+    {
+      const Int x0 = 2 * x;
+      const Int x1 = std::min( 2 * x + 1, iSrcWidth - 1 );
+      piDst[x] = ( piRow0[x0] + piRow0[x1] + piRow1[x0] + piRow1[x1] + 2 ) >> 2;
+    }
+    piDst += iDstStride;
+  }
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization
+// ====================================================================================================================
+
+TEncHierarchicalME::TEncHierarchicalME()
+: m_pcRdCost      ( NULL )
+, m_iSearchRange  ( 0 )
+, m_uiMaxCUWidth  ( 0 )
+, m_uiMaxCUHeight ( 0 )
+, m_iCurrPOC      ( std::numeric_limits<Int>::max() )
+, m_iNumBlocksX   ( 0 )
+, m_iNumBlocksY   ( 0 )
+{
+}
+
+TEncHierarchicalME::~TEncHierarchicalME()
+{
+  destroy();
+}
+
+Void TEncHierarchicalME::init( TComRdCost* pcRdCost, Int iSearchRange, UInt uiMaxCUWidth, UInt uiMaxCUHeight )
+{
+  destroy();
+
+  m_pcRdCost      = pcRdCost;
+  m_iSearchRange  = iSearchRange;
+  m_uiMaxCUWidth  = uiMaxCUWidth;
+  m_uiMaxCUHeight = uiMaxCUHeight;
+}
+
+Void TEncHierarchicalME::destroy()
+{
+  for( std::map<Int, Pyramid>::iterator it = m_pyramids.begin(); it != m_pyramids.end(); it++ )
+  {
+    xDestroyPyramid( it->second );
+  }
+  m_pyramids.clear();
+  m_vectors.clear();
+  m_iCurrPOC = std::numeric_limits<Int>::max();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TEncHierarchicalME::initPicture( TComPic* pcPic )
+{
+  const Int iPOC = pcPic->getPOC();
+  if( iPOC == m_iCurrPOC )
+  {
+    // already prepared for an earlier slice of the picture
+    return;
+  }
+
+  // keep the pictures of the reference picture set, the others will not be referenced again
+  const TComReferencePictureSet* pcRPS = pcPic->getSlice( 0 )->getRPS();
+  const Int iNumShortTerm = pcRPS->getNumberOfNegativePictures() + pcRPS->getNumberOfPositivePictures();
+  for( std::map<Int, Pyramid>::iterator it = m_pyramids.begin(); it != m_pyramids.end(); )
+  {
+    Bool bKeep = false;
+    for( Int i = 0; i < iNumShortTerm && !bKeep; i++ )
+    {
+      bKeep = ( iPOC + pcRPS->getDeltaPOC( i ) == it->first );
+    }
+    if( bKeep )
+    {
+      it++;
+    }
+    else
+    {
+      xDestroyPyramid( it->second );
+      m_pyramids.erase( it++ );
+    }
+  }
+
+  m_iCurrPOC    = iPOC;
+  m_iNumBlocksX = ( pcPic->getPicYuvOrg()->getWidth ( COMPONENT_Y ) + ( 1 << HME_LOG2_BLOCK ) - 1 ) >> HME_LOG2_BLOCK;
+  m_iNumBlocksY = ( pcPic->getPicYuvOrg()->getHeight( COMPONENT_Y ) + ( 1 << HME_LOG2_BLOCK ) - 1 ) >> HME_LOG2_BLOCK;
+  m_vectors.clear();
+
+  xGetPyramid( pcPic );
+}
+
+Bool TEncHierarchicalME::getMv( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv )
+{
+  TComPic* pcPic = pcCU->getPic();
+  if( pcPic->getPOC() != m_iCurrPOC )
+  {
+    return false;
+  }
+
+  TComPic*  pcRefPic = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx );
+  const Int iRefPOC  = pcRefPic->getPOC();
+  std::map<Int, std::vector<TComMv> >::iterator it = m_vectors.find( iRefPOC );
+  if( it == m_vectors.end() )
+  {
+    const Pyramid& rcCurr = xGetPyramid( pcPic );
+    const Pyramid& rcRef  = xGetPyramid( pcRefPic );
+    it = m_vectors.insert( std::make_pair( iRefPOC, std::vector<TComMv>() ) ).first;
+    xSearch( rcCurr, rcRef, pcCU->getSlice()->getSPS()->getBitDepth( CHANNEL_TYPE_LUMA ), it->second );
+  }
+
+  const Int iCentreX = pcCU->getCUPelX() + g_auiRasterToPelX[ g_auiZscanToRaster[ uiPartAddr ] ] + ( iWidth  >> 1 );
+  const Int iCentreY = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiPartAddr ] ] + ( iHeight >> 1 );
+  const Int iBlockX  = std::min( iCentreX >> HME_LOG2_BLOCK, m_iNumBlocksX - 1 );
+  const Int iBlockY  = std::min( iCentreY >> HME_LOG2_BLOCK, m_iNumBlocksY - 1 );
+  rcMv = it->second[ iBlockY * m_iNumBlocksX + iBlockX ];
+  return true;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/** downsampled pictures of pcPic, built from its original, or from its reconstruction once the original has been
+ *  released (for example for a long-term reference that was dropped from the cache)
+ */
+TEncHierarchicalME::Pyramid& TEncHierarchicalME::xGetPyramid( TComPic* pcPic )
+{
+  std::map<Int, Pyramid>::iterator it = m_pyramids.find( pcPic->getPOC() );
+  if( it == m_pyramids.end() )
+  {
+    Pyramid cPyramid;
+    xBuildPyramid( pcPic->getPicYuvOrg() != NULL ? pcPic->getPicYuvOrg() : pcPic->getPicYuvRec(), cPyramid );
+    it = m_pyramids.insert( std::make_pair( pcPic->getPOC(), cPyramid ) ).first;
+  }
+  return it->second;
+}
+
+Void TEncHierarchicalME::xBuildPyramid( const TComPicYuv* pcSrc, Pyramid& rcPyramid )
+{
+  // margins for the vectors reachable at each level: the search range and one refinement step at the lowest
+  // resolution, doubled and refined once more at the next one
+  const Int aiMargin[HME_NUM_LEVELS] = { 2 * m_iSearchRange + 3 + ( 1 << ( HME_LOG2_BLOCK - 1 ) ),
+                                         m_iSearchRange + 1 + (Int)std::max( m_uiMaxCUWidth, m_uiMaxCUHeight ) / 4 };
+
+  const TComPicYuv* pcLevelSrc = pcSrc;
+  for( Int iLevel = 0; iLevel < HME_NUM_LEVELS; iLevel++ )
+  {
+    TComPicYuv* pcLevel = new TComPicYuv;
+    pcLevel->createWithoutCUInfo( ( pcLevelSrc->getWidth ( COMPONENT_Y ) + 1 ) >> 1,
+                                  ( pcLevelSrc->getHeight( COMPONENT_Y ) + 1 ) >> 1,
+                                  CHROMA_400, true, aiMargin[iLevel], aiMargin[iLevel] );
+    downsampleLuma( pcLevelSrc, pcLevel );
+    pcLevel->extendPicBorder();
+    rcPyramid.apcLevel[iLevel] = pcLevel;
+    pcLevelSrc = pcLevel;
+  }
+}
+
+Void TEncHierarchicalME::xDestroyPyramid( Pyramid& rcPyramid )
+{
+  for( Int iLevel = 0; iLevel < HME_NUM_LEVELS; iLevel++ )
+  {
+    if( rcPyramid.apcLevel[iLevel] )
+    {
+      rcPyramid.apcLevel[iLevel]->destroy();
+      delete rcPyramid.apcLevel[iLevel];
+      rcPyramid.apcLevel[iLevel] = NULL;
+    }
+  }
+}
+
+/** full search of each CTU at the lowest resolution, refined for each 16x16 block around the vectors of its CTU and of
+ *  its left and above neighbours, then refined again at half resolution
+ */
+Void TEncHierarchicalME::xSearch( const Pyramid& rcCurr, const Pyramid& rcRef, Int iBitDepth, std::vector<TComMv>& rcVectors )
+{
+  const Int iLowLevel   = HME_NUM_LEVELS - 1;
+  const Int iCtuWidth   = m_uiMaxCUWidth  >> ( iLowLevel + 1 );
+  const Int iCtuHeight  = m_uiMaxCUHeight >> ( iLowLevel + 1 );
+  const Int iLowBlock   = 1 << ( HME_LOG2_BLOCK - iLowLevel - 1 );
+  const Int iHalfBlock  = 1 << ( HME_LOG2_BLOCK - 1 );
+  const Int iNumCtusX   = ( rcCurr.apcLevel[iLowLevel]->getWidth ( COMPONENT_Y ) + iCtuWidth  - 1 ) / iCtuWidth;
+  const Int iNumCtusY   = ( rcCurr.apcLevel[iLowLevel]->getHeight( COMPONENT_Y ) + iCtuHeight - 1 ) / iCtuHeight;
+  const TComMv cZeroMv;
+
+  std::vector<TComMv> cCtuVectors( iNumCtusX * iNumCtusY );
+  for( Int iCtuY = 0; iCtuY < iNumCtusY; iCtuY++ )
+  {
+    for( Int iCtuX = 0; iCtuX < iNumCtusX; iCtuX++ )
+    {
+      xSearchBlock( rcCurr.apcLevel[iLowLevel], rcRef.apcLevel[iLowLevel], iBitDepth, iCtuX * iCtuWidth, iCtuY * iCtuHeight, iCtuWidth, iCtuHeight,
+                    &cZeroMv, 1, m_iSearchRange, cCtuVectors[iCtuY * iNumCtusX + iCtuX] );
+    }
+  }
+
+  rcVectors.resize( m_iNumBlocksX * m_iNumBlocksY );
+  const Int iBlocksPerCtuX = m_uiMaxCUWidth  >> HME_LOG2_BLOCK;
+  const Int iBlocksPerCtuY = m_uiMaxCUHeight >> HME_LOG2_BLOCK;
+  for( Int iBlockY = 0; iBlockY < m_iNumBlocksY; iBlockY++ )
+  {
+    for( Int iBlockX = 0; iBlockX < m_iNumBlocksX; iBlockX++ )
+    {
+      TComMv acCands[4];
+      Int    iNumCands = 0;
+      acCands[iNumCands++] = cCtuVectors[( iBlockY / iBlocksPerCtuY ) * iNumCtusX + iBlockX / iBlocksPerCtuX];
+      acCands[iNumCands++] = cZeroMv;
+      if( iBlockX > 0 )
+      {
+        acCands[iNumCands++] = rcVectors[iBlockY * m_iNumBlocksX + iBlockX - 1];
+      }
+      if( iBlockY > 0 )
+      {
+        acCands[iNumCands++] = rcVectors[( iBlockY - 1 ) * m_iNumBlocksX + iBlockX];
+      }
+
+      // the vectors stay at the lowest resolution until the half resolution pass below, so the left and above neighbours can be used directly
+      TComMv& rcMv = rcVectors[iBlockY * m_iNumBlocksX + iBlockX];
+      xSearchBlock( rcCurr.apcLevel[iLowLevel], rcRef.apcLevel[iLowLevel], iBitDepth, iBlockX * iLowBlock, iBlockY * iLowBlock, iLowBlock, iLowBlock,
+                    acCands, iNumCands, 1, rcMv );
+    }
+  }
+
+  for( Int iBlockY = 0; iBlockY < m_iNumBlocksY; iBlockY++ )
+  {
+    for( Int iBlockX = 0; iBlockX < m_iNumBlocksX; iBlockX++ )
+    {
+      TComMv& rcMv = rcVectors[iBlockY * m_iNumBlocksX + iBlockX];
+      const TComMv cCand( rcMv.getHor() * 2, rcMv.getVer() * 2 );
+      xSearchBlock( rcCurr.apcLevel[0], rcRef.apcLevel[0], iBitDepth, iBlockX * iHalfBlock, iBlockY * iHalfBlock, iHalfBlock, iHalfBlock,
+                    &cCand, 1, 1, rcMv );
+      rcMv.set( rcMv.getHor() * 2, rcMv.getVer() * 2 );
+    }
+  }
+}
+
+/** best SAD vector of a block among the candidates and the positions within iRange around the best of them.
+ *  Ties go to the shorter vector, so that flat areas keep small vectors.
+ */
+Void TEncHierarchicalME::xSearchBlock( const TComPicYuv* pcCurr, const TComPicYuv* pcRef, Int iBitDepth, Int iPosX, Int iPosY, Int iWidth, Int iHeight,
+                                       const TComMv* pcCands, Int iNumCands, Int iRange, TComMv& rcBestMv )
+{
+  const Int iRefStride = pcRef->getStride( COMPONENT_Y );
+  const Pel* piRef     = pcRef->getAddr( COMPONENT_Y ) + iPosY * iRefStride + iPosX;
+
+  // keep the block inside the padded reference
+  const Int iMinX = -pcRef->getMarginX( COMPONENT_Y ) - iPosX;
+  const Int iMaxX =  pcRef->getWidth  ( COMPONENT_Y ) + pcRef->getMarginX( COMPONENT_Y ) - iWidth  - iPosX;
+  const Int iMinY = -pcRef->getMarginY( COMPONENT_Y ) - iPosY;
+  const Int iMaxY =  pcRef->getHeight ( COMPONENT_Y ) + pcRef->getMarginY( COMPONENT_Y ) - iHeight - iPosY;
+
+  DistParam cDistParam;
+  m_pcRdCost->setDistParam( iWidth, iHeight, DF_SAD, cDistParam );
+  cDistParam.pOrg       = pcCurr->getAddr( COMPONENT_Y ) + iPosY * pcCurr->getStride( COMPONENT_Y ) + iPosX;
+  cDistParam.iStrideOrg = pcCurr->getStride( COMPONENT_Y );
+  cDistParam.iStrideCur = iRefStride;
+  cDistParam.bitDepth   = iBitDepth;
+  cDistParam.compIdx    = COMPONENT_Y;
+
+  Distortion uiBestSad  = std::numeric_limits<Distortion>::max();
+  Int        iBestLen   = 0;
+  for( Int i = 0; i < iNumCands; i++ )
+  {
+    const Int iHor = Clip3( iMinX, iMaxX, pcCands[i].getHor() );
+    const Int iVer = Clip3( iMinY, iMaxY, pcCands[i].getVer() );
+    cDistParam.pCur = piRef + iVer * iRefStride + iHor;
+    const Distortion uiSad = cDistParam.DistFunc( &cDistParam );
+    const Int        iLen  = abs( iHor ) + abs( iVer );
+    if( uiSad < uiBestSad || ( uiSad == uiBestSad && iLen < iBestLen ) )
+    {
+      uiBestSad = uiSad;
+      iBestLen  = iLen;
+      rcBestMv.set( iHor, iVer );
+    }
+  }
+
+  const Int iLeft   = std::max( iMinX, rcBestMv.getHor() - iRange );
+  const Int iRight  = std::min( iMaxX, rcBestMv.getHor() + iRange );
+  const Int iTop    = std::max( iMinY, rcBestMv.getVer() - iRange );
+  const Int iBottom = std::min( iMaxY, rcBestMv.getVer() + iRange );
+
+  const Pel* apiCurs[HME_MAX_BATCH];
+  Distortion auiSads[HME_MAX_BATCH];
+  for( Int iVer = iTop; iVer <= iBottom; iVer++ )
+  {
+    for( Int iStart = iLeft; iStart <= iRight; iStart += HME_MAX_BATCH )
+    {
+      const Int iNum = std::min( HME_MAX_BATCH, iRight - iStart + 1 );
+      for( Int i = 0; i < iNum; i++ )
+      {
+        apiCurs[i] = piRef + iVer * iRefStride + iStart + i;
+      }
+      TComRdCost::getSADs( cDistParam, apiCurs, iNum, auiSads );
+      for( Int i = 0; i < iNum; i++ )
+      {
+        const Int iLen = abs( iStart + i ) + abs( iVer );
+        if( auiSads[i] < uiBestSad || ( auiSads[i] == uiBestSad && iLen < iBestLen ) )
+        {
+          uiBestSad = auiSads[i];
+          iBestLen  = iLen;
+          rcBestMv.set( iStart + i, iVer );
+        }
+      }
+    }
+  }
+}
+
+//! \}
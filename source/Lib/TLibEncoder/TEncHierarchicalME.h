@@ -0,0 +1,112 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncHierarchicalME.h
+    \brief    coarse motion search on downsampled pictures (header)
+*/
+
+#ifndef __TENCHIERARCHICALME__
+#define __TENCHIERARCHICALME__
+
+#include <map>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComMv.h"
+#include "TLibCommon/TComRdCost.h"
+
+class TComPic;
+class TComPicYuv;
+class TComDataCU;
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+static const Int HME_NUM_LEVELS     = 2;  ///< luma downsampled by 2 and by 4
+static const Int HME_LOG2_BLOCK     = 4;  ///< log2 of the size of the full resolution blocks that get a vector
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Coarse motion search on the luma downsampled by 2 and by 4. The downsampled pictures are built once per picture
+/// from its original and kept while the picture may still be referenced. For each reference, a full search per CTU at
+/// the lowest resolution is refined per 16x16 block at both resolutions, giving one integer vector per 16x16 block
+/// that TEncSearch uses as an additional start point of the TZ search.
+class TEncHierarchicalME
+{
+private:
+  typedef struct
+  {
+    TComPicYuv* apcLevel[HME_NUM_LEVELS];            ///< [0]: downsampled by 2, [1]: downsampled by 4
+  } Pyramid;
+
+  TComRdCost*                           m_pcRdCost;
+  Int                                   m_iSearchRange;     ///< full search range of the CTUs at the lowest resolution
+  UInt                                  m_uiMaxCUWidth;
+  UInt                                  m_uiMaxCUHeight;
+
+  std::map<Int, Pyramid>                m_pyramids;         ///< downsampled pictures, keyed by POC
+  Int                                   m_iCurrPOC;
+  Int                                   m_iNumBlocksX;      ///< 16x16 blocks in a row of the current picture
+  Int                                   m_iNumBlocksY;
+  std::map<Int, std::vector<TComMv> >   m_vectors;          ///< vectors of the current picture, keyed by POC of the reference
+
+  Pyramid&    xGetPyramid       ( TComPic* pcPic );
+  Void        xBuildPyramid     ( const TComPicYuv* pcSrc, Pyramid& rcPyramid );
+  Void        xDestroyPyramid   ( Pyramid& rcPyramid );
+  Void        xSearch           ( const Pyramid& rcCurr, const Pyramid& rcRef, Int iBitDepth, std::vector<TComMv>& rcVectors );
+  Void        xSearchBlock      ( const TComPicYuv* pcCurr, const TComPicYuv* pcRef, Int iBitDepth, Int iPosX, Int iPosY, Int iWidth, Int iHeight,
+                                  const TComMv* pcCands, Int iNumCands, Int iRange, TComMv& rcBestMv );
+
+public:
+  TEncHierarchicalME();
+  virtual ~TEncHierarchicalME();
+
+  Void  init          ( TComRdCost* pcRdCost, Int iSearchRange, UInt uiMaxCUWidth, UInt uiMaxCUHeight );
+  Void  destroy       ();
+
+  /// builds the downsampled pictures of the picture about to be coded and releases those of pictures it no longer references
+  Void  initPicture   ( TComPic* pcPic );
+
+  /// integer vector of the 16x16 block at the centre of the partition, searching the reference when first asked for it
+  Bool  getMv         ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, RefPicList eRefPicList, Int iRefIdx, TComMv& rcMv );
+};
+
+//! \}
+
+#endif // __TENCHIERARCHICALME__
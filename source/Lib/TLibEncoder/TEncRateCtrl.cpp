@@ -61,6 +61,12 @@ TEncRCSeq::TEncRCSeq()
   m_GOPID2Level         = NULL;
   m_picPara             = NULL;
   m_LCUPara             = NULL;
+  m_numberOfTile        = 0;
+  m_LCUTileIdx          = NULL;
+  m_LCUCodingOrder      = NULL;
+  m_tileNumPixel        = NULL;
+  m_tileNumLCU          = NULL;
+  m_tilePara            = NULL;
   m_numberOfPixel       = 0;
   m_framesLeft          = 0;
   m_bitsLeft            = 0;
@@ -190,6 +196,25 @@ Void TEncRCSeq::destroy()
     delete[] m_LCUPara;
     m_LCUPara = NULL;
   }
+
+  if ( m_tilePara != NULL )
+  {
+    for ( Int i=0; i<m_numberOfLevel; i++ )
+    {
+      delete[] m_tilePara[i];
+    }
+    delete[] m_tilePara;
+    m_tilePara = NULL;
+  }
+  delete[] m_LCUTileIdx;
+  delete[] m_LCUCodingOrder;
+  delete[] m_tileNumPixel;
+  delete[] m_tileNumLCU;
+  m_LCUTileIdx     = NULL;
+  m_LCUCodingOrder = NULL;
+  m_tileNumPixel   = NULL;
+  m_tileNumLCU     = NULL;
+  m_numberOfTile   = 0;
 }
 
 Void TEncRCSeq::initBitsRatio( Int bitsRatio[])
@@ -266,6 +291,54 @@ Void TEncRCSeq::initLCUPara( TRCParameter** LCUPara )
   }
 }
 
+Void TEncRCSeq::initTiles( const vector<Int>& tileColumnWidth, const vector<Int>& tileRowHeight )
+{
+  assert( m_picPara != NULL && m_tilePara == NULL );
+
+  const Int numCols       = (Int)tileColumnWidth.size();
+  const Int numRows       = (Int)tileRowHeight.size();
+  const Int picWidthInLCU = ( m_picWidth % m_LCUWidth ) == 0 ? m_picWidth / m_LCUWidth : m_picWidth / m_LCUWidth + 1;
+
+  m_numberOfTile   = numCols * numRows;
+  m_LCUTileIdx     = new Int[m_numberOfLCU];
+  m_LCUCodingOrder = new Int[m_numberOfLCU];
+  m_tileNumPixel   = new Int[m_numberOfTile];
+  m_tileNumLCU     = new Int[m_numberOfTile];
+
+  // tiles are coded in raster order, and the LCUs of a tile in raster order within the tile
+  Int LCUCoded = 0;
+  for ( Int row=0, tileY=0; row<numRows; tileY+=tileRowHeight[row++] )
+  {
+    for ( Int col=0, tileX=0; col<numCols; tileX+=tileColumnWidth[col++] )
+    {
+      const Int tileIdx = row * numCols + col;
+      m_tileNumPixel[tileIdx] = 0;
+      m_tileNumLCU[tileIdx]   = tileColumnWidth[col] * tileRowHeight[row];
+      for ( Int y=tileY; y<tileY+tileRowHeight[row]; y++ )
+      {
+        for ( Int x=tileX; x<tileX+tileColumnWidth[col]; x++ )
+        {
+          const Int LCUIdx = y * picWidthInLCU + x;
+          m_LCUTileIdx[LCUIdx]         = tileIdx;
+          m_LCUCodingOrder[LCUCoded++] = LCUIdx;
+          m_tileNumPixel[tileIdx]     += min( m_LCUWidth, m_picWidth - x * m_LCUWidth ) * min( m_LCUHeight, m_picHeight - y * m_LCUHeight );
+        }
+      }
+    }
+  }
+  assert( LCUCoded == m_numberOfLCU );
+
+  m_tilePara = new TRCParameter*[m_numberOfLevel];
+  for ( Int i=0; i<m_numberOfLevel; i++ )
+  {
+    m_tilePara[i] = new TRCParameter[m_numberOfTile];
+    for ( Int j=0; j<m_numberOfTile; j++ )
+    {
+      m_tilePara[i][j] = m_picPara[i];
+    }
+  }
+}
+
 Void TEncRCSeq::updateAfterPic ( Int bits )
 {
   m_bitsLeft -= bits;
@@ -481,6 +554,7 @@ TEncRCPic::TEncRCPic()
   m_pixelsLeft    = 0;
 
   m_LCUs         = NULL;
+  m_tiles        = NULL;
   m_picActualHeaderBits = 0;
   m_picActualBits       = 0;
   m_picQP               = 0;
@@ -583,6 +657,12 @@ Int TEncRCPic::xEstPicLowerBound(TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP)
   return lowerBound;
 }
 
+Int TEncRCPic::getCurrLCUIdx()
+{
+  // without tile level rate control, the LCUs are assumed to be coded in raster order
+  return m_tiles != NULL ? m_encRCSeq->getLCUCodingOrder( getLCUCoded() ) : getLCUCoded();
+}
+
 Void TEncRCPic::addToPictureLsit( list<TEncRCPic*>& listPreviousPictures )
 {
   if ( listPreviousPictures.size() > g_RCMaxPicListSize )
@@ -647,6 +727,23 @@ Void TEncRCPic::create( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP, Int frameLevel
       m_LCUs[LCUIdx].m_numberOfPixel = currWidth * currHeight;
     }
   }
+
+  if ( encRCSeq->getNumberOfTile() > 0 )
+  {
+    // the picture budget is split in proportion to the tile area, so that every tile gets its share of the target bitrate
+    m_tiles = new TRCTile[encRCSeq->getNumberOfTile()];
+    for ( i=0; i<encRCSeq->getNumberOfTile(); i++ )
+    {
+      m_tiles[i].m_numberOfPixel      = encRCSeq->getTileNumPixel( i );
+      m_tiles[i].m_targetBits         = Int( (Double)m_bitsLeft * m_tiles[i].m_numberOfPixel / m_numberOfPixel + 0.5 );
+      m_tiles[i].m_bitsLeft           = m_tiles[i].m_targetBits;
+      m_tiles[i].m_LCULeft            = encRCSeq->getTileNumLCU( i );
+      m_tiles[i].m_actualBits         = 0;
+      m_tiles[i].m_estLambda          = m_estPicLambda;
+      m_tiles[i].m_totalCostIntra     = 0.0;
+      m_tiles[i].m_remainingCostIntra = 0.0;
+    }
+  }
   m_picActualHeaderBits = 0;
   m_picActualBits       = 0;
   m_picQP               = 0;
@@ -660,6 +757,11 @@ Void TEncRCPic::destroy()
     delete[] m_LCUs;
     m_LCUs = NULL;
   }
+  if( m_tiles != NULL )
+  {
+    delete[] m_tiles;
+    m_tiles = NULL;
+  }
   m_encRCSeq = NULL;
   m_encRCGOP = NULL;
 }
@@ -726,33 +828,76 @@ Double TEncRCPic::estimatePicLambda( list<TEncRCPic*>& listPreviousPictures, Sli
 
   m_estPicLambda = estLambda;
 
+  const Int numberOfTile = m_tiles != NULL ? m_encRCSeq->getNumberOfTile() : 0;
+  for ( Int t=0; t<numberOfTile; t++ )
+  {
+    Double alphaTile = m_encRCSeq->getTilePara( m_frameLevel, t ).m_alpha;
+    Double betaTile  = m_encRCSeq->getTilePara( m_frameLevel, t ).m_beta;
+    Double bppTile   = (Double)m_tiles[t].m_targetBits/(Double)m_tiles[t].m_numberOfPixel;
+    Double estLambdaTile;
+    if (eSliceType == I_SLICE)
+    {
+      estLambdaTile = calculateLambdaIntra(alphaTile, betaTile, pow(m_tiles[t].m_totalCostIntra/(Double)m_tiles[t].m_numberOfPixel, BETA1), bppTile);
+    }
+    else
+    {
+      estLambdaTile = alphaTile * pow( bppTile, betaTile );
+    }
+    // all tiles share the slice QP, so keep the tile lambdas around the picture lambda
+    m_tiles[t].m_estLambda = Clip3( estLambda * pow( 2.0, -3.0/3.0 ), estLambda * pow( 2.0, 3.0/3.0 ), estLambdaTile );
+  }
+
   Double totalWeight = 0.0;
+  vector<Double> tileWeight( numberOfTile, 0.0 );
   // initial BU bit allocation weight
   for ( Int i=0; i<m_numberOfLCU; i++ )
   {
     Double alphaLCU, betaLCU;
+    Double lambdaLCU = estLambda;
     if ( m_encRCSeq->getUseLCUSeparateModel() )
     {
       alphaLCU = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_alpha;
       betaLCU  = m_encRCSeq->getLCUPara( m_frameLevel, i ).m_beta;
     }
+    else if ( m_tiles != NULL )
+    {
+      alphaLCU = m_encRCSeq->getTilePara( m_frameLevel, m_encRCSeq->getLCUTileIdx( i ) ).m_alpha;
+      betaLCU  = m_encRCSeq->getTilePara( m_frameLevel, m_encRCSeq->getLCUTileIdx( i ) ).m_beta;
+    }
     else
     {
       alphaLCU = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
+    if ( m_tiles != NULL )
+    {
+      lambdaLCU = m_tiles[m_encRCSeq->getLCUTileIdx( i )].m_estLambda;
+    }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( lambdaLCU/alphaLCU, 1.0/betaLCU );
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
       m_LCUs[i].m_bitWeight = 0.01;
     }
     totalWeight += m_LCUs[i].m_bitWeight;
+    if ( m_tiles != NULL )
+    {
+      tileWeight[m_encRCSeq->getLCUTileIdx( i )] += m_LCUs[i].m_bitWeight;
+    }
   }
   for ( Int i=0; i<m_numberOfLCU; i++ )
   {
-    Double BUTargetBits = m_targetBits * m_LCUs[i].m_bitWeight / totalWeight;
+    Double BUTargetBits;
+    if ( m_tiles != NULL )
+    {
+      const Int tileIdx = m_encRCSeq->getLCUTileIdx( i );
+      BUTargetBits = m_tiles[tileIdx].m_targetBits * m_LCUs[i].m_bitWeight / tileWeight[tileIdx];
+    }
+    else
+    {
+      BUTargetBits = m_targetBits * m_LCUs[i].m_bitWeight / totalWeight;
+    }
     m_LCUs[i].m_bitWeight = BUTargetBits;
   }
 
@@ -799,36 +944,46 @@ Int TEncRCPic::estimatePicQP( Double lambda, list<TEncRCPic*>& listPreviousPictu
 
 Double TEncRCPic::getLCUTargetBpp(SliceType eSliceType)
 {
-  Int   LCUIdx    = getLCUCoded();
+  Int   LCUIdx    = getCurrLCUIdx();
   Double bpp      = -1.0;
   Int avgBits     = 0;
 
+  // with tile level rate control, the budget of the LCU's tile is distributed instead of the picture budget
+  TRCTile* tile               = m_tiles != NULL ? &m_tiles[m_encRCSeq->getLCUTileIdx( LCUIdx )] : NULL;
+  Int      bitsLeft           = tile != NULL ? tile->m_bitsLeft : m_bitsLeft;
+  Int      LCULeft            = tile != NULL ? tile->m_LCULeft  : m_LCULeft;
+  Double&  remainingCostIntra = tile != NULL ? tile->m_remainingCostIntra : m_remainingCostIntra;
+
   if (eSliceType == I_SLICE)
   {
-    Int noOfLCUsLeft = m_numberOfLCU - LCUIdx + 1;
+    Int noOfLCUsLeft = LCULeft + 1;
     Int bitrateWindow = min(4,noOfLCUsLeft);
     Double MAD      = getLCU(LCUIdx).m_costIntra;
 
-    if (m_remainingCostIntra > 0.1 )
+    if (remainingCostIntra > 0.1 )
     {
-      Double weightedBitsLeft = (m_bitsLeft*bitrateWindow+(m_bitsLeft-getLCU(LCUIdx).m_targetBitsLeft)*noOfLCUsLeft)/(Double)bitrateWindow;
-      avgBits = Int( MAD*weightedBitsLeft/m_remainingCostIntra );
+      Double weightedBitsLeft = (bitsLeft*bitrateWindow+(bitsLeft-getLCU(LCUIdx).m_targetBitsLeft)*noOfLCUsLeft)/(Double)bitrateWindow;
+      avgBits = Int( MAD*weightedBitsLeft/remainingCostIntra );
     }
     else
     {
-      avgBits = Int( m_bitsLeft / m_LCULeft );
+      avgBits = Int( bitsLeft / LCULeft );
     }
-    m_remainingCostIntra -= MAD;
+    remainingCostIntra -= MAD;
   }
   else
   {
     Double totalWeight = 0;
-    for ( Int i=LCUIdx; i<m_numberOfLCU; i++ )
+    for ( Int i=getLCUCoded(); i<m_numberOfLCU; i++ )
     {
-      totalWeight += m_LCUs[i].m_bitWeight;
+      const Int idx = m_tiles != NULL ? m_encRCSeq->getLCUCodingOrder( i ) : i;
+      if ( xIsSameRCUnit( idx, LCUIdx ) )
+      {
+        totalWeight += m_LCUs[idx].m_bitWeight;
+      }
     }
-    Int realInfluenceLCU = min( g_RCLCUSmoothWindowSize, getLCULeft() );
-    avgBits = (Int)( m_LCUs[LCUIdx].m_bitWeight - ( totalWeight - m_bitsLeft ) / realInfluenceLCU + 0.5 );
+    Int realInfluenceLCU = min( g_RCLCUSmoothWindowSize, LCULeft );
+    avgBits = (Int)( m_LCUs[LCUIdx].m_bitWeight - ( totalWeight - bitsLeft ) / realInfluenceLCU + 0.5 );
   }
 
   if ( avgBits < 1 )
@@ -844,7 +999,7 @@ Double TEncRCPic::getLCUTargetBpp(SliceType eSliceType)
 
 Double TEncRCPic::getLCUEstLambda( Double bpp )
 {
-  Int   LCUIdx = getLCUCoded();
+  Int   LCUIdx = getCurrLCUIdx();
   Double alpha;
   Double beta;
   if ( m_encRCSeq->getUseLCUSeparateModel() )
@@ -852,6 +1007,11 @@ Double TEncRCPic::getLCUEstLambda( Double bpp )
     alpha = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_alpha;
     beta  = m_encRCSeq->getLCUPara( m_frameLevel, LCUIdx ).m_beta;
   }
+  else if ( m_tiles != NULL )
+  {
+    alpha = m_encRCSeq->getTilePara( m_frameLevel, m_encRCSeq->getLCUTileIdx( LCUIdx ) ).m_alpha;
+    beta  = m_encRCSeq->getTilePara( m_frameLevel, m_encRCSeq->getLCUTileIdx( LCUIdx ) ).m_beta;
+  }
   else
   {
     alpha = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
@@ -859,14 +1019,14 @@ Double TEncRCPic::getLCUEstLambda( Double bpp )
   }
 
   Double estLambda = alpha * pow( bpp, beta );
-  //for Lambda clip, picture level clip
-  Double clipPicLambda = m_estPicLambda;
+  //for Lambda clip, picture level clip (tile level with tile level rate control)
+  Double clipPicLambda = m_tiles != NULL ? m_tiles[m_encRCSeq->getLCUTileIdx( LCUIdx )].m_estLambda : m_estPicLambda;
 
   //for Lambda clip, LCU level clip
   Double clipNeighbourLambda = -1.0;
   for ( Int i=LCUIdx - 1; i>=0; i-- )
   {
-    if ( m_LCUs[i].m_lambda > 0 )
+    if ( m_LCUs[i].m_lambda > 0 && xIsSameRCUnit( i, LCUIdx ) )
     {
       clipNeighbourLambda = m_LCUs[i].m_lambda;
       break;
@@ -897,14 +1057,14 @@ Double TEncRCPic::getLCUEstLambda( Double bpp )
 
 Int TEncRCPic::getLCUEstQP( Double lambda, Int clipPicQP )
 {
-  Int LCUIdx = getLCUCoded();
+  Int LCUIdx = getCurrLCUIdx();
   Int estQP = Int( 4.2005 * log( lambda ) + 13.7122 + 0.5 );
 
   //for Lambda clip, LCU level clip
   Int clipNeighbourQP = g_RCInvalidQPValue;
   for ( Int i=LCUIdx - 1; i>=0; i-- )
   {
-    if ( (getLCU(i)).m_QP > g_RCInvalidQPValue )
+    if ( (getLCU(i)).m_QP > g_RCInvalidQPValue && xIsSameRCUnit( i, LCUIdx ) )
     {
       clipNeighbourQP = getLCU(i).m_QP;
       break;
@@ -931,6 +1091,14 @@ Void TEncRCPic::updateAfterCTU( Int LCUIdx, Int bits, Int QP, Double lambda, Boo
   m_bitsLeft   -= bits;
   m_pixelsLeft -= m_LCUs[LCUIdx].m_numberOfPixel;
 
+  if ( m_tiles != NULL )
+  {
+    TRCTile& tile = m_tiles[m_encRCSeq->getLCUTileIdx( LCUIdx )];
+    tile.m_LCULeft--;
+    tile.m_bitsLeft   -= bits;
+    tile.m_actualBits += bits;
+  }
+
   if ( !updateLCUParameter )
   {
     return;
@@ -1051,6 +1219,14 @@ Void TEncRCPic::updateAfterPicture( Int actualHeaderBits, Int actualTotalBits, D
   }
   m_picLambda           = averageLambda;
 
+  if ( m_tiles != NULL )
+  {
+    for ( Int t=0; t<m_encRCSeq->getNumberOfTile(); t++ )
+    {
+      xUpdateTileAfterPicture( t, actualHeaderBits, eSliceType );
+    }
+  }
+
   Double alpha = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
   Double beta  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
 
@@ -1107,6 +1283,70 @@ Void TEncRCPic::updateAfterPicture( Int actualHeaderBits, Int actualTotalBits, D
   }
 }
 
+Void TEncRCPic::xUpdateTileAfterPicture( Int tileIdx, Int actualHeaderBits, SliceType eSliceType )
+{
+  TRCTile& tile = m_tiles[tileIdx];
+
+  // the header bits are shared in proportion to the tile area
+  tile.m_actualBits += Int( (Double)actualHeaderBits * tile.m_numberOfPixel / m_numberOfPixel + 0.5 );
+
+  Double totalLambdas = 0.0;
+  Int numTileLCUs = 0;
+  for ( Int i=0; i<m_numberOfLCU; i++ )
+  {
+    if ( m_encRCSeq->getLCUTileIdx( i ) == tileIdx && m_LCUs[i].m_lambda > 0.01 )
+    {
+      totalLambdas += log( m_LCUs[i].m_lambda );
+      numTileLCUs++;
+    }
+  }
+  Double inputLambda = numTileLCUs > 0 ? exp( totalLambdas / numTileLCUs ) : m_picLambda;
+
+  Double alpha = m_encRCSeq->getTilePara( m_frameLevel, tileIdx ).m_alpha;
+  Double beta  = m_encRCSeq->getTilePara( m_frameLevel, tileIdx ).m_beta;
+
+  if (eSliceType == I_SLICE)
+  {
+    if ( tile.m_totalCostIntra > 0.0 && tile.m_actualBits > 0 && tile.m_targetBits > 0 )
+    {
+      Double lnbpp = log(pow(tile.m_totalCostIntra / (Double)tile.m_numberOfPixel, BETA1));
+      Double diffLambda = beta*(log((Double)tile.m_actualBits)-log((Double)tile.m_targetBits));
+
+      diffLambda = Clip3(-0.125, 0.125, 0.25*diffLambda);
+      alpha    =  alpha * exp(diffLambda);
+      beta     =  beta + diffLambda / lnbpp;
+    }
+  }
+  else
+  {
+    Double tileActualBpp = (Double)tile.m_actualBits/(Double)tile.m_numberOfPixel;
+    Double calLambda     = alpha * pow( tileActualBpp, beta );
+
+    if ( inputLambda < 0.01 || calLambda < 0.01 || tileActualBpp < 0.0001 )
+    {
+      alpha *= ( 1.0 - m_encRCSeq->getAlphaUpdate() / 2.0 );
+      beta  *= ( 1.0 - m_encRCSeq->getBetaUpdate() / 2.0 );
+    }
+    else
+    {
+      calLambda = Clip3( inputLambda / 10.0, inputLambda * 10.0, calLambda );
+      alpha += m_encRCSeq->getAlphaUpdate() * ( log( inputLambda ) - log( calLambda ) ) * alpha;
+      Double lnbpp = log( tileActualBpp );
+      lnbpp = Clip3( -5.0, -0.1, lnbpp );
+
+      beta  += m_encRCSeq->getBetaUpdate() * ( log( inputLambda ) - log( calLambda ) ) * lnbpp;
+    }
+
+    alpha = Clip3( g_RCAlphaMinValue, g_RCAlphaMaxValue, alpha );
+    beta  = Clip3( g_RCBetaMinValue,  g_RCBetaMaxValue,  beta  );
+  }
+
+  TRCParameter rcPara;
+  rcPara.m_alpha = alpha;
+  rcPara.m_beta  = beta;
+  m_encRCSeq->setTilePara( m_frameLevel, tileIdx, rcPara );
+}
+
 Int TEncRCPic::getRefineBitsForIntra( Int orgBits )
 {
   Double alpha=0.25, beta=0.5582;
@@ -1147,6 +1387,11 @@ Void TEncRCPic::getLCUInitTargetBits()
   Int iAvgBits     = 0;
 
   m_remainingCostIntra = m_totalCostIntra;
+  if ( m_tiles != NULL )
+  {
+    xGetTileLCUInitTargetBits();
+    return;
+  }
   for (Int i=m_numberOfLCU-1; i>=0; i--)
   {
     iAvgBits += Int(m_targetBits * getLCU(i).m_costIntra/m_totalCostIntra);
@@ -1154,13 +1399,42 @@ Void TEncRCPic::getLCUInitTargetBits()
   }
 }
 
+Void TEncRCPic::xGetTileLCUInitTargetBits()
+{
+  const Int numberOfTile = m_encRCSeq->getNumberOfTile();
+  for (Int t=0; t<numberOfTile; t++)
+  {
+    m_tiles[t].m_totalCostIntra = 0.0;
+  }
+  for (Int i=0; i<m_numberOfLCU; i++)
+  {
+    m_tiles[m_encRCSeq->getLCUTileIdx(i)].m_totalCostIntra += getLCU(i).m_costIntra;
+  }
+
+  vector<Int> tileAvgBits( numberOfTile, 0 );
+  for (Int i=m_numberOfLCU-1; i>=0; i--)
+  {
+    const Int LCUIdx  = m_encRCSeq->getLCUCodingOrder(i);
+    const Int tileIdx = m_encRCSeq->getLCUTileIdx(LCUIdx);
+    if (m_tiles[tileIdx].m_totalCostIntra > 0.0)
+    {
+      tileAvgBits[tileIdx] += Int(m_tiles[tileIdx].m_targetBits * getLCU(LCUIdx).m_costIntra/m_tiles[tileIdx].m_totalCostIntra);
+    }
+    getLCU(LCUIdx).m_targetBitsLeft = tileAvgBits[tileIdx];
+  }
+  for (Int t=0; t<numberOfTile; t++)
+  {
+    m_tiles[t].m_remainingCostIntra = m_tiles[t].m_totalCostIntra;
+  }
+}
 
 Double TEncRCPic::getLCUEstLambdaAndQP(Double bpp, Int clipPicQP, Int *estQP)
 {
-  Int   LCUIdx = getLCUCoded();
+  Int   LCUIdx = getCurrLCUIdx();
 
-  Double   alpha = m_encRCSeq->getPicPara( m_frameLevel ).m_alpha;
-  Double   beta  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
+  TRCParameter rcPara = m_tiles != NULL ? m_encRCSeq->getTilePara( m_frameLevel, m_encRCSeq->getLCUTileIdx( LCUIdx ) ) : m_encRCSeq->getPicPara( m_frameLevel );
+  Double   alpha = rcPara.m_alpha;
+  Double   beta  = rcPara.m_beta;
 
   Double costPerPixel = getLCU(LCUIdx).m_costIntra/(Double)getLCU(LCUIdx).m_numberOfPixel;
   costPerPixel = pow(costPerPixel, BETA1);
@@ -1169,7 +1443,7 @@ Double TEncRCPic::getLCUEstLambdaAndQP(Double bpp, Int clipPicQP, Int *estQP)
   Int clipNeighbourQP = g_RCInvalidQPValue;
   for (Int i=LCUIdx-1; i>=0; i--)
   {
-    if ((getLCU(i)).m_QP > g_RCInvalidQPValue)
+    if ((getLCU(i)).m_QP > g_RCInvalidQPValue && xIsSameRCUnit(i, LCUIdx))
     {
       clipNeighbourQP = getLCU(i).m_QP;
       break;
@@ -1466,6 +1740,110 @@ Void TEncRateCtrl::initHrdParam(const TComHRD* pcHrd, Int iFrameRate, Double fIn
   printf("\nHRD - [Initial CPB state %6d] [CPB Size %6d] [Buffering Rate %6d]\n", m_cpbState, m_cpbSize, m_bufferingRate);
 }
 
+Void TEncRateCtrl::initTileRC( const TComPPS& pps )
+{
+  TEncRCSeq* encRCSeq = getRCSeq();
+  const Int picWidthInLCU  = ( encRCSeq->getPicWidth()  + encRCSeq->getLCUWidth()  - 1 ) / encRCSeq->getLCUWidth();
+  const Int picHeightInLCU = ( encRCSeq->getPicHeight() + encRCSeq->getLCUHeight() - 1 ) / encRCSeq->getLCUHeight();
+  const Int numCols = pps.getNumTileColumnsMinus1() + 1;
+  const Int numRows = pps.getNumTileRowsMinus1() + 1;
+
+  // same tile partitioning as TComPicSym::xInitTiles
+  vector<Int> tileColumnWidth( numCols );
+  vector<Int> tileRowHeight( numRows );
+  if ( pps.getTileUniformSpacingFlag() )
+  {
+    for ( Int col=0; col<numCols; col++ )
+    {
+      tileColumnWidth[col] = (col+1)*picWidthInLCU/numCols - (col*picWidthInLCU)/numCols;
+    }
+    for ( Int row=0; row<numRows; row++ )
+    {
+      tileRowHeight[row] = (row+1)*picHeightInLCU/numRows - (row*picHeightInLCU)/numRows;
+    }
+  }
+  else
+  {
+    Int cumulativeTileWidth = 0;
+    for ( Int col=0; col<numCols-1; col++ )
+    {
+      tileColumnWidth[col] = pps.getTileColumnWidth( col );
+      cumulativeTileWidth += tileColumnWidth[col];
+    }
+    tileColumnWidth[numCols-1] = picWidthInLCU - cumulativeTileWidth;
+
+    Int cumulativeTileHeight = 0;
+    for ( Int row=0; row<numRows-1; row++ )
+    {
+      tileRowHeight[row] = pps.getTileRowHeight( row );
+      cumulativeTileHeight += tileRowHeight[row];
+    }
+    tileRowHeight[numRows-1] = picHeightInLCU - cumulativeTileHeight;
+  }
+
+  encRCSeq->initTiles( tileColumnWidth, tileRowHeight );
+
+  // each tile has its own CPB, with the size and buffering rate of its share of the picture
+  const Int numberOfTile = encRCSeq->getNumberOfTile();
+  m_tileCpbState.resize( numberOfTile );
+  m_tileCpbSize.resize( numberOfTile );
+  m_tileBufferingRate.resize( numberOfTile );
+  for ( Int t=0; t<numberOfTile; t++ )
+  {
+    const Double tileShare = (Double)encRCSeq->getTileNumPixel( t ) / (Double)encRCSeq->getNumPixel();
+    m_tileCpbState[t]      = (Int)( m_cpbState * tileShare );
+    m_tileCpbSize[t]       = (UInt)( m_cpbSize * tileShare );
+    m_tileBufferingRate[t] = (UInt)( m_bufferingRate * tileShare );
+  }
+}
+
+Void TEncRateCtrl::initRCTileTargetBits()
+{
+  TEncRCSeq* encRCSeq = getRCSeq();
+  TEncRCPic* encRCPic = getRCPic();
+  const Int picBits   = encRCPic->getTargetBits() - encRCPic->getEstHeaderBits();
+
+  for ( Int t=0; t<encRCSeq->getNumberOfTile(); t++ )
+  {
+    const Double tileShare = (Double)encRCSeq->getTileNumPixel( t ) / (Double)encRCSeq->getNumPixel();
+    Int bits = (Int)( picBits * tileShare + 0.5 );
+
+    if ( m_CpbSaturationEnabled )
+    {
+      Int estimatedCpbFullness = m_tileCpbState[t] + m_tileBufferingRate[t];
+
+      // prevent overflow
+      if (estimatedCpbFullness - bits > (Int)(m_tileCpbSize[t]*0.9f))
+      {
+        bits = estimatedCpbFullness - (Int)(m_tileCpbSize[t]*0.9f);
+      }
+
+      estimatedCpbFullness -= m_tileBufferingRate[t];
+      // prevent underflow
+      const Int lowerBound = (Int)( encRCPic->getLowerBound() * tileShare );
+      if (estimatedCpbFullness - bits < lowerBound)
+      {
+        bits = estimatedCpbFullness - lowerBound;
+      }
+    }
+
+    if ( bits < 100 )
+    {
+      bits = 100;   // at least allocate 100 bits for one tile
+    }
+    encRCPic->setTileTargetBits( t, bits );
+  }
+}
+
+Void TEncRateCtrl::updateTileCpbState()
+{
+  for ( Int t=0; t<getRCSeq()->getNumberOfTile(); t++ )
+  {
+    m_tileCpbState[t] -= getRCPic()->getTile( t ).m_actualBits;
+    m_tileCpbState[t] += m_tileBufferingRate[t];
+  }
+}
+
 Void TEncRateCtrl::destroyRCGOP()
 {
   delete m_encRCGOP;
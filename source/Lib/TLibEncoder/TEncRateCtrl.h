@@ -88,6 +88,18 @@ struct TRCLCU
   Int m_targetBitsLeft;
 };
 
+struct TRCTile
+{
+  Int m_targetBits;
+  Int m_bitsLeft;
+  Int m_LCULeft;
+  Int m_numberOfPixel;
+  Int m_actualBits;     // CTU bits while coding, plus the share of the header bits after the picture
+  Double m_estLambda;
+  Double m_totalCostIntra;
+  Double m_remainingCostIntra;
+};
+
 struct TRCParameter
 {
   Double m_alpha;
@@ -107,6 +119,7 @@ public:
   Void initGOPID2Level( Int GOPID2Level[] );
   Void initPicPara( TRCParameter* picPara  = NULL );    // NULL to initial with default value
   Void initLCUPara( TRCParameter** LCUPara = NULL );    // NULL to initial with default value
+  Void initTiles( const vector<Int>& tileColumnWidth, const vector<Int>& tileRowHeight );   // in LCUs
   Void updateAfterPic ( Int bits );
   Void setAllBitRatio( Double basicLambda, Double* equaCoeffA, Double* equaCoeffB );
 
@@ -139,6 +152,14 @@ public:
   TRCParameter   getLCUPara( Int level, Int LCUIdx )            { assert( LCUIdx  < m_numberOfLCU ); return getLCUPara(level)[LCUIdx]; }
   Void           setLCUPara( Int level, Int LCUIdx, TRCParameter para ) { assert( level < m_numberOfLevel ); assert( LCUIdx  < m_numberOfLCU ); m_LCUPara[level][LCUIdx] = para; }
 
+  Int  getNumberOfTile()                { return m_numberOfTile; }
+  Int  getLCUTileIdx( Int LCUIdx )      { assert( LCUIdx < m_numberOfLCU ); return m_LCUTileIdx[LCUIdx]; }
+  Int  getLCUCodingOrder( Int LCUCoded ) { assert( LCUCoded < m_numberOfLCU ); return m_LCUCodingOrder[LCUCoded]; }
+  Int  getTileNumPixel( Int tileIdx )   { assert( tileIdx < m_numberOfTile ); return m_tileNumPixel[tileIdx]; }
+  Int  getTileNumLCU( Int tileIdx )     { assert( tileIdx < m_numberOfTile ); return m_tileNumLCU[tileIdx]; }
+  TRCParameter   getTilePara( Int level, Int tileIdx )          { assert( level < m_numberOfLevel ); assert( tileIdx < m_numberOfTile ); return m_tilePara[level][tileIdx]; }
+  Void           setTilePara( Int level, Int tileIdx, TRCParameter para ) { assert( level < m_numberOfLevel ); assert( tileIdx < m_numberOfTile ); m_tilePara[level][tileIdx] = para; }
+
   Int  getFramesLeft()                  { return m_framesLeft; }
   Int64  getBitsLeft()                  { return m_bitsLeft; }
 
@@ -170,6 +191,13 @@ private:
   TRCParameter*  m_picPara;
   TRCParameter** m_LCUPara;
 
+  Int  m_numberOfTile;                  // 0: no tile level rate control
+  Int* m_LCUTileIdx;                    // tile of each LCU, in raster order
+  Int* m_LCUCodingOrder;                // raster address of the n-th coded LCU
+  Int* m_tileNumPixel;
+  Int* m_tileNumLCU;
+  TRCParameter** m_tilePara;
+
   Int m_framesLeft;
   Int64 m_bitsLeft;
   Double m_seqTargetBpp;
@@ -240,6 +268,7 @@ public:
   Void updateAfterPicture( Int actualHeaderBits, Int actualTotalBits, Double averageQP, Double averageLambda, SliceType eSliceType);
 
   Void addToPictureLsit( list<TEncRCPic*>& listPreviousPictures );
+  Int  getCurrLCUIdx();
   Double calAverageQP();
   Double calAverageLambda();
 
@@ -247,6 +276,9 @@ private:
   Int xEstPicTargetBits( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP );
   Int xEstPicHeaderBits( list<TEncRCPic*>& listPreviousPictures, Int frameLevel );
   Int xEstPicLowerBound( TEncRCSeq* encRCSeq, TEncRCGOP* encRCGOP );
+  Bool xIsSameRCUnit( Int LCUIdx0, Int LCUIdx1 )          { return m_tiles == NULL || m_encRCSeq->getLCUTileIdx( LCUIdx0 ) == m_encRCSeq->getLCUTileIdx( LCUIdx1 ); }
+  Void xUpdateTileAfterPicture( Int tileIdx, Int actualHeaderBits, SliceType eSliceType );
+  Void xGetTileLCUInitTargetBits();
 
 public:
   TEncRCSeq*      getRCSequence()                         { return m_encRCSeq; }
@@ -265,6 +297,8 @@ public:
   Int  getLowerBound()                                    { return m_lowerBound; }
   TRCLCU* getLCU()                                        { return m_LCUs; }
   TRCLCU& getLCU( Int LCUIdx )                            { return m_LCUs[LCUIdx]; }
+  TRCTile& getTile( Int tileIdx )                         { assert( m_tiles != NULL ); return m_tiles[tileIdx]; }
+  Void setTileTargetBits( Int tileIdx, Int bits )         { getTile( tileIdx ).m_targetBits = bits; getTile( tileIdx ).m_bitsLeft = bits; }
   Int  getPicActualHeaderBits()                           { return m_picActualHeaderBits; }
   Void setBitLeft(Int bits)                               { m_bitsLeft = bits; }
   Void setTargetBits( Int bits )                          { m_targetBits = bits; m_bitsLeft = bits;}
@@ -297,6 +331,7 @@ private:
   Int m_pixelsLeft;
 
   TRCLCU* m_LCUs;
+  TRCTile* m_tiles;             // NULL without tile level rate control
   Int m_picActualHeaderBits;    // only SH and potential APS
   Double m_totalCostIntra;
   Double m_remainingCostIntra;
@@ -317,6 +352,8 @@ public:
   Void initRCPic( Int frameLevel );
   Void initRCGOP( Int numberOfPictures );
   Void destroyRCGOP();
+  Void initTileRC( const TComPPS& pps );
+  Void initRCTileTargetBits();
 
 public:
   Void       setRCQP ( Int QP ) { m_RCQP = QP;   }
@@ -331,6 +368,8 @@ public:
   UInt       getBufferingRate()         { return m_bufferingRate;  }
   Int        updateCpbState(Int actualBits);
   Void       initHrdParam(const TComHRD* pcHrd, Int iFrameRate, Double fInitialCpbFullness);
+  Int        getTileCpbState( Int tileIdx ) { return m_tileCpbState[tileIdx]; }
+  Void       updateTileCpbState();
 
 private:
   TEncRCSeq* m_encRCSeq;
@@ -342,6 +381,9 @@ private:
   Int        m_cpbState;                // CPB State 
   UInt       m_cpbSize;                 // CPB size
   UInt       m_bufferingRate;           // Buffering rate
+  vector<Int>  m_tileCpbState;          // CPB state of each tile, the CPB size and buffering rate are split by tile area
+  vector<UInt> m_tileCpbSize;
+  vector<UInt> m_tileBufferingRate;
 };
 
 #endif
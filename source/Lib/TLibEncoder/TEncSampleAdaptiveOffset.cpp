@@ -41,6 +41,11 @@
 #include <stdio.h>
 #include <math.h>
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TLibCommon/TComCPUFeatures.h"
+#endif
+
 //! \ingroup TLibEncoder
 //! \{
 
@@ -908,6 +913,140 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
 }
 
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// lane masks for the last, partial group of 16 samples of a row: loading at s_statsTailMask + 16 - n enables n lanes
+static const Short s_statsTailMask[32] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 };
+
+/** accumulates the edge offset statistics of the samples [startX, endX) of one line. srcA and srcB point to the two
+ *  neighbours of srcLine[0] in the direction of the edge offset class. The sums are kept per class in 32-bit lanes.
+ */
+SIMD_TARGET_AVX2 static Void simdSaoEdgeStatsLineAVX2( const Pel* srcLine, const Pel* srcA, const Pel* srcB, const Pel* orgLine, Int startX, Int endX,
+                                                       __m256i* mmDiff, __m256i* mmCount )
+{
+  const __m256i mmOne = _mm256_set1_epi16( 1 );
+  for( Int x = startX; x < endX; x += 16 )
+  {
+    const __m256i mmCur = _mm256_loadu_si256( ( const __m256i* )( srcLine + x ) );
+    const __m256i mmA   = _mm256_loadu_si256( ( const __m256i* )( srcA + x ) );
+    const __m256i mmB   = _mm256_loadu_si256( ( const __m256i* )( srcB + x ) );
+    __m256i       mmEdge = _mm256_add_epi16( _mm256_sub_epi16( _mm256_cmpgt_epi16( mmA, mmCur ), _mm256_cmpgt_epi16( mmCur, mmA ) ),
+                                             _mm256_sub_epi16( _mm256_cmpgt_epi16( mmB, mmCur ), _mm256_cmpgt_epi16( mmCur, mmB ) ) );
+    const __m256i mmD   = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )( orgLine + x ) ), mmCur );
+    if( endX - x < 16 )
+    {
+      // samples outside the line are moved to a class that is not counted
+      const __m256i mmValid = _mm256_loadu_si256( ( const __m256i* )( s_statsTailMask + 16 - ( endX - x ) ) );
+      mmEdge = _mm256_blendv_epi8( _mm256_set1_epi16( 3 ), mmEdge, mmValid );
+    }
+    for( Int edgeType = 0; edgeType < NUM_SAO_EO_CLASSES; edgeType++ )
+    {
+      const __m256i mmMask = _mm256_cmpeq_epi16( mmEdge, _mm256_set1_epi16( edgeType - 2 ) );
+      mmDiff [edgeType] = _mm256_add_epi32( mmDiff [edgeType], _mm256_madd_epi16( _mm256_and_si256( mmMask, mmD ), mmOne ) );
+      mmCount[edgeType] = _mm256_sub_epi32( mmCount[edgeType], _mm256_madd_epi16( mmMask, mmOne ) );
+    }
+  }
+}
+
+/** AVX2 version of the edge offset part of TEncSampleAdaptiveOffset::getBlkStats for bit depths up to 10, for one
+ *  edge offset type. The sample ranges are the same as in the C code; the classification is computed directly from
+ *  the neighbouring samples rather than from the sign line buffers.
+ */
+SIMD_TARGET_AVX2 static Void simdGetEdgeStatsAVX2( Int typeIdx, Int64* diff, Int64* count
+                                                 , const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
+                                                 , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
+                                                 , Bool isCalculatePreDeblockSamples, Int skipLinesR, Int skipLinesB )
+{
+  __m256i mmDiff[NUM_SAO_EO_CLASSES], mmCount[NUM_SAO_EO_CLASSES];
+  for( Int edgeType = 0; edgeType < NUM_SAO_EO_CLASSES; edgeType++ )
+  {
+    mmDiff [edgeType] = _mm256_setzero_si256();
+    mmCount[edgeType] = _mm256_setzero_si256();
+  }
+
+  // offset of the first neighbour of a sample; the second one is at the opposite position
+  Int neighbourOffset = 0;
+  switch( typeIdx )
+  {
+    case SAO_TYPE_EO_0:   neighbourOffset = -1;              break;
+    case SAO_TYPE_EO_90:  neighbourOffset = -srcStride;      break;
+    case SAO_TYPE_EO_135: neighbourOffset = -srcStride - 1;  break;
+    case SAO_TYPE_EO_45:  neighbourOffset = -srcStride + 1;  break;
+    default:
+      assert(0); exit(-1); break;
+  }
+
+  Int startY, endY;
+  Int startX, endX, firstLineStartX, firstLineEndX;
+  if( typeIdx == SAO_TYPE_EO_90 )
+  {
+    startX = ( !isCalculatePreDeblockSamples ) ? 0 : ( isRightAvail ? ( width - skipLinesR ) : width );
+    endX   = ( !isCalculatePreDeblockSamples ) ? ( isRightAvail ? ( width - skipLinesR ) : width ) : width;
+    startY = isAboveAvail ? 0 : 1;
+    endY   = isBelowAvail ? ( height - skipLinesB ) : ( height - 1 );
+    firstLineStartX = startX;
+    firstLineEndX   = endX;
+  }
+  else
+  {
+    startX = ( !isCalculatePreDeblockSamples ) ? ( isLeftAvail  ? 0 : 1 ) : ( isRightAvail ? ( width - skipLinesR ) : ( width - 1 ) );
+    endX   = ( !isCalculatePreDeblockSamples ) ? ( isRightAvail ? ( width - skipLinesR ) : ( width - 1 ) ) : ( isRightAvail ? width : ( width - 1 ) );
+    startY = 0;
+    if( typeIdx == SAO_TYPE_EO_0 )
+    {
+      endY            = isBelowAvail ? ( height - skipLinesB ) : height;
+      firstLineStartX = startX;
+      firstLineEndX   = endX;
+    }
+    else if( typeIdx == SAO_TYPE_EO_135 )
+    {
+      endY            = isBelowAvail ? ( height - skipLinesB ) : ( height - 1 );
+      firstLineStartX = ( !isCalculatePreDeblockSamples ) ? ( isAboveLeftAvail ? 0    : 1 ) : startX;
+      firstLineEndX   = ( !isCalculatePreDeblockSamples ) ? ( isAboveAvail     ? endX : 1 ) : endX;
+    }
+    else
+    {
+      endY            = isBelowAvail ? ( height - skipLinesB ) : ( height - 1 );
+      firstLineStartX = ( !isCalculatePreDeblockSamples ) ? ( isAboveAvail ? startX : endX ) : startX;
+      firstLineEndX   = ( !isCalculatePreDeblockSamples ) ? ( ( !isRightAvail && isAboveRightAvail ) ? width : endX ) : endX;
+    }
+  }
+
+  // the diagonal classes always visit their first line, like the C code
+  const Int lastY = ( typeIdx == SAO_TYPE_EO_135 || typeIdx == SAO_TYPE_EO_45 ) ? std::max( endY, 1 ) : std::max( endY, startY );
+  for( Int y = startY; y < lastY; y++ )
+  {
+    const Pel* srcLine = srcBlk + y * srcStride;
+    simdSaoEdgeStatsLineAVX2( srcLine, srcLine + neighbourOffset, srcLine - neighbourOffset, orgBlk + y * orgStride,
+                              ( y == startY ) ? firstLineStartX : startX, ( y == startY ) ? firstLineEndX : endX, mmDiff, mmCount );
+  }
+
+  // lines below the deblocked area
+  if( isCalculatePreDeblockSamples && isBelowAvail )
+  {
+    startX = ( typeIdx == SAO_TYPE_EO_90 ) ? 0     : ( isLeftAvail  ? 0 : 1 );
+    endX   = ( typeIdx == SAO_TYPE_EO_90 ) ? width : ( isRightAvail ? width : ( width - 1 ) );
+    for( Int y = lastY; y < lastY + skipLinesB; y++ )
+    {
+      const Pel* srcLine = srcBlk + y * srcStride;
+      simdSaoEdgeStatsLineAVX2( srcLine, srcLine + neighbourOffset, srcLine - neighbourOffset, orgBlk + y * orgStride, startX, endX, mmDiff, mmCount );
+    }
+  }
+
+  for( Int edgeType = 0; edgeType < NUM_SAO_EO_CLASSES; edgeType++ )
+  {
+    Int partialDiff[8], partialCount[8];
+    _mm256_storeu_si256( ( __m256i* )partialDiff,  mmDiff [edgeType] );
+    _mm256_storeu_si256( ( __m256i* )partialCount, mmCount[edgeType] );
+    for( Int i = 0; i < 8; i++ )
+    {
+      diff [edgeType - 2] += partialDiff[i];
+      count[edgeType - 2] += partialCount[i];
+    }
+  }
+}
+#endif
+
 Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes
                         , Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
                         , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
@@ -945,6 +1084,16 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
     SAOStatData& statsData= statsDataTypes[typeIdx];
     statsData.reset();
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (typeIdx != SAO_TYPE_BO && channelBitDepth <= 10 && getSIMDLevel() >= SIMD_AVX2)
+    {
+      simdGetEdgeStatsAVX2(typeIdx, statsData.diff + 2, statsData.count + 2, srcBlk, orgBlk, srcStride, orgStride, width, height
+                         , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                         , isCalculatePreDeblockSamples, skipLinesR[typeIdx], skipLinesB[typeIdx]);
+      continue;
+    }
+#endif
+
     srcLine = srcBlk;
     orgLine = orgBlk;
     diff    = statsData.diff;
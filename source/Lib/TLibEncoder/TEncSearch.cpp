@@ -39,6 +39,7 @@
 #include "TLibCommon/TComRom.h"
 #include "TLibCommon/TComMotionInfo.h"
 #include "TEncSearch.h"
+#include "TEncAnalysisData.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/Debug.h"
 #include <math.h>
@@ -107,6 +108,9 @@ static Void offsetSubTUCBFs(TComTU &rTu, const ComponentID compID)
 TEncSearch::TEncSearch()
 : m_puhQTTempTrIdx(NULL)
 , m_pcQTTempTComYuv(NULL)
+, m_intraRefCachePartIdx (-1)
+, m_intraRefCacheWidth (0)
+, m_intraRefCacheHeight (0)
 , m_pcEncCfg (NULL)
 , m_pcTrQuant (NULL)
 , m_pcRdCost (NULL)
@@ -117,7 +121,9 @@ TEncSearch::TEncSearch()
 , m_pppcRDSbacCoder (NULL)
 , m_pcRDGoOnSbacCoder (NULL)
 , m_pTempPel (NULL)
+, m_piRefLuma8 (NULL)
 , m_isInitialized (false)
+, m_uiNumTZCandidates (0)
 {
   for (UInt ch=0; ch<MAX_NUM_COMPONENT; ch++)
   {
@@ -199,6 +205,7 @@ Void TEncSearch::destroy()
   m_pcQTTempTransformSkipTComYuv.destroy();
 
   m_tmpYuvPred.destroy();
+  m_cHierarchicalME.destroy();
   m_isInitialized = false;
 }
 
@@ -304,6 +311,7 @@ Void TEncSearch::init(TEncCfg*       pcEncCfg,
   }
   m_pcQTTempTransformSkipTComYuv.create( maxCUWidth, maxCUHeight, pcEncCfg->getChromaFormatIdc() );
   m_tmpYuvPred.create(MAX_CU_SIZE, MAX_CU_SIZE, pcEncCfg->getChromaFormatIdc());
+  m_cHierarchicalME.init( pcRdCost, pcEncCfg->getHierarchicalMERange(), maxCUWidth, maxCUHeight );
   m_isInitialized = true;
 }
 
@@ -396,7 +404,15 @@ __inline Void TEncSearch::xTZSearchHelp( const TComPattern* const pcPatternKey,
       }
     }
 
-    uiSad = m_cDistParam.DistFunc( &m_cDistParam );
+    if ( rcStruct.piRefY8 != NULL )
+    {
+      const UChar* const piRefSrch8 = rcStruct.piRefY8 + iSearchY * rcStruct.iYStride + iSearchX;
+      TComRdCost::getSADs8( m_cDistParam, m_aucOrgLuma8, pcPatternKey->getROIYWidth(), &piRefSrch8, rcStruct.iYStride, 1, &uiSad );
+    }
+    else
+    {
+      uiSad = m_cDistParam.DistFunc( &m_cDistParam );
+    }
 
     // only add motion cost if uiSad is smaller than best. Otherwise pointless
     // to add motion cost.
@@ -419,6 +435,101 @@ __inline Void TEncSearch::xTZSearchHelp( const TComPattern* const pcPatternKey,
   }
 }
 
+/** queue a TZ search point for xTZSearchEvaluateCandidates, which gives the same result as passing it to xTZSearchHelp.
+ *  The selective search, whose SAD computation depends on the best cost so far, evaluates the point straight away.
+ */
+__inline Void TEncSearch::xTZSearchAddCandidate( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance )
+{
+  if((m_pcEncCfg->getRestrictMESampling() == false) && m_pcEncCfg->getMotionEstimationSearchMethod() == MESEARCH_SELECTIVE)
+  {
+    xTZSearchHelp( pcPatternKey, rcStruct, iSearchX, iSearchY, ucPointNr, uiDistance );
+    return;
+  }
+
+  TZSearchCandidate& rcCand = m_acTZCandidates[m_uiNumTZCandidates++];
+  rcCand.iSearchX   = iSearchX;
+  rcCand.iSearchY   = iSearchY;
+  rcCand.ucPointNr  = ucPointNr;
+  rcCand.uiDistance = uiDistance;
+
+  if (m_uiNumTZCandidates == TZ_MAX_NUM_CANDIDATES)
+  {
+    xTZSearchEvaluateCandidates( pcPatternKey, rcStruct );
+  }
+}
+
+/** compute the SADs of all queued TZ search points in one pass over the original block, then add the motion cost and
+ *  update the best point for each of them in the order they were queued, as xTZSearchHelp does.
+ */
+Void TEncSearch::xTZSearchEvaluateCandidates( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct )
+{
+  if (m_uiNumTZCandidates == 0)
+  {
+    return;
+  }
+
+  const Pel* apiRefSrch[TZ_MAX_NUM_CANDIDATES];
+  Distortion auiSad    [TZ_MAX_NUM_CANDIDATES];
+
+  m_pcRdCost->setDistParam( pcPatternKey, rcStruct.piRefY, rcStruct.iYStride, m_cDistParam );
+  setDistParamComp(COMPONENT_Y);
+  m_cDistParam.bitDepth = pcPatternKey->getBitDepthY();
+
+  // fast encoder decision: use subsampled SAD when rows > 8 for integer ME
+  if ( m_pcEncCfg->getFastInterSearchMode()==FASTINTERSEARCH_MODE1 || m_pcEncCfg->getFastInterSearchMode()==FASTINTERSEARCH_MODE3 )
+  {
+    if ( m_cDistParam.iRows > 8 )
+    {
+      m_cDistParam.iSubShift = 1;
+    }
+  }
+
+  for (UInt i = 0; i < m_uiNumTZCandidates; i++)
+  {
+    apiRefSrch[i] = rcStruct.piRefY + m_acTZCandidates[i].iSearchY * rcStruct.iYStride + m_acTZCandidates[i].iSearchX;
+  }
+  if ( rcStruct.piRefY8 != NULL )
+  {
+    const UChar* apiRefSrch8[TZ_MAX_NUM_CANDIDATES];
+    for (UInt i = 0; i < m_uiNumTZCandidates; i++)
+    {
+      apiRefSrch8[i] = rcStruct.piRefY8 + m_acTZCandidates[i].iSearchY * rcStruct.iYStride + m_acTZCandidates[i].iSearchX;
+    }
+    TComRdCost::getSADs8( m_cDistParam, m_aucOrgLuma8, pcPatternKey->getROIYWidth(), apiRefSrch8, rcStruct.iYStride, m_uiNumTZCandidates, auiSad );
+  }
+  else
+  {
+    TComRdCost::getSADs( m_cDistParam, apiRefSrch, m_uiNumTZCandidates, auiSad );
+  }
+
+  for (UInt i = 0; i < m_uiNumTZCandidates; i++)
+  {
+    const TZSearchCandidate& rcCand = m_acTZCandidates[i];
+    Distortion uiSad = auiSad[i];
+
+    // only add motion cost if uiSad is smaller than best. Otherwise pointless
+    // to add motion cost.
+    if( uiSad < rcStruct.uiBestSad )
+    {
+      // motion cost
+      uiSad += m_pcRdCost->getCostOfVectorWithPredictor( rcCand.iSearchX, rcCand.iSearchY );
+
+      if( uiSad < rcStruct.uiBestSad )
+      {
+        rcStruct.uiBestSad      = uiSad;
+        rcStruct.iBestX         = rcCand.iSearchX;
+        rcStruct.iBestY         = rcCand.iSearchY;
+        rcStruct.uiBestDistance = rcCand.uiDistance;
+        rcStruct.uiBestRound    = 0;
+        rcStruct.ucPointNr      = rcCand.ucPointNr;
+      }
+    }
+  }
+  m_cDistParam.pCur                            = apiRefSrch[m_uiNumTZCandidates - 1];
+  m_cDistParam.m_maximumDistortionForEarlyExit = rcStruct.uiBestSad;
+  m_uiNumTZCandidates                          = 0;
+}
+
 __inline Void TEncSearch::xTZ2PointSearch( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const TComMv* const pcMvSrchRngLT, const TComMv* const pcMvSrchRngRB )
 {
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
@@ -573,38 +684,40 @@ __inline Void TEncSearch::xTZ8PointSquareSearch( const TComPattern* const pcPatt
   {
     if ( iLeft >= iSrchRngHorLeft ) // check top left
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iTop, 1, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iTop, 1, iDist );
     }
     // top middle
-    xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
+    xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
 
     if ( iRight <= iSrchRngHorRight ) // check top right
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iRight, iTop, 3, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iTop, 3, iDist );
     }
   } // check top
   if ( iLeft >= iSrchRngHorLeft ) // check middle left
   {
-    xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
+    xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
   }
   if ( iRight <= iSrchRngHorRight ) // check middle right
   {
-    xTZSearchHelp( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
+    xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
   }
   if ( iBottom <= iSrchRngVerBottom ) // check bottom
   {
     if ( iLeft >= iSrchRngHorLeft ) // check bottom left
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iBottom, 6, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iBottom, 6, iDist );
     }
     // check bottom middle
-    xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
+    xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
 
     if ( iRight <= iSrchRngHorRight ) // check bottom right
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iRight, iBottom, 8, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iBottom, 8, iDist );
     }
   } // check bottom
+
+  xTZSearchEvaluateCandidates( pcPatternKey, rcStruct );
 }
 
 
@@ -642,26 +755,26 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
       {
         if ( iLeft >= iSrchRngHorLeft) // check top-left
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iTop, 1, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iTop, 1, iDist );
         }
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
         if ( iRight <= iSrchRngHorRight ) // check middle right
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iRight, iTop, 3, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iTop, 3, iDist );
         }
       }
       else
       {
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
       }
     }
     if ( iLeft >= iSrchRngHorLeft ) // check middle left
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
     }
     if ( iRight <= iSrchRngHorRight ) // check middle right
     {
-      xTZSearchHelp( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
+      xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
     }
     if ( iBottom <= iSrchRngVerBottom ) // check bottom
     {
@@ -669,17 +782,17 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
       {
         if ( iLeft >= iSrchRngHorLeft) // check top-left
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iBottom, 6, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iBottom, 6, iDist );
         }
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
         if ( iRight <= iSrchRngHorRight ) // check middle right
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iRight, iBottom, 8, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iBottom, 8, iDist );
         }
       }
       else
       {
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
       }
     }
   }
@@ -695,54 +808,54 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
       if (  iTop >= iSrchRngVerTop && iLeft >= iSrchRngHorLeft &&
           iRight <= iSrchRngHorRight && iBottom <= iSrchRngVerBottom ) // check border
       {
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX,  iTop,      2, iDist    );
-        xTZSearchHelp( pcPatternKey, rcStruct, iLeft_2,  iTop_2,    1, iDist>>1 );
-        xTZSearchHelp( pcPatternKey, rcStruct, iRight_2, iTop_2,    3, iDist>>1 );
-        xTZSearchHelp( pcPatternKey, rcStruct, iLeft,    iStartY,   4, iDist    );
-        xTZSearchHelp( pcPatternKey, rcStruct, iRight,   iStartY,   5, iDist    );
-        xTZSearchHelp( pcPatternKey, rcStruct, iLeft_2,  iBottom_2, 6, iDist>>1 );
-        xTZSearchHelp( pcPatternKey, rcStruct, iRight_2, iBottom_2, 8, iDist>>1 );
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX,  iBottom,   7, iDist    );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX,  iTop,      2, iDist    );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft_2,  iTop_2,    1, iDist>>1 );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight_2, iTop_2,    3, iDist>>1 );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft,    iStartY,   4, iDist    );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight,   iStartY,   5, iDist    );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft_2,  iBottom_2, 6, iDist>>1 );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight_2, iBottom_2, 8, iDist>>1 );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX,  iBottom,   7, iDist    );
       }
       else // check border
       {
         if ( iTop >= iSrchRngVerTop ) // check top
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop, 2, iDist );
         }
         if ( iTop_2 >= iSrchRngVerTop ) // check half top
         {
           if ( iLeft_2 >= iSrchRngHorLeft ) // check half left
           {
-            xTZSearchHelp( pcPatternKey, rcStruct, iLeft_2, iTop_2, 1, (iDist>>1) );
+            xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft_2, iTop_2, 1, (iDist>>1) );
           }
           if ( iRight_2 <= iSrchRngHorRight ) // check half right
           {
-            xTZSearchHelp( pcPatternKey, rcStruct, iRight_2, iTop_2, 3, (iDist>>1) );
+            xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight_2, iTop_2, 3, (iDist>>1) );
           }
         } // check half top
         if ( iLeft >= iSrchRngHorLeft ) // check left
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iStartY, 4, iDist );
         }
         if ( iRight <= iSrchRngHorRight ) // check right
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iStartY, 5, iDist );
         }
         if ( iBottom_2 <= iSrchRngVerBottom ) // check half bottom
         {
           if ( iLeft_2 >= iSrchRngHorLeft ) // check half left
           {
-            xTZSearchHelp( pcPatternKey, rcStruct, iLeft_2, iBottom_2, 6, (iDist>>1) );
+            xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft_2, iBottom_2, 6, (iDist>>1) );
           }
           if ( iRight_2 <= iSrchRngHorRight ) // check half right
           {
-            xTZSearchHelp( pcPatternKey, rcStruct, iRight_2, iBottom_2, 8, (iDist>>1) );
+            xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight_2, iBottom_2, 8, (iDist>>1) );
           }
         } // check half bottom
         if ( iBottom <= iSrchRngVerBottom ) // check bottom
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 7, iDist );
         }
       } // check border
     }
@@ -751,39 +864,39 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
       if ( iTop >= iSrchRngVerTop && iLeft >= iSrchRngHorLeft &&
           iRight <= iSrchRngHorRight && iBottom <= iSrchRngVerBottom ) // check border
       {
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop,    0, iDist );
-        xTZSearchHelp( pcPatternKey, rcStruct, iLeft,   iStartY, 0, iDist );
-        xTZSearchHelp( pcPatternKey, rcStruct, iRight,  iStartY, 0, iDist );
-        xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 0, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop,    0, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft,   iStartY, 0, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight,  iStartY, 0, iDist );
+        xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 0, iDist );
         for ( Int index = 1; index < 4; index++ )
         {
           const Int iPosYT = iTop    + ((iDist>>2) * index);
           const Int iPosYB = iBottom - ((iDist>>2) * index);
           const Int iPosXL = iStartX - ((iDist>>2) * index);
           const Int iPosXR = iStartX + ((iDist>>2) * index);
-          xTZSearchHelp( pcPatternKey, rcStruct, iPosXL, iPosYT, 0, iDist );
-          xTZSearchHelp( pcPatternKey, rcStruct, iPosXR, iPosYT, 0, iDist );
-          xTZSearchHelp( pcPatternKey, rcStruct, iPosXL, iPosYB, 0, iDist );
-          xTZSearchHelp( pcPatternKey, rcStruct, iPosXR, iPosYB, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXL, iPosYT, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXR, iPosYT, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXL, iPosYB, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXR, iPosYB, 0, iDist );
         }
       }
       else // check border
       {
         if ( iTop >= iSrchRngVerTop ) // check top
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iTop, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iTop, 0, iDist );
         }
         if ( iLeft >= iSrchRngHorLeft ) // check left
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iLeft, iStartY, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iLeft, iStartY, 0, iDist );
         }
         if ( iRight <= iSrchRngHorRight ) // check right
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iRight, iStartY, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iRight, iStartY, 0, iDist );
         }
         if ( iBottom <= iSrchRngVerBottom ) // check bottom
         {
-          xTZSearchHelp( pcPatternKey, rcStruct, iStartX, iBottom, 0, iDist );
+          xTZSearchAddCandidate( pcPatternKey, rcStruct, iStartX, iBottom, 0, iDist );
         }
         for ( Int index = 1; index < 4; index++ )
         {
@@ -796,42 +909,47 @@ __inline Void TEncSearch::xTZ8PointDiamondSearch( const TComPattern*const  pcPat
           {
             if ( iPosXL >= iSrchRngHorLeft ) // check left
             {
-              xTZSearchHelp( pcPatternKey, rcStruct, iPosXL, iPosYT, 0, iDist );
+              xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXL, iPosYT, 0, iDist );
             }
             if ( iPosXR <= iSrchRngHorRight ) // check right
             {
-              xTZSearchHelp( pcPatternKey, rcStruct, iPosXR, iPosYT, 0, iDist );
+              xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXR, iPosYT, 0, iDist );
             }
           } // check top
           if ( iPosYB <= iSrchRngVerBottom ) // check bottom
           {
             if ( iPosXL >= iSrchRngHorLeft ) // check left
             {
-              xTZSearchHelp( pcPatternKey, rcStruct, iPosXL, iPosYB, 0, iDist );
+              xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXL, iPosYB, 0, iDist );
             }
             if ( iPosXR <= iSrchRngHorRight ) // check right
             {
-              xTZSearchHelp( pcPatternKey, rcStruct, iPosXR, iPosYB, 0, iDist );
+              xTZSearchAddCandidate( pcPatternKey, rcStruct, iPosXR, iPosYB, 0, iDist );
             }
           } // check bottom
         } // for ...
       } // check border
     } // iDist <= 8
   } // iDist == 1
+
+  xTZSearchEvaluateCandidates( pcPatternKey, rcStruct );
 }
 
 Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
                                            TComMv baseRefMv,
                                            Int iFrac, TComMv& rcMvFrac,
-                                           Bool bAllowUseOfHadamard
+                                           Bool bAllowUseOfHadamard,
+                                           const TComSubPelPlanes* pcSubPelPlanes,
+                                           Int iPlaneOffset
                                          )
 {
   Distortion  uiDist;
   Distortion  uiDistBest  = std::numeric_limits<Distortion>::max();
   UInt        uiDirecBest = 0;
 
-  Pel*  piRefPos;
-  Int iRefStride = m_filteredBlock[0][0].getStride(COMPONENT_Y);
+  const Pel*  piRefPos;
+  Int iRefStride   = m_filteredBlock[0][0].getStride(COMPONENT_Y);
+  Int iPlaneStride = pcSubPelPlanes != NULL ? pcSubPelPlanes->getStride() : 0;
 
   m_pcRdCost->setDistParam( pcPatternKey, m_filteredBlock[0][0].getAddr(COMPONENT_Y), iRefStride, 1, m_cDistParam, m_pcEncCfg->getUseHADME() && bAllowUseOfHadamard );
 
@@ -844,14 +962,23 @@ Distortion TEncSearch::xPatternRefinement( TComPattern* pcPatternKey,
 
     Int horVal = cMvTest.getHor() * iFrac;
     Int verVal = cMvTest.getVer() * iFrac;
-    piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
-    if ( horVal == 2 && ( verVal & 1 ) == 0 )
+    if ( pcSubPelPlanes != NULL && pcSubPelPlanes->hasPlane( verVal & 3, horVal & 3 ) )
     {
-      piRefPos += 1;
+      piRefPos = pcSubPelPlanes->getAddr( verVal & 3, horVal & 3 ) + iPlaneOffset + ( verVal >> 2 ) * iPlaneStride + ( horVal >> 2 );
+      m_cDistParam.iStrideCur = iPlaneStride;
     }
-    if ( ( horVal & 1 ) == 0 && verVal == 2 )
+    else
     {
-      piRefPos += iRefStride;
+      piRefPos = m_filteredBlock[ verVal & 3 ][ horVal & 3 ].getAddr(COMPONENT_Y);
+      if ( horVal == 2 && ( verVal & 1 ) == 0 )
+      {
+        piRefPos += 1;
+      }
+      if ( ( horVal & 1 ) == 0 && verVal == 2 )
+      {
+        piRefPos += iRefStride;
+      }
+      m_cDistParam.iStrideCur = iRefStride;
     }
     cMvTest = pcMvRefine[i];
     cMvTest += rcMvFrac;
@@ -1177,7 +1304,10 @@ Void TEncSearch::xIntraCodingTUBlock(       TComYuv*    pcOrgYuv,
   {
     const Bool bUseFilteredPredictions=TComPrediction::filteringIntraReferenceSamples(compID, uiChFinalMode, uiWidth, uiHeight, chFmt, sps.getSpsRangeExtension().getIntraSmoothingDisabledFlag());
 
-    initIntraPatternChType( rTu, compID, bUseFilteredPredictions DEBUG_STRING_PASS_INTO(sDebug) );
+    if( !bIsLuma || !xLoadIntraRefCache( rTu ) )
+    {
+      initIntraPatternChType( rTu, compID, bUseFilteredPredictions DEBUG_STRING_PASS_INTO(sDebug) );
+    }
 
     //===== get prediction signal =====
     predIntraAng( compID, uiChFinalMode, piOrg, uiStride, piPred, uiStride, rTu, bUseFilteredPredictions );
@@ -1756,6 +1886,65 @@ TEncSearch::xSetIntraResultLumaQT(TComYuv* pcRecoYuv, TComTU &rTu)
 }
 
 
+/** saves the unfiltered and filtered luma reference samples of the PU just prepared by initIntraPatternChType, so that
+ *  the RD passes over its candidate modes do not derive them again
+ */
+Void
+TEncSearch::xStoreIntraRefCache( TComTU &rTu )
+{
+  const TComRectangle &rect   = rTu.getRect(COMPONENT_Y);
+  const UInt           stride = 2 * rect.width + 1;
+
+  for (UInt buf = 0; buf < NUM_PRED_BUF; buf++)
+  {
+    const Pel *piSrc = getPredictorPtr( COMPONENT_Y, buf == PRED_BUF_FILTERED );
+          Pel *piDst = m_intraRefCache[buf];
+
+    ::memcpy( piDst, piSrc, stride * sizeof( Pel ) );
+    piDst += stride;
+    for (UInt y = 1; y <= 2 * rect.height; y++)
+    {
+      *piDst++ = piSrc[y * stride];
+    }
+  }
+
+  m_intraRefCachePartIdx = rTu.GetAbsPartIdxTU();
+  m_intraRefCacheWidth   = rect.width;
+  m_intraRefCacheHeight  = rect.height;
+}
+
+
+/** restores the luma reference samples saved by xStoreIntraRefCache when rTu is the cached PU
+ * \returns true if the reference samples were restored
+ */
+Bool
+TEncSearch::xLoadIntraRefCache( TComTU &rTu )
+{
+  const TComRectangle &rect = rTu.getRect(COMPONENT_Y);
+
+  if (m_intraRefCachePartIdx != Int(rTu.GetAbsPartIdxTU()) || m_intraRefCacheWidth != rect.width || m_intraRefCacheHeight != rect.height)
+  {
+    return false;
+  }
+
+  const UInt stride = 2 * rect.width + 1;
+
+  for (UInt buf = 0; buf < NUM_PRED_BUF; buf++)
+  {
+    const Pel *piSrc = m_intraRefCache[buf];
+          Pel *piDst = getPredictorPtr( COMPONENT_Y, buf == PRED_BUF_FILTERED );
+
+    ::memcpy( piDst, piSrc, stride * sizeof( Pel ) );
+    piSrc += stride;
+    for (UInt y = 1; y <= 2 * rect.height; y++)
+    {
+      piDst[y * stride] = *piSrc++;
+    }
+  }
+  return true;
+}
+
+
 Void
 TEncSearch::xStoreIntraResultQT(const ComponentID compID, TComTU &rTu )
 {
@@ -2246,6 +2435,7 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
     // this should always be true
     assert (tuRecurseWithPU.ProcessComponentSection(COMPONENT_Y));
     initIntraPatternChType( tuRecurseWithPU, COMPONENT_Y, true DEBUG_STRING_PASS_INTO(sTemp2) );
+    xStoreIntraRefCache( tuRecurseWithPU );
 
     Bool doFastSearch = (numModesForFullRD != numModesAvailable);
     if (doFastSearch)
@@ -2489,6 +2679,9 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
 
     DEBUG_STRING_APPEND(sDebug, sPU)
 
+    // the reconstruction of this PU changes the references of the next one
+    m_intraRefCachePartIdx = -1;
+
     //--- update overall distortion ---
     uiOverallDistY += uiBestPUDistY;
 
@@ -3746,8 +3939,9 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
                              pcYuv->getStride(COMPONENT_Y),
                              pcCU->getSlice()->getSPS()->getBitDepth(CHANNEL_TYPE_LUMA) );
 
-  Pel*        piRefY      = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->getAddr( COMPONENT_Y, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + uiPartAddr );
-  Int         iRefStride  = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->getStride(COMPONENT_Y);
+  TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec();
+  Pel*        piRefY      = pcPicYuvRef->getAddr( COMPONENT_Y, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() + uiPartAddr );
+  Int         iRefStride  = pcPicYuvRef->getStride(COMPONENT_Y);
 
   TComMv      cMvPred = *pcMvPred;
 
@@ -3766,6 +3960,25 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   m_pcRdCost->setCostScale  ( 2 );
 
   setWpScalingDistParam( pcCU, iRefIdxPred, eRefPicList );
+
+  // for 8-bit content the TZ search can compute its SADs on 8-bit copies of the block and of the reference, which give
+  // the same SADs with half the memory traffic and twice the samples per SIMD instruction
+  m_piRefLuma8 = NULL;
+  if ( m_pcEncCfg->getLuma8BitME() && pcPatternKey->getBitDepthY() == 8 && !m_cDistParam.bApplyWeight && !bBi &&
+       m_motionEstimationSearchMethod != MESEARCH_FULL && m_motionEstimationSearchMethod != MESEARCH_SELECTIVE )
+  {
+    const Pel* piOrg      = pcPatternKey->getROIY();
+    const Int  iOrgStride = pcPatternKey->getPatternLStride();
+    for ( Int y = 0; y < iRoiHeight; y++ )
+    {
+      for ( Int x = 0; x < iRoiWidth; x++ )
+      {
+        m_aucOrgLuma8[y * iRoiWidth + x] = UChar( piOrg[y * iOrgStride + x] );
+      }
+    }
+    m_piRefLuma8 = pcPicYuvRef->getLuma8Addr( piRefY );
+  }
+
   //  Do integer search
   if ( (m_motionEstimationSearchMethod==MESEARCH_FULL) || bBi )
   {
@@ -3779,7 +3992,29 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
     {
       pIntegerMv2Nx2NPred = &(m_integerMv2Nx2N[eRefPicList][iRefIdxPred]);
     }
-    xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred );
+    // a reference encode of the same source found this vector: start from it and only refine around it
+    TComMv cAnalysisMv;
+    if (m_pcEncCfg->getAnalysisLoad() != NULL && m_pcEncCfg->getAnalysisLoad()->getMv( pcCU, uiPartAddr, eRefPicList, iRefIdxPred, cAnalysisMv ))
+    {
+#if ME_ENABLE_ROUNDING_OF_MVS
+      cAnalysisMv.divideByPowerOf2(2);
+#else
+      cAnalysisMv >>= 2;
+#endif
+      pIntegerMv2Nx2NPred = &cAnalysisMv;
+      m_iSearchRange      = std::min(m_iSearchRange, ANALYSIS_REFINE_SEARCH_RANGE);
+    }
+    // the coarse search on the downsampled pictures found this vector: test it as a further start point of the TZ search,
+    // which then only refines around the best start
+    TComMv cHierarchicalMv;
+    const TComMv *pHierarchicalMv=0;
+    if (m_pcEncCfg->getHierarchicalME() && m_motionEstimationSearchMethod != MESEARCH_SELECTIVE &&
+        m_cHierarchicalME.getMv( pcCU, uiPartAddr, iRoiWidth, iRoiHeight, eRefPicList, iRefIdxPred, cHierarchicalMv ))
+    {
+      pHierarchicalMv = &cHierarchicalMv;
+      m_iSearchRange  = std::min(m_iSearchRange, m_pcEncCfg->getHierarchicalMERefineRange());
+    }
+    xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred, pHierarchicalMv );
     if (pcCU->getPartitionSize(0) == SIZE_2Nx2N)
     {
       m_integerMv2Nx2N[eRefPicList][iRefIdxPred] = rcMv;
@@ -3789,8 +4024,16 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
   m_pcRdCost->selectMotionLambda( true, 0, pcCU->getCUTransquantBypass(uiPartAddr) );
   m_pcRdCost->setCostScale ( 1 );
 
+  // the fractional refinement reads the rows from one above to the last one of the block at the integer vector
+  TComSubPelPlanes* pcSubPelPlanes = xGetSubPelPlanes( pcPicYuvRef, pcCU->getSlice()->getSPS() );
+  if ( pcSubPelPlanes != NULL )
+  {
+    const Int iTopRow = pcCU->getCUPelY() + g_auiRasterToPelY[ g_auiZscanToRaster[ uiPartAddr ] ] + rcMv.getVer();
+    pcSubPelPlanes->prepareRows( iTopRow - 1, iTopRow + iRoiHeight - 1 );
+  }
+
   const Bool bIsLosslessCoded = pcCU->getCUTransquantBypass(uiPartAddr) != 0;
-  xPatternSearchFracDIF( bIsLosslessCoded, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost );
+  xPatternSearchFracDIF( bIsLosslessCoded, pcPatternKey, piRefY, iRefStride, &rcMv, cMvHalf, cMvQter, ruiCost, pcSubPelPlanes, Int( piRefY - pcPicYuvRef->getAddr( COMPONENT_Y ) ) );
 
   m_pcRdCost->setCostScale( 0 );
   rcMv <<= 2;
@@ -3901,7 +4144,8 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
                                      const TComMv* const      pcMvSrchRngRB,
                                      TComMv&                  rcMv,
                                      Distortion&              ruiSAD,
-                                     const TComMv* const      pIntegerMv2Nx2NPred )
+                                     const TComMv* const      pIntegerMv2Nx2NPred,
+                                     const TComMv* const      pHierarchicalMv )
 {
   assert (MD_LEFT < NUM_MV_PREDICTORS);
   pcCU->getMvPredLeft       ( m_acMvPredictors[MD_LEFT] );
@@ -3913,7 +4157,7 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
   switch ( m_motionEstimationSearchMethod )
   {
     case MESEARCH_DIAMOND:
-      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, false );
+      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, false, pHierarchicalMv );
       break;
 
     case MESEARCH_SELECTIVE:
@@ -3921,7 +4165,7 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
       break;
 
     case MESEARCH_DIAMOND_ENHANCED:
-      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, true );
+      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD, pIntegerMv2Nx2NPred, true, pHierarchicalMv );
       break;
 
     case MESEARCH_FULL: // shouldn't get here.
@@ -3935,12 +4179,13 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
                             const TComPattern* const pcPatternKey,
                             const Pel* const         piRefY,
                             const Int                iRefStride,
-                            const TComMv* const      pcMvSrchRngLT,
-                            const TComMv* const      pcMvSrchRngRB,
+                            const TComMv*            pcMvSrchRngLT,
+                            const TComMv*            pcMvSrchRngRB,
                             TComMv&                  rcMv,
                             Distortion&              ruiSAD,
                             const TComMv* const      pIntegerMv2Nx2NPred,
-                            const Bool               bExtendedSettings)
+                            const Bool               bExtendedSettings,
+                            const TComMv* const      pHierarchicalMv)
 {
   const Bool bUseAdaptiveRaster                      = bExtendedSettings;
   const Int  iRaster                                 = 5;
@@ -3975,6 +4220,7 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
   IntTZSearchStruct cStruct;
   cStruct.iYStride    = iRefStride;
   cStruct.piRefY      = piRefY;
+  cStruct.piRefY8     = m_piRefLuma8;
   cStruct.uiBestSad   = MAX_UINT;
 
   // set rcMv (Median predictor) as start point and as best point
@@ -4011,6 +4257,32 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
     }
   }
 
+  // test the vector of the coarse search on the downsampled pictures. It may lie far outside of the window around the
+  // predictor, so the window is moved to the best start point, with the range reduced by the caller
+  TComMv cMvHierarchicalSrchRngLT;
+  TComMv cMvHierarchicalSrchRngRB;
+  if (pHierarchicalMv != 0)
+  {
+    TComMv hierarchicalMv = *pHierarchicalMv;
+    hierarchicalMv <<= 2;
+    pcCU->clipMv( hierarchicalMv );
+#if ME_ENABLE_ROUNDING_OF_MVS
+    hierarchicalMv.divideByPowerOf2(2);
+#else
+    hierarchicalMv >>= 2;
+#endif
+    if (hierarchicalMv.getHor() != cStruct.iBestX || hierarchicalMv.getVer() != cStruct.iBestY)
+    {
+      xTZSearchHelp( pcPatternKey, cStruct, hierarchicalMv.getHor(), hierarchicalMv.getVer(), 0, 0 );
+    }
+
+    TComMv currBestMv(cStruct.iBestX, cStruct.iBestY );
+    currBestMv <<= 2;
+    xSetSearchRange( pcCU, currBestMv, uiSearchRange, cMvHierarchicalSrchRngLT, cMvHierarchicalSrchRngRB );
+    pcMvSrchRngLT = &cMvHierarchicalSrchRngLT;
+    pcMvSrchRngRB = &cMvHierarchicalSrchRngRB;
+  }
+
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
   Int   iSrchRngHorRight  = pcMvSrchRngRB->getHor();
   Int   iSrchRngVerTop    = pcMvSrchRngLT->getVer();
@@ -4140,9 +4412,10 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
     {
       for ( iStartX = iSrchRngRasterLeft; iStartX <= iSrchRngRasterRight; iStartX += iWindowSize )
       {
-        xTZSearchHelp( pcPatternKey, cStruct, iStartX, iStartY, 0, iWindowSize );
+        xTZSearchAddCandidate( pcPatternKey, cStruct, iStartX, iStartY, 0, iWindowSize );
       }
     }
+    xTZSearchEvaluateCandidates( pcPatternKey, cStruct );
   }
   else
   {
@@ -4153,9 +4426,10 @@ Void TEncSearch::xTZSearch( const TComDataCU* const pcCU,
       {
         for ( iStartX = iSrchRngHorLeft; iStartX <= iSrchRngHorRight; iStartX += iRaster )
         {
-          xTZSearchHelp( pcPatternKey, cStruct, iStartX, iStartY, 0, iRaster );
+          xTZSearchAddCandidate( pcPatternKey, cStruct, iStartX, iStartY, 0, iRaster );
         }
       }
+      xTZSearchEvaluateCandidates( pcPatternKey, cStruct );
     }
   }
 
@@ -4282,6 +4556,7 @@ Void TEncSearch::xTZSearchSelective( const TComDataCU* const   pcCU,
   IntTZSearchStruct cStruct;
   cStruct.iYStride    = iRefStride;
   cStruct.piRefY      = piRefY;
+  cStruct.piRefY8     = NULL;
   cStruct.uiBestSad   = MAX_UINT;
   cStruct.iBestX = 0;
   cStruct.iBestY = 0;
@@ -4421,7 +4696,9 @@ Void TEncSearch::xPatternSearchFracDIF(
                                        TComMv*      pcMvInt,
                                        TComMv&      rcMvHalf,
                                        TComMv&      rcMvQter,
-                                       Distortion&  ruiCost
+                                       Distortion&  ruiCost,
+                                       const TComSubPelPlanes* pcSubPelPlanes,
+                                       Int          iPlaneOffset
                                       )
 {
   //  Reference pattern initialization (integer scale)
@@ -4432,23 +4709,53 @@ Void TEncSearch::xPatternSearchFracDIF(
                           pcPatternKey->getROIYHeight(),
                           iRefStride,
                           pcPatternKey->getBitDepthY());
+  iPlaneOffset += iOffset;
 
   //  Half-pel refinement
-  xExtDIFUpSamplingH ( &cPatternRoi );
+  if ( pcSubPelPlanes == NULL )
+  {
+    xExtDIFUpSamplingH ( &cPatternRoi );
+  }
 
   rcMvHalf = *pcMvInt;   rcMvHalf <<= 1;    // for mv-cost
   TComMv baseRefMv(0, 0);
-  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 2, rcMvHalf, !bIsLosslessCoded );
+  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 2, rcMvHalf, !bIsLosslessCoded, pcSubPelPlanes, iPlaneOffset );
 
   m_pcRdCost->setCostScale( 0 );
 
-  xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  if ( pcSubPelPlanes == NULL || pcSubPelPlanes->isHalfPelOnly() )
+  {
+    if ( pcSubPelPlanes != NULL )
+    {
+      // the quarter-sample blocks are filtered vertically from the horizontally filtered rows of the half-sample step
+      xExtDIFUpSamplingH ( &cPatternRoi, true );
+    }
+    xExtDIFUpSamplingQ ( &cPatternRoi, rcMvHalf );
+  }
   baseRefMv = rcMvHalf;
   baseRefMv <<= 1;
 
   rcMvQter = *pcMvInt;   rcMvQter <<= 1;    // for mv-cost
   rcMvQter += rcMvHalf;  rcMvQter <<= 1;
-  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 1, rcMvQter, !bIsLosslessCoded );
+  ruiCost = xPatternRefinement( pcPatternKey, baseRefMv, 1, rcMvQter, !bIsLosslessCoded, pcSubPelPlanes, iPlaneOffset );
+}
+
+
+/** returns the sub-sample planes of a reference picture, creating them on first use, or NULL when they are not used
+ * \param pcPicYuvRef reconstruction of the reference picture
+ * \param pcSPS       active SPS
+ */
+TComSubPelPlanes* TEncSearch::xGetSubPelPlanes( TComPicYuv* pcPicYuvRef, const TComSPS* pcSPS )
+{
+  if ( m_pcEncCfg->getSubPelPlanes() == 0 )
+  {
+    return NULL;
+  }
+  if ( pcPicYuvRef->getSubPelPlanes() == NULL )
+  {
+    pcPicYuvRef->createSubPelPlanes( pcSPS->getMaxCUHeight(), m_pcEncCfg->getSubPelPlanes() == 1, pcSPS->getBitDepth(CHANNEL_TYPE_LUMA) );
+  }
+  return pcPicYuvRef->getSubPelPlanes();
 }
 
 
@@ -5510,9 +5817,9 @@ Void  TEncSearch::xAddSymbolBitsInter( TComDataCU* pcCU, UInt& ruiBits )
  * \brief Generate half-sample interpolated block
  *
  * \param pattern Reference picture ROI
- * \param biPred    Flag indicating whether block is for biprediction
+ * \param bHorizontalOnly Only generate the horizontally filtered rows used by xExtDIFUpSamplingQ
  */
-Void TEncSearch::xExtDIFUpSamplingH( TComPattern* pattern )
+Void TEncSearch::xExtDIFUpSamplingH( TComPattern* pattern, Bool bHorizontalOnly )
 {
   Int width      = pattern->getROIYWidth();
   Int height     = pattern->getROIYHeight();
@@ -5531,6 +5838,11 @@ Void TEncSearch::xExtDIFUpSamplingH( TComPattern* pattern )
   m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[0].getAddr(COMPONENT_Y), intStride, width+1, height+filterSize, 0, false, chFmt, pattern->getBitDepthY());
   m_if.filterHor(COMPONENT_Y, srcPtr, srcStride, m_filteredBlockTmp[2].getAddr(COMPONENT_Y), intStride, width+1, height+filterSize, 2, false, chFmt, pattern->getBitDepthY());
 
+  if (bHorizontalOnly)
+  {
+    return;
+  }
+
   intPtr = m_filteredBlockTmp[0].getAddr(COMPONENT_Y) + halfFilterSize * intStride + 1;
   dstPtr = m_filteredBlock[0][0].getAddr(COMPONENT_Y);
   m_if.filterVer(COMPONENT_Y, intPtr, intStride, dstPtr, dstStride, width+0, height+0, 0, false, true, chFmt, pattern->getBitDepthY());
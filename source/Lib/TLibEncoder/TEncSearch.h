@@ -46,6 +46,8 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComRectangle.h"
+#include "TLibCommon/TComSubPelPlanes.h"
+#include "TEncHierarchicalME.h"
 #include "TEncEntropy.h"
 #include "TEncSbac.h"
 #include "TEncCfg.h"
@@ -87,6 +89,12 @@ private:
   TCoeff*         m_ppcQTTempTUArlCoeff[MAX_NUM_COMPONENT];
 #endif
 
+  // luma reference samples of the PU searched by estIntraPredLumaQT, reused by the full RD passes of its top-level TU
+  Pel             m_intraRefCache[NUM_PRED_BUF][4*MAX_CU_SIZE+1]; ///< top row (2w+1 samples) followed by the left column (2h samples)
+  Int             m_intraRefCachePartIdx;                         ///< part index of the cached PU, -1 if the cache is empty
+  UInt            m_intraRefCacheWidth;
+  UInt            m_intraRefCacheHeight;
+
 protected:
   // interface to option
   TEncCfg*        m_pcEncCfg;
@@ -117,6 +125,13 @@ protected:
 
   TComMv          m_integerMv2Nx2N[NUM_REF_PIC_LIST_01][MAX_NUM_REF];
 
+  // coarse motion search on downsampled pictures
+  TEncHierarchicalME m_cHierarchicalME;
+
+  // 8-bit copies of the block and of the reference picture for the integer motion search
+  UChar           m_aucOrgLuma8[MAX_CU_SIZE * MAX_CU_SIZE];
+  const UChar*    m_piRefLuma8;
+
   Bool            m_isInitialized;
 public:
   TEncSearch();
@@ -137,17 +152,21 @@ public:
 
   Void destroy();
 
+  TEncHierarchicalME* getHierarchicalME() { return &m_cHierarchicalME; }
+
 protected:
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
   Distortion  xPatternRefinement( TComPattern* pcPatternKey,
                                   TComMv baseRefMv,
-                                  Int iFrac, TComMv& rcMvFrac, Bool bAllowUseOfHadamard
+                                  Int iFrac, TComMv& rcMvFrac, Bool bAllowUseOfHadamard,
+                                  const TComSubPelPlanes* pcSubPelPlanes, Int iPlaneOffset
                                  );
 
   typedef struct
   {
     const Pel*  piRefY;
+    const UChar* piRefY8;   ///< 8-bit copy of the reference at piRefY, NULL when not used
     Int         iYStride;
     Int         iBestX;
     Int         iBestY;
@@ -157,8 +176,23 @@ protected:
     UChar       ucPointNr;
   } IntTZSearchStruct;
 
+  typedef struct
+  {
+    Int         iSearchX;
+    Int         iSearchY;
+    UChar       ucPointNr;
+    UInt        uiDistance;
+  } TZSearchCandidate;
+
+  // search points of a TZ search pattern, whose SADs are computed together by xTZSearchEvaluateCandidates
+  static const UInt TZ_MAX_NUM_CANDIDATES = 16;
+  TZSearchCandidate m_acTZCandidates[TZ_MAX_NUM_CANDIDATES];
+  UInt              m_uiNumTZCandidates;
+
   // sub-functions for ME
   __inline Void xTZSearchHelp         ( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance );
+  __inline Void xTZSearchAddCandidate ( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance );
+  Void          xTZSearchEvaluateCandidates( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct );
   __inline Void xTZ2PointSearch       ( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const TComMv* const pcMvSrchRngLT, const TComMv* const pcMvSrchRngRB );
   __inline Void xTZ8PointSquareSearch ( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const TComMv* const pcMvSrchRngLT, const TComMv* const pcMvSrchRngRB, const Int iStartX, const Int iStartY, const Int iDist );
   __inline Void xTZ8PointDiamondSearch( const TComPattern* const pcPatternKey, IntTZSearchStruct& rcStruct, const TComMv* const pcMvSrchRngLT, const TComMv* const pcMvSrchRngRB, const Int iStartX, const Int iStartY, const Int iDist, const Bool bCheckCornersAtDist1 );
@@ -264,6 +298,9 @@ protected:
   Void  xSetIntraResultLumaQT     ( TComYuv*     pcRecoYuv,
                                     TComTU &rTu);
 
+  Void  xStoreIntraRefCache       ( TComTU &rTu );
+  Bool  xLoadIntraRefCache        ( TComTU &rTu );
+
   Void xStoreCrossComponentPredictionResult  (       Pel    *pResiLuma,
                                                const Pel    *pBestLuma,
                                                      TComTU &rTu,
@@ -373,12 +410,13 @@ protected:
                                     const TComPattern* const pcPatternKey,
                                     const Pel* const         piRefY,
                                     const Int                iRefStride,
-                                    const TComMv* const      pcMvSrchRngLT,
-                                    const TComMv* const      pcMvSrchRngRB,
+                                    const TComMv*            pcMvSrchRngLT,
+                                    const TComMv*            pcMvSrchRngRB,
                                     TComMv&                  rcMv,
                                     Distortion&              ruiSAD,
                                     const TComMv* const      pIntegerMv2Nx2NPred,
-                                    const Bool               bExtendedSettings
+                                    const Bool               bExtendedSettings,
+                                    const TComMv* const      pHierarchicalMv
                                     );
 
   Void xTZSearchSelective         ( const TComDataCU* const  pcCU,
@@ -406,7 +444,8 @@ protected:
                                     const TComMv* const      pcMvSrchRngRB,
                                     TComMv&                  rcMv,
                                     Distortion&              ruiSAD,
-                                    const TComMv* const      pIntegerMv2Nx2NPred
+                                    const TComMv* const      pIntegerMv2Nx2NPred,
+                                    const TComMv* const      pHierarchicalMv
                                   );
 
   Void xPatternSearch             ( const TComPattern* const pcPatternKey,
@@ -425,10 +464,14 @@ protected:
                                     TComMv*      pcMvInt,
                                     TComMv&      rcMvHalf,
                                     TComMv&      rcMvQter,
-                                    Distortion&  ruiCost
+                                    Distortion&  ruiCost,
+                                    const TComSubPelPlanes* pcSubPelPlanes,
+                                    Int          iPlaneOffset
                                    );
 
-  Void xExtDIFUpSamplingH( TComPattern* pcPattern );
+  TComSubPelPlanes* xGetSubPelPlanes( TComPicYuv* pcPicYuvRef, const TComSPS* pcSPS );
+
+  Void xExtDIFUpSamplingH( TComPattern* pcPattern, Bool bHorizontalOnly = false );
   Void xExtDIFUpSamplingQ( TComPattern* pcPatternKey, TComMv halfPelRef );
 
   // -------------------------------------------------------------------------------------------------------------------
@@ -756,6 +756,14 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     xCheckWPEnable( pcSlice );
   }
 
+  //------------------------------------------------------------------------------
+  //  Downsampled pictures for the coarse motion search
+  //------------------------------------------------------------------------------
+  if ( m_pcCfg->getHierarchicalME() )
+  {
+    m_pcPredSearch->getHierarchicalME()->initPicture( pcPic );
+  }
+
 #if ADAPTIVE_QP_SELECTION
   if( m_pcCfg->getUseAdaptQpSelect() && !(pcSlice->getDependentSliceSegmentFlag()))
   {
@@ -878,6 +886,10 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     // run CTU trial encoder
     m_pcCuEncoder->compressCtu( pCtu );
 
+    if ( m_pcCfg->getAnalysisSave() != NULL )
+    {
+      m_pcCfg->getAnalysisSave()->storeCtu( pCtu );
+    }
 
     // All CTU decisions have now been made. Restore entropy coder to an initial stage, ready to make a true encode,
     // which will result in the state of the contexts being correct. It will also count up the number of bits coded,
@@ -952,7 +964,7 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
         actualQP = pCtu->getQP( 0 );
       }
       m_pcRdCost->setLambda(oldLambda, pcSlice->getSPS()->getBitDepths());
-      m_pcRateCtrl->getRCPic()->updateAfterCTU( m_pcRateCtrl->getRCPic()->getLCUCoded(), actualBits, actualQP, actualLambda,
+      m_pcRateCtrl->getRCPic()->updateAfterCTU( m_pcRateCtrl->getRCPic()->getCurrLCUIdx(), actualBits, actualQP, actualLambda,
                                                 pCtu->getSlice()->getSliceType() == I_SLICE ? 0 : m_pcCfg->getLCULevelRC() );
     }
 
@@ -197,6 +197,10 @@ Void TEncTop::init(Bool isFieldCoding)
 
   // initialize PPS
   xInitPPS(pps0, sps0);
+  if (m_RCEnableRateControl && m_RCTileLevelRC)
+  {
+    m_cRateCtrl.initTileRC(pps0);
+  }
   xInitRPS(sps0, isFieldCoding);
   xInitScalingLists(sps0, pps0);
 
@@ -311,6 +315,9 @@ Void TEncTop::deletePicBuffer()
     delete pcPic;
     pcPic = NULL;
   }
+#if REDUCED_ENCODER_MEMORY
+  m_cPicBufferPool.destroy();
+#endif
 }
 
 /**
@@ -341,6 +348,10 @@ Void TEncTop::encode( Bool flush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvT
     xGetNewPicBuffer( pcPicCurr, ppsID );
     pcPicYuvOrg->copyToPic( pcPicCurr->getPicYuvOrg() );
     pcPicYuvTrueOrg->copyToPic( pcPicCurr->getPicYuvTrueOrg() );
+    if ( getTileMajorSource() )
+    {
+      pcPicCurr->copyPicYuvOrgToTiles();
+    }
 
     // compute image characteristics
     if ( getUseAdaptiveQP() )
@@ -458,6 +469,10 @@ Void TEncTop::encode(Bool flush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvTr
                        pcPicYuvTrueOrg->getHeight(component),
                        isTopField);
       }
+      if ( getTileMajorSource() )
+      {
+        pcField->copyPicYuvOrgToTiles();
+      }
 
       // compute image characteristics
       if ( getUseAdaptiveQP() )
@@ -547,6 +562,7 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic, Int ppsId )
     {
       TEncPic* pcEPic = new TEncPic;
 #if REDUCED_ENCODER_MEMORY
+      pcEPic->setBufferPool( &m_cPicBufferPool );
       pcEPic->create( sps, pps, pps.getMaxCuDQPDepth()+1);
 #else
       pcEPic->create( sps, pps, pps.getMaxCuDQPDepth()+1, false);
@@ -557,6 +573,7 @@ Void TEncTop::xGetNewPicBuffer ( TComPic*& rpcPic, Int ppsId )
     {
       rpcPic = new TComPic;
 #if REDUCED_ENCODER_MEMORY
+      rpcPic->setBufferPool( &m_cPicBufferPool );
       rpcPic->create( sps, pps, true, false );
 #else
       rpcPic->create( sps, pps, false );
@@ -57,6 +57,7 @@
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
 #include "TEncRateCtrl.h"
+#include "TEncAnalysisData.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -73,6 +74,9 @@ private:
   Int                     m_iNumPicRcvd;                  ///< number of received pictures
   UInt                    m_uiNumAllPicCoded;             ///< number of coded pictures
   TComList<TComPic*>      m_cListPic;                     ///< dynamic list of pictures
+#if REDUCED_ENCODER_MEMORY
+  TComPicBufferPool       m_cPicBufferPool;               ///< buffers released by the pictures, handed out again to the next pictures
+#endif
 
   // encoder search
   TEncSearch              m_cSearch;                      ///< encoder search class
@@ -46,12 +46,169 @@
 #include "TLibCommon/TComRom.h"
 #include "TVideoIOYuv.h"
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TLibCommon/TComCPUFeatures.h"
+#endif
+
 using namespace std;
 
 // ====================================================================================================================
 // Local Functions
 // ====================================================================================================================
 
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+SIMD_TARGET_AVX2 static Void simdScalePlaneUpAVX2(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits)
+{
+  const __m128i mmShift = _mm_cvtsi32_si128(shiftbits);
+  for (UInt y = 0; y < height; y++, img+=stride)
+  {
+    UInt x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m256i mmVal = _mm256_loadu_si256((const __m256i*)(img + x));
+      _mm256_storeu_si256((__m256i*)(img + x), _mm256_sll_epi16(mmVal, mmShift));
+    }
+    for (; x < width; x++)
+    {
+      img[x] <<= shiftbits;
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 static Void simdScalePlaneDownAVX2(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
+{
+  // the rounding is added at 32 bits, as the samples may use all 16 bits
+  const Int     rounding   = 1 << (shiftbits-1);
+  const __m128i mmShift    = _mm_cvtsi32_si128(shiftbits);
+  const __m256i mmRounding = _mm256_set1_epi32(rounding);
+  const __m256i mmMin      = _mm256_set1_epi16(minval);
+  const __m256i mmMax      = _mm256_set1_epi16(maxval);
+  for (UInt y = 0; y < height; y++, img+=stride)
+  {
+    UInt x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m128i mmLo  = _mm_loadu_si128((const __m128i*)(img + x));
+      const __m128i mmHi  = _mm_loadu_si128((const __m128i*)(img + x + 8));
+      const __m256i mmLo32 = _mm256_sra_epi32(_mm256_add_epi32(_mm256_cvtepi16_epi32(mmLo), mmRounding), mmShift);
+      const __m256i mmHi32 = _mm256_sra_epi32(_mm256_add_epi32(_mm256_cvtepi16_epi32(mmHi), mmRounding), mmShift);
+      __m256i mmVal = _mm256_permute4x64_epi64(_mm256_packs_epi32(mmLo32, mmHi32), 0xd8);
+      mmVal = _mm256_min_epi16(_mm256_max_epi16(mmVal, mmMin), mmMax);
+      _mm256_storeu_si256((__m256i*)(img + x), mmVal);
+    }
+    for (; x < width; x++)
+    {
+      img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbits));
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 static Void simdReadLine8AVX2(Pel* dst, const UChar* src, const UInt width)
+{
+  UInt x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    _mm256_storeu_si256((__m256i*)(dst + x), _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + x))));
+  }
+  for (; x < width; x++)
+  {
+    dst[x] = src[x];
+  }
+}
+
+SIMD_TARGET_AVX2 static Void simdWriteLine8AVX2(UChar* dst, const Pel* src, const UInt width)
+{
+  // only the low byte of each sample is written, as in the C version
+  const __m256i mmLowByte = _mm256_set1_epi16(0xff);
+  UInt x = 0;
+  for (; x + 32 <= width; x += 32)
+  {
+    const __m256i mmA = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(src + x)),      mmLowByte);
+    const __m256i mmB = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(src + x + 16)), mmLowByte);
+    _mm256_storeu_si256((__m256i*)(dst + x), _mm256_permute4x64_epi64(_mm256_packus_epi16(mmA, mmB), 0xd8));
+  }
+  for (; x < width; x++)
+  {
+    dst[x] = (UChar)(src[x]);
+  }
+}
+#endif
+
+/**
+ * Convert a line of width samples read from a file, stored as 8 bit values
+ * or as 16 bit little-endian values, to dst.
+ */
+static Void readLine(Pel* dst, const UChar* src, const UInt width, const Bool is16bit)
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (getSIMDLevel() >= SIMD_AVX2)
+  {
+    if (is16bit)
+    {
+      // x86 is little-endian, so 16 bit file samples are already in the layout of Pel
+      memcpy(dst, src, width*sizeof(Pel));
+    }
+    else
+    {
+      simdReadLine8AVX2(dst, src, width);
+    }
+    return;
+  }
+#endif
+  if (!is16bit)
+  {
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[x] = src[x];
+    }
+  }
+  else
+  {
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[x] = Pel(src[x*2+0]) | (Pel(src[x*2+1])<<8);
+    }
+  }
+}
+
+/**
+ * Convert a line of width samples from src to the file format, 8 bit values
+ * or 16 bit little-endian values.
+ */
+static Void writeLine(UChar* dst, const Pel* src, const UInt width, const Bool is16bit)
+{
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (getSIMDLevel() >= SIMD_AVX2)
+  {
+    if (is16bit)
+    {
+      memcpy(dst, src, width*sizeof(Pel));
+    }
+    else
+    {
+      simdWriteLine8AVX2(dst, src, width);
+    }
+    return;
+  }
+#endif
+  if (!is16bit)
+  {
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[x] = (UChar)(src[x]);
+    }
+  }
+  else
+  {
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[2*x  ] = (src[x]>>0) & 0xff;
+      dst[2*x+1] = (src[x]>>8) & 0xff;
+    }
+  }
+}
+
 /**
  * Scale all pixels in img depending upon sign of shiftbits by a factor of
  * 2<sup>shiftbits</sup>.
@@ -69,6 +226,20 @@ using namespace std;
  */
 static Void scalePlane(Pel* img, const UInt stride, const UInt width, const UInt height, Int shiftbits, Pel minval, Pel maxval)
 {
+#if VECTOR_CODING__AVX2_DISPATCH && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (shiftbits != 0 && getSIMDLevel() >= SIMD_AVX2)
+  {
+    if (shiftbits > 0)
+    {
+      simdScalePlaneUpAVX2(img, stride, width, height, shiftbits);
+    }
+    else
+    {
+      simdScalePlaneDownAVX2(img, stride, width, height, -shiftbits, minval, maxval);
+    }
+    return;
+  }
+#endif
   if (shiftbits > 0)
   {
     for (UInt y = 0; y < height; y++, img+=stride)
@@ -244,6 +415,10 @@ Void TVideoIOYuv::skipFrames(Int numFrames, UInt width, UInt height, ChromaForma
  * @param destFormat   chroma format of image
  * @param fileFormat   chroma format of file
  * @param fileBitDepth component bit depth in file
+ * @param fileWidth444  width of the picture stored in the file.
+ * @param fileHeight444 height of the picture stored in the file.
+ * @param offsetX444    horizontal position of the active area in the file picture.
+ * @param offsetY444    vertical position of the active area in the file picture.
  * @return true for success, false in case of error
  */
 static Bool readPlane(Pel* dst,
@@ -257,7 +432,11 @@ static Bool readPlane(Pel* dst,
                       const ComponentID compID,
                       const ChromaFormat destFormat,
                       const ChromaFormat fileFormat,
-                      const UInt fileBitDepth)
+                      const UInt fileBitDepth,
+                      UInt fileWidth444,
+                      UInt fileHeight444,
+                      UInt offsetX444,
+                      UInt offsetY444)
 {
   const UInt csx_file =getComponentScaleX(compID, fileFormat);
   const UInt csy_file =getComponentScaleY(compID, fileFormat);
@@ -273,9 +452,12 @@ static Bool readPlane(Pel* dst,
   const UInt full_width_dest  = width_dest+pad_x_dest;
   const UInt full_height_dest = height_dest+pad_y_dest;
 
-  const UInt stride_file      = (width444 * (is16bit ? 2 : 1)) >> csx_file;
+  const UInt stride_file      = (fileWidth444 * (is16bit ? 2 : 1)) >> csx_file;
   std::vector<UChar> bufVec(stride_file);
   UChar *buf=&(bufVec[0]);
+  const UChar *src=buf + ((offsetX444 * (is16bit ? 2 : 1)) >> csx_file);
+  const streamoff skipAbove   = streamoff(offsetY444>>csy_file) * stride_file;
+  const streamoff skipBelow   = streamoff((fileHeight444 - offsetY444 - height444)>>csy_file) * stride_file;
 
   if (compID!=COMPONENT_Y && (fileFormat==CHROMA_400 || destFormat==CHROMA_400))
   {
@@ -294,8 +476,8 @@ static Bool readPlane(Pel* dst,
 
     if (fileFormat!=CHROMA_400)
     {
-      const UInt height_file      = height444>>csy_file;
-      fd.seekg(height_file*stride_file, ios::cur);
+      const UInt height_file      = fileHeight444>>csy_file;
+      fd.seekg(streamoff(height_file)*stride_file, ios::cur);
       if (fd.eof() || fd.fail() )
       {
         return false;
@@ -306,6 +488,10 @@ static Bool readPlane(Pel* dst,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_dest=(1<<csy_dest)-1;
+    if (skipAbove > 0)
+    {
+      fd.seekg(skipAbove, ios::cur);
+    }
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
@@ -329,17 +515,21 @@ static Bool readPlane(Pel* dst,
           {
             for (UInt x = 0; x < width_dest; x++)
             {
-              dst[x] = buf[x<<sx];
+              dst[x] = src[x<<sx];
             }
           }
           else
           {
             for (UInt x = 0; x < width_dest; x++)
             {
-              dst[x] = Pel(buf[(x<<sx)*2+0]) | (Pel(buf[(x<<sx)*2+1])<<8);
+              dst[x] = Pel(src[(x<<sx)*2+0]) | (Pel(src[(x<<sx)*2+1])<<8);
             }
           }
         }
+        else if (csx_file == csx_dest)
+        {
+          readLine(dst, src, width_dest, is16bit);
+        }
         else
         {
           // eg file is 422, dest is 444.
@@ -348,14 +538,14 @@ static Bool readPlane(Pel* dst,
           {
             for (UInt x = 0; x < width_dest; x++)
             {
-              dst[x] = buf[x>>sx];
+              dst[x] = src[x>>sx];
             }
           }
           else
           {
             for (UInt x = 0; x < width_dest; x++)
             {
-              dst[x] = Pel(buf[(x>>sx)*2+0]) | (Pel(buf[(x>>sx)*2+1])<<8);
+              dst[x] = Pel(src[(x>>sx)*2+0]) | (Pel(src[(x>>sx)*2+1])<<8);
             }
           }
         }
@@ -371,14 +561,20 @@ static Bool readPlane(Pel* dst,
       }
     }
 
-    // process lower padding
-    for (UInt y = height_dest; y < full_height_dest; y++, dst+=stride_dest)
+    if (skipBelow > 0)
     {
-      for (UInt x = 0; x < full_width_dest; x++)
+      fd.seekg(skipBelow, ios::cur);
+      if (fd.fail())
       {
-        dst[x] = (dst - stride_dest)[x];
+        return false;
       }
     }
+
+    // process lower padding
+    for (UInt y = height_dest; y < full_height_dest; y++, dst+=stride_dest)
+    {
+      memcpy(dst, dst - stride_dest, full_width_dest*sizeof(Pel));
+    }
   }
   return true;
 }
@@ -483,6 +679,10 @@ static Bool writePlane(ostream& fd, Pel* src, Bool is16bit,
             }
           }
         }
+        else if (csx_file == csx_src)
+        {
+          writeLine(buf, src, width_file, is16bit);
+        }
         else
         {
           // eg file is 422, src is 444.
@@ -616,6 +816,10 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
               }
             }
           }
+          else if (csx_file == csx_src)
+          {
+            writeLine(fieldBuffer, src, width_file, is16bit);
+          }
           else
           {
             // eg file is 422, src is 444.
@@ -707,6 +911,10 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
   const UInt width444       = width_full444 - pad_h444;
   const UInt height444      = height_full444 - pad_v444;
 
+  // the active area is either the whole file picture or a window of it
+  const UInt fileWidth444   = m_windowFileWidth  > 0 ? m_windowFileWidth  : width444;
+  const UInt fileHeight444  = m_windowFileHeight > 0 ? m_windowFileHeight : height444;
+
   for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -718,7 +926,7 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     const Pel minval = b709Compliance? ((   1 << (desired_bitdepth - 8))   ) : 0;
     const Pel maxval = b709Compliance? ((0xff << (desired_bitdepth - 8)) -1) : (1 << desired_bitdepth) - 1;
 
-    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
+    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType], fileWidth444, fileHeight444, m_windowOffsetX, m_windowOffsetY))
     {
       return false;
     }
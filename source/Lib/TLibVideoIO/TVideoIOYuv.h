@@ -58,9 +58,13 @@ private:
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
+  UInt      m_windowFileWidth;                      ///< width of the pictures in the file when reading a window of them (0: no window)
+  UInt      m_windowFileHeight;                     ///< height of the pictures in the file when reading a window of them (0: no window)
+  UInt      m_windowOffsetX;                        ///< horizontal position of the window read from the file
+  UInt      m_windowOffsetY;                        ///< vertical position of the window read from the file
 
 public:
-  TVideoIOYuv()           {}
+  TVideoIOYuv() : m_windowFileWidth(0), m_windowFileHeight(0), m_windowOffsetX(0), m_windowOffsetY(0) {}
   virtual ~TVideoIOYuv()  {}
 
   Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
@@ -68,6 +72,9 @@ public:
 
   Void skipFrames(Int numFrames, UInt width, UInt height, ChromaFormat format);
 
+  // read() only reads the window of size pPicYuvTrueOrg at (offsetX, offsetY) out of fileWidth x fileHeight pictures
+  Void  setReadWindow(UInt fileWidth, UInt fileHeight, UInt offsetX, UInt offsetY) { m_windowFileWidth = fileWidth; m_windowFileHeight = fileHeight; m_windowOffsetX = offsetX; m_windowOffsetY = offsetY; }
+
   // if fileFormat<NUM_CHROMA_FORMAT, the format of the file is that format specified, else it is the format of the TComPicYuv.
 
 